@@ -0,0 +1,403 @@
+/**
+ * @file kiz_bench.cpp
+ * @brief 基准测试驱动：把 benchmarks/ 下的 kiz 程序各运行 N 次，统计墙钟时间、指令数与峰值内存
+ *
+ * 每次运行都是独立的子进程（kiz <file>），退出码非 0 视为失败；程序旁有同名 .expected 文件时，
+ * 标准输出必须与之逐字节相同，否则记为输出错误并打印第一处不同的行。
+ * 指令数来自 Linux perf_event（只计用户态，子进程 exec 时开始计数），
+ * 权限不足（perf_event_paranoid）或非 Linux 时记为 null；峰值内存来自 wait4 的 ru_maxrss。
+ * 结果写成 JSON，用 --label 标注提交，便于跨提交对比
+ * @author azhz1107cat
+ * @date 2025-12-27
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+namespace fs = std::filesystem;
+
+#ifndef KIZ_BENCH_DIR
+#define KIZ_BENCH_DIR "benchmarks"
+#endif
+
+namespace {
+
+struct Options {
+    std::string kiz;
+    std::vector<std::string> inputs;
+    size_t runs = 5;
+    size_t warmup = 1;
+    std::string out = "bench.json";
+    std::string label;
+};
+
+struct Sample {
+    double wall_ms;
+    std::optional<uint64_t> instructions;
+    long peak_rss_kb;
+};
+
+struct Result {
+    std::string name;
+    std::string file;
+    bool ok = true;
+    std::string error;  // 失败原因：FAILED（退出码 / 信号）或 WRONG OUTPUT
+    std::vector<Sample> samples;
+};
+
+void show_help(const char* prog) {
+    std::cout
+        << "用法: " << prog << " <kiz可执行文件> [选项] [基准文件或目录...]\n"
+        << "  未给出基准时运行 " << KIZ_BENCH_DIR << " 下全部 .kiz\n"
+        << "  -n N         每个程序计入统计的运行次数（默认 5）\n"
+        << "  -w N         不计入统计的预热次数（默认 1）\n"
+        << "  -o FILE      JSON 结果文件（默认 bench.json）\n"
+        << "  --label S    写入 JSON 的标签，如提交哈希\n";
+}
+
+size_t parse_count(const char* text, const char* flag) {
+    char* end = nullptr;
+    const unsigned long long v = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0') {
+        std::cerr << "kiz_bench: " << flag << " 需要非负整数，得到 '" << text << "'\n";
+        std::exit(2);
+    }
+    return static_cast<size_t>(v);
+}
+
+Options parse_args(const int argc, char* argv[]) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-h" || arg == "--help") {
+            show_help(argv[0]);
+            std::exit(0);
+        } else if (arg == "-n" && has_value) {
+            opts.runs = parse_count(argv[++i], "-n");
+        } else if (arg == "-w" && has_value) {
+            opts.warmup = parse_count(argv[++i], "-w");
+        } else if (arg == "-o" && has_value) {
+            opts.out = argv[++i];
+        } else if (arg == "--label" && has_value) {
+            opts.label = argv[++i];
+        } else if (opts.kiz.empty()) {
+            opts.kiz = arg;
+        } else {
+            opts.inputs.push_back(arg);
+        }
+    }
+    if (opts.kiz.empty() || opts.runs == 0) {
+        show_help(argv[0]);
+        std::exit(2);
+    }
+    if (opts.inputs.empty()) opts.inputs.emplace_back(KIZ_BENCH_DIR);
+    return opts;
+}
+
+// 展开目录为其中的 .kiz 文件（按文件名排序，保证每次顺序一致）
+std::vector<fs::path> collect_programs(const std::vector<std::string>& inputs) {
+    std::vector<fs::path> programs;
+    for (const auto& input : inputs) {
+        if (!fs::is_directory(input)) {
+            programs.emplace_back(input);
+            continue;
+        }
+        std::vector<fs::path> found;
+        for (const auto& entry : fs::directory_iterator(input)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".kiz") found.push_back(entry.path());
+        }
+        std::sort(found.begin(), found.end());
+        programs.insert(programs.end(), found.begin(), found.end());
+    }
+    return programs;
+}
+
+#if defined(__linux__)
+// 为 pid 打开用户态指令计数器：创建时关闭，子进程 exec 时自动开启
+int open_instruction_counter(const pid_t pid) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.enable_on_exec = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, pid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+// 读出整个文件，不存在时返回空
+std::optional<std::string> read_file(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return std::nullopt;
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// 第一处不同的行（行号从 1 开始），用于报告输出错误
+std::string first_difference(const std::string& expected, const std::string& actual) {
+    size_t line = 1, begin = 0;
+    while (true) {
+        const size_t e_end = std::min(expected.find('\n', begin), expected.size());
+        const size_t a_end = std::min(actual.find('\n', begin), actual.size());
+        const std::string e = begin < expected.size() ? expected.substr(begin, e_end - begin) : "<EOF>";
+        const std::string a = begin < actual.size() ? actual.substr(begin, a_end - begin) : "<EOF>";
+        if (e != a || e_end != a_end) {
+            return "第 " + std::to_string(line) + " 行\n    期望: " + e + "\n    实际: " + a;
+        }
+        if (e_end >= expected.size()) return "末尾换行不同";
+        begin = e_end + 1;
+        ++line;
+    }
+}
+
+// 运行一次；子进程先阻塞在管道上，等父进程挂好计数器再 exec。标准输出写入临时文件，由 output 带回
+std::optional<Sample> run_once(const std::string& kiz, const fs::path& program, std::string& output) {
+    char out_path[] = "/tmp/kiz_bench_XXXXXX";
+    const int out_fd = mkstemp(out_path);
+    if (out_fd < 0) return std::nullopt;
+    unlink(out_path);
+
+    int gate[2];
+    if (pipe(gate) != 0) {
+        close(out_fd);
+        return std::nullopt;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(gate[0]);
+        close(gate[1]);
+        close(out_fd);
+        return std::nullopt;
+    }
+    if (pid == 0) {
+        close(gate[1]);
+        char go;
+        if (read(gate[0], &go, 1) != 1) _exit(127);
+        close(gate[0]);
+        dup2(out_fd, STDOUT_FILENO);
+        close(out_fd);
+        const std::string path = program.string();
+        execl(kiz.c_str(), kiz.c_str(), path.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    close(gate[0]);
+    int counter = -1;
+#if defined(__linux__)
+    counter = open_instruction_counter(pid);
+#endif
+    const char go = 1;
+    const bool released = write(gate[1], &go, 1) == 1;
+    close(gate[1]);
+
+    int status = 0;
+    rusage usage{};
+    const pid_t waited = wait4(pid, &status, 0, &usage);
+    const auto stop = std::chrono::steady_clock::now();
+
+    std::optional<uint64_t> instructions;
+    if (counter >= 0) {
+        uint64_t count = 0;
+        if (read(counter, &count, sizeof(count)) == sizeof(count)) instructions = count;
+        close(counter);
+    }
+
+    output.clear();
+    char buf[4096];
+    lseek(out_fd, 0, SEEK_SET);
+    for (ssize_t n; (n = read(out_fd, buf, sizeof(buf))) > 0;) output.append(buf, static_cast<size_t>(n));
+    close(out_fd);
+    if (!released || waited != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) return std::nullopt;
+
+    Sample sample{};
+    sample.wall_ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    sample.instructions = instructions;
+#if defined(__APPLE__)
+    sample.peak_rss_kb = usage.ru_maxrss / 1024;  // macOS 以字节为单位
+#else
+    sample.peak_rss_kb = usage.ru_maxrss;
+#endif
+    return sample;
+}
+
+// 最近秩百分位：p95 在样本少时即为最大值
+template <typename T>
+T percentile(std::vector<T> values, const double p) {
+    std::sort(values.begin(), values.end());
+    const auto rank = std::clamp<size_t>(
+        static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(values.size()))), 1, values.size());
+    return values[rank - 1];
+}
+
+template <typename T>
+T median(std::vector<T> values) {
+    std::sort(values.begin(), values.end());
+    const size_t mid = values.size() / 2;
+    if (values.size() % 2 == 1) return values[mid];
+    return static_cast<T>((values[mid - 1] + values[mid]) / 2);
+}
+
+std::string json_escape(const std::string& s) {
+    std::string out;
+    for (const char c : s) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+std::string fmt_ms(const double ms) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.3f", ms);
+    return buf;
+}
+
+// 所有样本都有指令数时才汇总，否则为空
+std::optional<std::vector<uint64_t>> instruction_counts(const Result& r) {
+    std::vector<uint64_t> counts;
+    for (const auto& s : r.samples) {
+        if (!s.instructions) return std::nullopt;
+        counts.push_back(*s.instructions);
+    }
+    return counts;
+}
+
+void write_json(const Options& opts, const std::vector<Result>& results) {
+    std::ofstream out(opts.out);
+    if (!out) {
+        std::cerr << "kiz_bench: 无法写入 " << opts.out << "\n";
+        std::exit(1);
+    }
+    out << "{\n"
+        << "  \"label\": \"" << json_escape(opts.label) << "\",\n"
+        << "  \"kiz\": \"" << json_escape(opts.kiz) << "\",\n"
+        << "  \"runs\": " << opts.runs << ",\n"
+        << "  \"warmup\": " << opts.warmup << ",\n"
+        << "  \"timestamp\": " << std::time(nullptr) << ",\n"
+        << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\"name\": \"" << json_escape(r.name) << "\", \"file\": \"" << json_escape(r.file) << "\", "
+            << "\"ok\": " << (r.ok ? "true" : "false");
+        if (!r.ok) out << ", \"error\": \"" << json_escape(r.error) << "\"";
+        if (r.ok) {
+            std::vector<double> walls;
+            long peak = 0;
+            for (const auto& s : r.samples) {
+                walls.push_back(s.wall_ms);
+                peak = std::max(peak, s.peak_rss_kb);
+            }
+            out << ", \"wall_ms\": {\"median\": " << fmt_ms(median(walls))
+                << ", \"p95\": " << fmt_ms(percentile(walls, 95))
+                << ", \"min\": " << fmt_ms(*std::min_element(walls.begin(), walls.end()))
+                << ", \"samples\": [";
+            for (size_t j = 0; j < walls.size(); ++j) out << (j ? ", " : "") << fmt_ms(walls[j]);
+            out << "]}, \"instructions\": ";
+            if (const auto counts = instruction_counts(r)) {
+                out << "{\"median\": " << median(*counts) << ", \"p95\": " << percentile(*counts, 95) << "}";
+            } else {
+                out << "null";
+            }
+            out << ", \"peak_rss_kb\": " << peak;
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(const int argc, char* argv[]) {
+    const Options opts = parse_args(argc, argv);
+    const auto programs = collect_programs(opts.inputs);
+    if (programs.empty()) {
+        std::cerr << "kiz_bench: 没有找到基准程序\n";
+        return 2;
+    }
+
+    std::printf("%-20s %12s %12s %16s %12s\n", "benchmark", "median ms", "p95 ms", "instructions", "peak RSS KB");
+    std::vector<Result> results;
+    bool all_ok = true;
+    for (const auto& program : programs) {
+        Result r;
+        r.name = program.stem().string();
+        r.file = program.string();
+        const auto expected = read_file(fs::path(program).replace_extension(".expected"));
+        std::string output, diff;
+        for (size_t i = 0; i < opts.warmup + opts.runs && r.ok; ++i) {
+            const auto sample = run_once(opts.kiz, program, output);
+            if (!sample) {
+                r.ok = false;
+                r.error = "FAILED";
+            } else if (expected && output != *expected) {
+                r.ok = false;
+                r.error = "WRONG OUTPUT";
+                diff = first_difference(*expected, output);
+            } else if (i >= opts.warmup) {
+                r.samples.push_back(*sample);
+            }
+        }
+        all_ok = all_ok && r.ok;
+
+        if (!r.ok) {
+            std::printf("%-20s %12s\n", r.name.c_str(), r.error.c_str());
+            if (!diff.empty()) std::printf("    %s\n", diff.c_str());
+        } else {
+            std::vector<double> walls;
+            long peak = 0;
+            for (const auto& s : r.samples) {
+                walls.push_back(s.wall_ms);
+                peak = std::max(peak, s.peak_rss_kb);
+            }
+            const auto counts = instruction_counts(r);
+            const std::string inst = counts ? std::to_string(median(*counts)) : "-";
+            std::printf("%-20s %12.3f %12.3f %16s %12ld\n", r.name.c_str(), median(walls), percentile(walls, 95),
+                        inst.c_str(), peak);
+        }
+        std::fflush(stdout);
+        results.push_back(std::move(r));
+    }
+
+    write_json(opts, results);
+    std::printf("结果已写入 %s\n", opts.out.c_str());
+    return all_ok ? 0 : 1;
+}
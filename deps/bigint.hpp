@@ -50,6 +50,27 @@ class BigInt {
         return false; // 绝对值相等
     }
 
+    /**
+     * @brief 绝对值相减 |big| - |small|（调用方保证 |big| >= |small|），结果非负
+     */
+    static BigInt sub_abs(const BigInt& big, const BigInt& small) {
+        BigInt res;
+        res.digits_.clear();
+        int32_t borrow = 0; // 借位；用有符号数，避免当前位为0时减借位回绕
+        for (size_t i = 0; i < big.digits_.size(); ++i) {
+            int32_t a = big.digits_[i] - borrow;
+            const int32_t b = (i < small.digits_.size()) ? small.digits_[i] : 0;
+            borrow = 0;
+            if (a < b) {
+                a += 10;
+                borrow = 1;
+            }
+            res.digits_.push_back(static_cast<uint8_t>(a - b));
+        }
+        res.trim_leading_zeros();
+        return res;
+    }
+
     /**
      * @brief 核心辅助：计算 (dividend / divisor) 的商和余数（无符号，仅处理正整数）
      * @param dividend 被除数（非负）
@@ -266,9 +287,10 @@ public:
         // 情况2：异号（一正一负）→ 绝对值相减，符号取绝对值大的
         else {
             if (abs_less(other)) { // this绝对值 < other绝对值 → 结果符号=other符号
-                res = other - *this;
+                res = sub_abs(other, *this);
+                res.is_negative_ = other.is_negative_;
             } else { // this绝对值 >= other绝对值 → 结果符号=this符号
-                res = *this - other;
+                res = sub_abs(*this, other);
                 res.is_negative_ = is_negative_;
             }
         }
@@ -288,7 +310,7 @@ public:
 
     // ========================= 核心运算：减法 =========================
     /**
-     * @brief 减法运算符：确保大减小，避免负数中间结果
+     * @brief 减法运算符：异号时转为加法，同号时绝对值大减小并确定符号
      */
     BigInt operator-(const BigInt& other) const {
         // 特殊情况：减自己 → 0
@@ -296,36 +318,23 @@ public:
             return BigInt(0);
         }
 
-        BigInt res;
-        res.digits_.clear();
-        res.is_negative_ = false;
-
-        // 确定被减数和减数（确保被减数绝对值 >= 减数绝对值）
-        const BigInt* minuend = this;  // 被减数
-        const BigInt* subtrahend = &other; // 减数
-        if (abs_less(other)) {
-            minuend = &other;
-            subtrahend = this;
-            res.is_negative_ = true; // 结果为负
+        // 异号：a - b = a + (-b)
+        if (is_negative_ != other.is_negative_) {
+            BigInt negated = other;
+            negated.is_negative_ = !other.is_negative_;
+            negated.trim_leading_zeros();
+            return *this + negated;
         }
 
-        // 绝对值相减（大减小）
-        uint32_t borrow = 0; // 借位
-        for (size_t i = 0; i < minuend->digits_.size(); ++i) {
-            // 取当前位（减数不足补0）
-            uint32_t a = minuend->digits_[i];
-            uint32_t b = (i < subtrahend->digits_.size()) ? subtrahend->digits_[i] : 0;
-            // 处理借位：当前位不够减，向前借1（变成10+当前位）
-            a -= borrow;
-            borrow = 0;
-            if (a < b) {
-                a += 10;
-                borrow = 1;
-            }
-            uint32_t diff = a - b;
-            res.digits_.push_back(static_cast<uint8_t>(diff));
+        // 同号：|a| >= |b| 时结果符号同 a，否则相反
+        BigInt res;
+        if (abs_less(other)) {
+            res = sub_abs(other, *this);
+            res.is_negative_ = !is_negative_;
+        } else {
+            res = sub_abs(*this, other);
+            res.is_negative_ = is_negative_;
         }
-
         res.trim_leading_zeros();
         return res;
     }
@@ -349,11 +358,10 @@ public:
             return BigInt(0);
         }
 
-        BigInt res;
+        // 绝对值相乘（调用Karatsuba核心）
+        BigInt res = karatsuba_mul(*this, other);
         // 符号：同号为正，异号为负（异或运算）
         res.is_negative_ = is_negative_ ^ other.is_negative_;
-        // 绝对值相乘（调用Karatsuba核心）
-        res = karatsuba_mul(*this, other);
         res.trim_leading_zeros();
         return res;
     }
@@ -496,6 +504,67 @@ public:
 
         return result;
     }
+
+    // ========================= 机器整数转换 =========================
+    /**
+     * @brief 判断能否无损转换为 long long（下标、重复次数等机器整数场景）
+     */
+    [[nodiscard]] bool fits_long_long() const {
+        if (digits_.size() < 19) return true;
+        if (digits_.size() > 19) return false;
+        // 19位：与 LLONG_MAX(9223372036854775807) / LLONG_MIN 的绝对值逐位比较
+        const std::string limit = is_negative_ ? "9223372036854775808" : "9223372036854775807";
+        auto it = digits_.rbegin();
+        for (const char c : limit) {
+            const auto d = static_cast<uint8_t>(c - '0');
+            if (*it != d) return *it < d;
+            ++it;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 转换为 long long（超出范围时断言报错）
+     */
+    [[nodiscard]] long long to_long_long() const {
+        assert(fits_long_long() && "BigInt to_long_long: 超出 long long 范围");
+        unsigned long long abs_val = 0;
+        for (auto it = digits_.rbegin(); it != digits_.rend(); ++it) {
+            abs_val = abs_val * 10 + *it;
+        }
+        return is_negative_ ? static_cast<long long>(0ULL - abs_val) : static_cast<long long>(abs_val);
+    }
+
+    /**
+     * @brief 哈希值：能放进 long long 的按机器整数混合，否则对十进制位做 FNV-1a
+     */
+    [[nodiscard]] size_t hash() const {
+        if (fits_long_long()) {
+            auto x = static_cast<unsigned long long>(to_long_long());
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdULL;
+            x ^= x >> 33;
+            return static_cast<size_t>(x);
+        }
+        size_t h = is_negative_ ? 0x9e3779b97f4a7c15ULL : 14695981039346656037ULL;
+        for (const uint8_t d : digits_) {
+            h ^= d;
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    /**
+     * @brief 由 long long 构造（含负数，LLONG_MIN 也可无损表示）
+     */
+    static BigInt from_long_long(const long long val) {
+        const unsigned long long abs_val = val < 0
+            ? 0ULL - static_cast<unsigned long long>(val)
+            : static_cast<unsigned long long>(val);
+        BigInt result(static_cast<size_t>(abs_val));
+        result.is_negative_ = val < 0;
+        return result;
+    }
 };
 
 } // namespace deps
\ No newline at end of file
@@ -0,0 +1,44 @@
+/**
+ * @file bit_ops.hpp
+ * @brief 可移植的位运算与溢出检查：GCC / Clang 用内建函数，MSVC 等退回标准写法
+ * @author azhz1107cat
+ * @date 2025-12-17
+ */
+
+#pragma once
+
+#include <bit>
+#include <limits>
+#include <type_traits>
+
+namespace deps::bits {
+
+// 最低位 1 之前的 0 的个数（x 不为 0）
+template <typename T>
+int ctz(const T x) {
+    static_assert(std::is_unsigned_v<T>);
+    return std::countr_zero(x);
+}
+
+// *out = a + b，溢出时返回 true（无符号为回绕后的值）
+template <typename T>
+bool add_overflow(const T a, const T b, T* out) {
+    static_assert(std::is_integral_v<T>);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_add_overflow(a, b, out);
+#else
+    if constexpr (std::is_unsigned_v<T>) {
+        *out = static_cast<T>(a + b);
+        return *out < a;
+    } else {
+        if ((b > 0 && a > std::numeric_limits<T>::max() - b)
+            || (b < 0 && a < std::numeric_limits<T>::min() - b)) {
+            return true;
+        }
+        *out = a + b;
+        return false;
+    }
+#endif
+}
+
+} // namespace deps::bits
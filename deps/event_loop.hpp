@@ -0,0 +1,227 @@
+/**
+ * @file event_loop.hpp
+ * @brief 单线程事件循环：定时器与文件描述符就绪通知
+ * 定时器放在按到期时间排序的最小堆里，取消只删回调，堆中的旧项到期时跳过；
+ * fd 就绪通知在 Linux 上用 epoll，其他 POSIX 系统退回 poll。每次 watch 只通知一次，
+ * 需要继续等待时由回调重新 watch。普通文件不支持就绪通知，watch 返回 false，由调用方直接读写
+ * @author azhz1107cat
+ * @date 2025-12-27
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <poll.h>
+#endif
+
+namespace deps {
+
+class EventLoop {
+public:
+    using Callback = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t id;
+        // 堆顶为最早到期者；同时到期按创建顺序
+        bool operator>(const Timer& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : id > other.id;
+        }
+    };
+
+    struct Watch {
+        Callback on_read, on_write;
+        bool registered = false;  // 已加入 epoll
+    };
+
+    std::vector<Timer> timers_;
+    std::unordered_map<uint64_t, Callback> timer_callbacks_;
+    uint64_t next_timer_id_ = 1;
+    std::unordered_map<int, Watch> watches_;
+#if defined(__linux__)
+    int epfd_ = -1;
+#endif
+
+    // 按当前回调同步关注的事件；两个方向都没有回调时移除该 fd
+    bool update_interest(const int fd) {
+        auto it = watches_.find(fd);
+        if (it == watches_.end()) return true;
+        Watch& w = it->second;
+        if (!w.on_read && !w.on_write) {
+#if defined(__linux__)
+            if (w.registered) epoll_ctl(epfd_, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+            watches_.erase(it);
+            return true;
+        }
+#if defined(__linux__)
+        epoll_event ev{};
+        ev.events = (w.on_read ? EPOLLIN : 0u) | (w.on_write ? EPOLLOUT : 0u);
+        ev.data.fd = fd;
+        if (epoll_ctl(epfd_, w.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev) != 0) {
+            // EPERM：普通文件等不支持 epoll 的 fd
+            assert((errno == EPERM || w.registered) && "event_loop: epoll_ctl 失败");
+            watches_.erase(it);
+            return false;
+        }
+        w.registered = true;
+#endif
+        return true;
+    }
+
+    // 取出并调用 fd 某个方向上的回调
+    void fire(const int fd, const bool readable, const bool writable) {
+        auto it = watches_.find(fd);
+        if (it == watches_.end()) return;  // 同一批事件中已被前面的回调 unwatch
+        Callback on_read = readable ? std::move(it->second.on_read) : Callback{};
+        Callback on_write = writable ? std::move(it->second.on_write) : Callback{};
+        if (readable) it->second.on_read = nullptr;
+        if (writable) it->second.on_write = nullptr;
+        update_interest(fd);
+        if (on_read) on_read();
+        if (on_write) on_write();
+    }
+
+    // 距最近定时器到期的毫秒数（向上取整）；没有定时器时为 -1
+    int next_timeout_ms() {
+        while (!timers_.empty() && !timer_callbacks_.contains(timers_.front().id)) {
+            std::pop_heap(timers_.begin(), timers_.end(), std::greater<>{});
+            timers_.pop_back();
+        }
+        if (timers_.empty()) return -1;
+        const auto wait = timers_.front().deadline - Clock::now();
+        if (wait <= Clock::duration::zero()) return 0;
+        const auto ms = std::chrono::ceil<std::chrono::milliseconds>(wait).count();
+        return static_cast<int>(std::min<long long>(ms, 1 << 30));
+    }
+
+    void wait_fds(const int timeout_ms) {
+#if defined(__linux__)
+        epoll_event events[64];
+        const int n = epoll_wait(epfd_, events, 64, timeout_ms);
+        assert((n >= 0 || errno == EINTR) && "event_loop: epoll_wait 失败");
+        for (int i = 0; i < n; ++i) {
+            // 出错或挂断时两个方向都通知，由读写操作自己得到 EOF / 错误
+            const uint32_t e = events[i].events;
+            const bool broken = (e & (EPOLLERR | EPOLLHUP)) != 0;
+            fire(events[i].data.fd, broken || (e & EPOLLIN), broken || (e & EPOLLOUT));
+        }
+#elif !defined(_WIN32)
+        std::vector<pollfd> fds;
+        fds.reserve(watches_.size());
+        for (const auto& [fd, w] : watches_) {
+            fds.push_back(pollfd{fd, static_cast<short>((w.on_read ? POLLIN : 0) | (w.on_write ? POLLOUT : 0)), 0});
+        }
+        const int n = poll(fds.data(), fds.size(), timeout_ms);
+        assert((n >= 0 || errno == EINTR) && "event_loop: poll 失败");
+        for (const pollfd& p : fds) {
+            if (p.revents == 0) continue;
+            const bool broken = (p.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+            fire(p.fd, broken || (p.revents & POLLIN), broken || (p.revents & POLLOUT));
+        }
+#else
+        if (timeout_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+#endif
+    }
+
+    EventLoop() {
+#if defined(__linux__)
+        epfd_ = epoll_create1(EPOLL_CLOEXEC);
+        assert(epfd_ >= 0 && "event_loop: epoll_create1 失败");
+#endif
+    }
+
+public:
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    ~EventLoop() {
+#if defined(__linux__)
+        close(epfd_);
+#endif
+    }
+
+    // 解释器线程上唯一的事件循环，首次使用时创建
+    static EventLoop& instance() {
+        static EventLoop loop;
+        return loop;
+    }
+
+    // delay 之后调用 cb，返回可用于 cancel 的编号
+    uint64_t call_later(const Clock::duration delay, Callback cb) {
+        const uint64_t id = next_timer_id_++;
+        timers_.push_back(Timer{Clock::now() + delay, id});
+        std::push_heap(timers_.begin(), timers_.end(), std::greater<>{});
+        timer_callbacks_.emplace(id, std::move(cb));
+        return id;
+    }
+
+    // 取消尚未触发的定时器；返回 false 表示已触发或已取消
+    bool cancel(const uint64_t id) {
+        return timer_callbacks_.erase(id) > 0;
+    }
+
+    // fd 可读（writable 为真时可写）时调用一次 cb；同一方向同时只能有一个等待者。
+    // fd 不支持就绪通知（普通文件）时返回 false，此时它总是可以直接读写
+    bool watch(const int fd, const bool writable, Callback cb) {
+#if defined(_WIN32)
+        return false;
+#else
+        Watch& w = watches_[fd];
+        Callback& slot = writable ? w.on_write : w.on_read;
+        assert(!slot && "event_loop: 该 fd 已有等待者");
+        slot = std::move(cb);
+        return update_interest(fd);
+#endif
+    }
+
+    // 关闭 fd 前调用：丢弃两个方向上的等待者
+    void unwatch(const int fd) {
+        auto it = watches_.find(fd);
+        if (it == watches_.end()) return;
+        it->second.on_read = nullptr;
+        it->second.on_write = nullptr;
+        update_interest(fd);
+    }
+
+    // 还有未触发的定时器或 fd 等待者
+    [[nodiscard]] bool pending() const {
+        return !timer_callbacks_.empty() || !watches_.empty();
+    }
+
+    // 等到有 fd 就绪或最近的定时器到期（block 为假时不等待），然后调用就绪的回调
+    void run_once(const bool block) {
+        const int timeout = next_timeout_ms();
+        wait_fds(block ? timeout : 0);
+        // 只处理本轮开始前已到期的定时器，回调中新建的 0 秒定时器留到下一轮
+        const auto now = Clock::now();
+        while (!timers_.empty() && timers_.front().deadline <= now) {
+            const uint64_t id = timers_.front().id;
+            std::pop_heap(timers_.begin(), timers_.end(), std::greater<>{});
+            timers_.pop_back();
+            auto it = timer_callbacks_.find(id);
+            if (it == timer_callbacks_.end()) continue;
+            Callback cb = std::move(it->second);
+            timer_callbacks_.erase(it);
+            cb();
+        }
+    }
+};
+
+} // namespace deps
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -17,7 +18,7 @@
 namespace deps {
 
 // 字符串哈希函数（FNV-1a算法）
-inline size_t hash_string(const std::string& key) {
+inline size_t hash_string(const std::string_view key) {
     constexpr size_t FNV_OFFSET = 14695981039346656037ULL;
     constexpr size_t FNV_PRIME = 1099511628211ULL;
     size_t hash = FNV_OFFSET;
@@ -38,11 +39,11 @@ class HashMap {
         size_t hash;                        // 缓存哈希值，避免重复计算
         std::shared_ptr<StringBucket> next; // 解决哈希冲突的链表指针
 
-        // 构造函数（移动语义优化）
-        StringBucket(std::string k, VT val)
+        // 构造函数（移动语义优化，哈希值由调用方传入）
+        StringBucket(std::string k, VT val, const size_t h)
             : key(std::move(k)),
               value(std::move(val)),
-              hash(hash_string(key)),
+              hash(h),
               next(nullptr) {}
     };
 
@@ -67,7 +68,8 @@ class HashMap {
             std::shared_ptr<Node> current = buckets_[i];
             while (current != nullptr) {
                 const std::shared_ptr<Node> next = current->next;
-                const size_t new_idx = getBucketIndex(current->hash);
+                // 此时 buckets_ 仍是旧数组，不能用 getBucketIndex
+                const size_t new_idx = current->hash & (new_size - 1);
 
                 // 头插法插入新桶
                 current->next = new_buckets[new_idx];
@@ -81,11 +83,9 @@ class HashMap {
     }
 
 public:
-    // 默认构造函数（初始桶大小为16，2的幂）
-    explicit HashMap() {
-        constexpr size_t init_size = 16;
-        buckets_.resize(init_size, nullptr);
-    }
+    // 默认构造函数：桶数组推迟到首次 insert 时分配（大小16，2的幂），
+    // 从不写入属性的对象（如结构体实例）因此不为空表付出内存
+    explicit HashMap() = default;
 
     // 用键值对vector初始化
     explicit HashMap(const std::vector<std::pair<std::string, VT>>& vec) {
@@ -107,6 +107,11 @@ public:
 
     // 插入/更新键值对（存在则更新，不存在则插入）
     VT insert(const std::string& key, VT val) {
+        return insert(key, std::move(val), hash_string(key));
+    }
+
+    // 插入/更新键值对，使用调用方已算好的哈希值（如 String 对象缓存的哈希）
+    VT insert(const std::string& key, VT val, const size_t hash) {
         // 若桶为空，初始化桶大小为16
         if (buckets_.empty()) {
             buckets_.resize(16, nullptr);
@@ -117,7 +122,6 @@ public:
             this->resize();
         }
 
-        const size_t hash = hash_string(key);
         const size_t bucket_idx = getBucketIndex(hash);
 
         // 检查键是否已存在，存在则更新值
@@ -131,7 +135,7 @@ public:
         }
 
         // 键不存在，创建新节点（头插法）
-        auto new_node = std::make_shared<Node>(key, std::move(val));
+        auto new_node = std::make_shared<Node>(key, std::move(val), hash);
         new_node->next = buckets_[bucket_idx];
         buckets_[bucket_idx] = new_node;
         elem_count_++;
@@ -144,13 +148,21 @@ public:
         return find_in_current(key);
     }
 
+    [[nodiscard]] std::shared_ptr<Node> find(const std::string& key, const size_t hash) const {
+        return find_in_current(key, hash);
+    }
+
     // 仅在当前HashMap查找键（不递归父结构体）
     [[nodiscard]] std::shared_ptr<Node> find_in_current(const std::string& key) const {
+        return find_in_current(key, hash_string(key));
+    }
+
+    // 仅在当前HashMap查找键，使用调用方已算好的哈希值
+    [[nodiscard]] std::shared_ptr<Node> find_in_current(const std::string& key, const size_t hash) const {
         if (buckets_.empty()) {
             return nullptr;
         }
 
-        const size_t hash = hash_string(key);
         const size_t bucket_idx = getBucketIndex(hash);
         if (bucket_idx >= buckets_.size()) {
             return nullptr;
@@ -168,6 +180,11 @@ public:
         return nullptr;
     }
 
+    // 元素个数
+    [[nodiscard]] size_t size() const {
+        return elem_count_;
+    }
+
     // 转换为字符串（需T支持to_string()成员函数）
     [[nodiscard]] std::string to_string() const {
         std::stringstream ss;
@@ -205,6 +222,16 @@ public:
         return ss.str();
     }
 
+    // 按桶顺序遍历键值对（与 to_vector 顺序一致，但不复制键）
+    template <typename F>
+    void for_each(F&& f) const {
+        for (const auto& bucket_head : buckets_) {
+            for (const Node* current = bucket_head.get(); current != nullptr; current = current->next.get()) {
+                f(current->key, current->value);
+            }
+        }
+    }
+
     // 转换为键值对vector
     [[nodiscard]] std::vector<std::pair<std::string, VT>> to_vector() const {
         std::vector<std::pair<std::string, VT>> vec;
@@ -0,0 +1,84 @@
+/**
+ * @file mapped_file.hpp
+ * @brief 只读内存映射文件：整个文件映射进地址空间，按需由内核分页载入，不复制到用户缓冲
+ * 不支持 mmap 的平台上 open 返回 false，调用方应退回普通的缓冲读取
+ * @author azhz1107cat
+ * @date 2025-12-23
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace deps {
+
+class MappedFile {
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        close();
+    }
+
+    // 映射 path 指向的整个文件；空文件也视为成功（data 为 nullptr，size 为 0）
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        (void)path;
+        return false;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                return false;
+            }
+            // 按顺序访问为主：提示内核加大预读，读过的页可尽早回收
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(addr);
+        }
+        // 映射建立后即可关闭描述符
+        ::close(fd);
+        open_ = true;
+        return true;
+#endif
+    }
+
+    void close() {
+#ifndef _WIN32
+        if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        open_ = false;
+    }
+
+    [[nodiscard]] bool is_open() const { return open_; }
+    [[nodiscard]] const char* data() const { return data_; }
+    [[nodiscard]] size_t size() const { return size_; }
+};
+
+} // namespace deps
@@ -0,0 +1,148 @@
+/**
+ * @file mpmc_queue.hpp
+ * @brief 有界多生产者多消费者队列（无锁环形缓冲）与事件计数器
+ * 每个槽位带序号：生产者 / 消费者各自 CAS 推进位置，再用序号确认槽位已写入或已取走，
+ * 快路径不加锁。队列满 / 空时由调用方借助 EventCount 挂起，只有慢路径才使用互斥量
+ * @author azhz1107cat
+ * @date 2025-12-27
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace deps {
+
+// 缓存行大小：生产者与消费者的位置分开存放，避免伪共享
+constexpr size_t cache_line = 64;
+
+// 容量向上取整为 2 的幂，下标用掩码计算；至少 2 个槽位，只有 1 个时序号无法区分满与空
+template <typename T>
+class MpmcQueue {
+    struct Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(cache_line) std::atomic<size_t> enqueue_pos_{0};
+    alignas(cache_line) std::atomic<size_t> dequeue_pos_{0};
+
+public:
+    explicit MpmcQueue(const size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        cells_ = std::make_unique<Cell[]>(cap);
+        mask_ = cap - 1;
+        for (size_t i = 0; i < cap; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    [[nodiscard]] size_t capacity() const { return mask_ + 1; }
+
+    // 队列满时返回 false
+    bool try_push(const T& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t seq = cell.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // 该槽位上一轮的元素还未被取走
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 队列空时返回 false
+    bool try_pop(T& out) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t seq = cell.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = cell.value;
+                    cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 近似元素个数（并发修改时只作参考）
+    [[nodiscard]] size_t size_approx() const {
+        const size_t in = enqueue_pos_.load(std::memory_order_relaxed);
+        const size_t out = dequeue_pos_.load(std::memory_order_relaxed);
+        return in > out ? in - out : 0;
+    }
+};
+
+// 事件计数器：等待方先 prepare_wait 取得当前纪元，再检查一次条件，仍不满足才 wait；
+// 通知方改变条件后 notify_all。没有等待者时 notify_all 只是一次原子读
+class EventCount {
+    std::atomic<uint64_t> epoch_{0};
+    std::atomic<int> waiters_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+public:
+    uint64_t prepare_wait() {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        const uint64_t key = epoch_.load(std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return key;
+    }
+
+    void cancel_wait() {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // 等到纪元变化；给出 deadline 时超时返回 false
+    bool wait(const uint64_t key, const std::chrono::steady_clock::time_point* deadline = nullptr) {
+        std::unique_lock lock(mutex_);
+        const auto changed = [&] { return epoch_.load(std::memory_order_relaxed) != key; };
+        bool ok = true;
+        if (deadline == nullptr) {
+            cv_.wait(lock, changed);
+        } else {
+            ok = cv_.wait_until(lock, *deadline, changed);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return ok;
+    }
+
+    void notify_all() {
+        // 与等待方的 prepare_wait 配对：条件的写入先于此处对 waiters_ 的读取
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) return;
+        {
+            std::lock_guard lock(mutex_);
+            epoch_.fetch_add(1, std::memory_order_relaxed);
+        }
+        cv_.notify_all();
+    }
+};
+
+} // namespace deps
@@ -0,0 +1,145 @@
+/**
+ * @file open_table.hpp
+ * @brief 开放寻址哈希表（线性探测 + 墓碑删除），键类型与哈希/相等由 Traits 决定
+ * 控制字节与槽位分开存放，探测时先扫紧凑的控制字节与缓存哈希，命中才比较键
+ * @author azhz1107cat
+ * @date 2025-12-18
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace deps {
+
+// 无值占位（集合使用）
+struct Unit {};
+
+// Traits 需提供：static size_t hash(const K&); static bool equal(const K&, const K&);
+template <typename K, typename V, typename Traits>
+class OpenTable {
+    enum : uint8_t { EMPTY = 0, FULL = 1, DELETED = 2 };
+
+    struct Slot {
+        K key{};
+        V value{};
+        size_t hash = 0;
+    };
+
+    std::vector<uint8_t> ctrl_;
+    std::vector<Slot> slots_;
+    size_t count_ = 0;  // 有效元素数
+    size_t used_ = 0;   // 有效元素 + 墓碑数（决定何时重建）
+
+    [[nodiscard]] size_t mask() const {
+        return slots_.size() - 1;
+    }
+
+    // 查找键所在槽位下标，找不到返回 -1
+    [[nodiscard]] size_t locate(const K& key, const size_t hash) const {
+        if (slots_.empty()) return static_cast<size_t>(-1);
+        for (size_t i = hash & mask();; i = (i + 1) & mask()) {
+            if (ctrl_[i] == EMPTY) return static_cast<size_t>(-1);
+            if (ctrl_[i] == FULL && slots_[i].hash == hash && Traits::equal(slots_[i].key, key)) return i;
+        }
+    }
+
+    // 重建为 new_cap 个槽位（同时清除墓碑）
+    void rehash(const size_t new_cap) {
+        std::vector<uint8_t> old_ctrl = std::move(ctrl_);
+        std::vector<Slot> old_slots = std::move(slots_);
+        ctrl_.assign(new_cap, EMPTY);
+        slots_.clear();
+        slots_.resize(new_cap);
+        used_ = count_;
+        for (size_t i = 0; i < old_slots.size(); ++i) {
+            if (old_ctrl[i] != FULL) continue;
+            size_t j = old_slots[i].hash & mask();
+            while (ctrl_[j] != EMPTY) j = (j + 1) & mask();
+            ctrl_[j] = FULL;
+            slots_[j] = std::move(old_slots[i]);
+        }
+    }
+
+    // 负载（含墓碑）不超过 7/8
+    void grow_if_needed() {
+        if (slots_.empty()) {
+            rehash(8);
+        } else if ((used_ + 1) * 8 > slots_.size() * 7) {
+            rehash(count_ * 2 >= slots_.size() ? slots_.size() * 2 : slots_.size());
+        }
+    }
+
+public:
+    OpenTable() = default;
+
+    // 预留至少能容纳 n 个元素的空间
+    void reserve(const size_t n) {
+        size_t cap = 8;
+        while (cap * 7 < n * 8) cap *= 2;
+        if (cap > slots_.size()) rehash(cap);
+    }
+
+    [[nodiscard]] size_t size() const {
+        return count_;
+    }
+
+    [[nodiscard]] V* find(const K& key) const {
+        const size_t i = locate(key, Traits::hash(key));
+        return i == static_cast<size_t>(-1) ? nullptr : const_cast<V*>(&slots_[i].value);
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        return locate(key, Traits::hash(key)) != static_cast<size_t>(-1);
+    }
+
+    // 查找或插入键；返回值的指针与是否为新插入（新插入时值为默认构造，由调用方填写）
+    std::pair<V*, bool> emplace(const K& key) {
+        const size_t hash = Traits::hash(key);
+        if (const size_t i = locate(key, hash); i != static_cast<size_t>(-1)) {
+            return {&slots_[i].value, false};
+        }
+        grow_if_needed();
+        size_t i = hash & mask();
+        while (ctrl_[i] == FULL) i = (i + 1) & mask();
+        if (ctrl_[i] == EMPTY) ++used_;
+        ctrl_[i] = FULL;
+        slots_[i].key = key;
+        slots_[i].value = V{};
+        slots_[i].hash = hash;
+        ++count_;
+        return {&slots_[i].value, true};
+    }
+
+    // 删除键；成功时通过 out_key / out_value 交还原有的键值（便于调用方释放引用）
+    bool erase(const K& key, K* out_key = nullptr, V* out_value = nullptr) {
+        const size_t i = locate(key, Traits::hash(key));
+        if (i == static_cast<size_t>(-1)) return false;
+        if (out_key) *out_key = std::move(slots_[i].key);
+        if (out_value) *out_value = std::move(slots_[i].value);
+        slots_[i] = Slot{};
+        ctrl_[i] = DELETED;
+        --count_;
+        return true;
+    }
+
+    // 遍历全部键值对 f(key, value)
+    template <typename F>
+    void for_each(F&& f) const {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (ctrl_[i] == FULL) f(slots_[i].key, slots_[i].value);
+        }
+    }
+
+    void clear() {
+        ctrl_.clear();
+        slots_.clear();
+        count_ = 0;
+        used_ = 0;
+    }
+};
+
+} // namespace deps
@@ -0,0 +1,120 @@
+/**
+ * @file out_buffer.hpp
+ * @brief 带缓冲的输出流：写入先追加到内存缓冲，缓冲写满、显式 flush 或析构时一次性写出
+ * 目标是终端时按行写出，保证交互输出及时可见。断言失败经 abort() 退出、不运行析构函数，
+ * flush_on_abort 登记的缓冲在 SIGABRT 时仍会写出
+ * @author azhz1107cat
+ * @date 2025-12-22
+ */
+
+#pragma once
+
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <io.h>
+#define DEPS_OUT_WRITE _write
+#define DEPS_OUT_FILENO _fileno
+#else
+#define DEPS_OUT_WRITE ::write
+#define DEPS_OUT_FILENO fileno
+#include <unistd.h>
+#endif
+
+namespace deps {
+
+class OutBuffer {
+    std::FILE* file_;
+    std::string buf_;
+    size_t capacity_;
+    bool line_buffered_;
+
+    // 当前线程在 abort 时要写出的缓冲
+    static OutBuffer*& abort_target() {
+        thread_local OutBuffer* target = nullptr;
+        return target;
+    }
+
+    // SIGABRT：直接用 write 写出缓冲中已有的内容，再按默认行为终止
+    static void on_abort(const int sig) {
+        if (const OutBuffer* out = abort_target(); out != nullptr && !out->buf_.empty()) {
+            const auto written = DEPS_OUT_WRITE(DEPS_OUT_FILENO(out->file_), out->buf_.data(),
+                                                static_cast<unsigned>(out->buf_.size()));
+            (void)written;
+        }
+        std::signal(sig, SIG_DFL);
+        std::raise(sig);
+    }
+
+public:
+    explicit OutBuffer(std::FILE* file, const size_t capacity = 64 * 1024)
+        : file_(file), capacity_(capacity) {
+#ifdef _WIN32
+        line_buffered_ = _isatty(_fileno(file)) != 0;
+#else
+        line_buffered_ = isatty(fileno(file)) != 0;
+#endif
+        buf_.reserve(capacity_);
+    }
+
+    OutBuffer(const OutBuffer&) = delete;
+    OutBuffer& operator=(const OutBuffer&) = delete;
+
+    ~OutBuffer() {
+        if (abort_target() == this) abort_target() = nullptr;
+        flush();
+    }
+
+    // 当前线程因断言失败等致命错误 abort 时，先写出本缓冲中已有的输出
+    void flush_on_abort() {
+        abort_target() = this;
+        static const bool installed = [] {
+            std::signal(SIGABRT, on_abort);
+            return true;
+        }();
+        (void)installed;
+    }
+
+    // 直接向缓冲追加内容（如 append_repr），写完后调用 commit / end_line
+    std::string& buffer() {
+        return buf_;
+    }
+
+    void write(const std::string_view s) {
+        buf_.append(s);
+        commit();
+    }
+
+    void put(const char c) {
+        buf_.push_back(c);
+        commit();
+    }
+
+    // 缓冲超过容量时写出
+    void commit() {
+        if (buf_.size() >= capacity_) flush();
+    }
+
+    // 一行结束：终端上立即写出，否则等缓冲写满
+    void end_line() {
+        buf_.push_back('\n');
+        if (line_buffered_ || buf_.size() >= capacity_) flush();
+    }
+
+    void flush() {
+        if (!buf_.empty()) {
+            std::fwrite(buf_.data(), 1, buf_.size(), file_);
+            buf_.clear();
+        }
+        std::fflush(file_);
+    }
+};
+
+} // namespace deps
+
+#undef DEPS_OUT_WRITE
+#undef DEPS_OUT_FILENO
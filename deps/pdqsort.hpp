@@ -0,0 +1,243 @@
+/**
+ * @file pdqsort.hpp
+ * @brief Pattern-defeating quicksort（不稳定排序）
+ * 小区间插入排序；枢轴取三数/九数中值；检测已划分区间时尝试部分插入排序；
+ * 划分严重失衡次数过多时退化为堆排序，保证 O(n log n) 最坏复杂度
+ * @author azhz1107cat
+ * @date 2025-12-20
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace deps::pdq {
+
+constexpr std::ptrdiff_t insertion_sort_threshold = 24;
+constexpr std::ptrdiff_t ninther_threshold = 128;
+constexpr std::ptrdiff_t partial_insertion_sort_limit = 8;
+
+template <typename T>
+int log2_floor(T n) {
+    int log = 0;
+    while (n >>= 1) ++log;
+    return log;
+}
+
+// [begin, end) 插入排序
+template <typename Iter, typename Compare>
+void insertion_sort(Iter begin, Iter end, Compare comp) {
+    if (begin == end) return;
+    for (Iter cur = begin + 1; cur != end; ++cur) {
+        Iter sift = cur;
+        Iter sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            auto tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+// 与 insertion_sort 相同，但假定 begin 左侧存在不大于区间内任何元素的哨兵
+template <typename Iter, typename Compare>
+void unguarded_insertion_sort(Iter begin, Iter end, Compare comp) {
+    if (begin == end) return;
+    for (Iter cur = begin + 1; cur != end; ++cur) {
+        Iter sift = cur;
+        Iter sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            auto tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+// 尝试插入排序，移动次数超过上限即放弃；返回区间是否已排好
+template <typename Iter, typename Compare>
+bool partial_insertion_sort(Iter begin, Iter end, Compare comp) {
+    if (begin == end) return true;
+    std::size_t limit = 0;
+    for (Iter cur = begin + 1; cur != end; ++cur) {
+        Iter sift = cur;
+        Iter sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            auto tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+            limit += cur - sift;
+        }
+        if (limit > partial_insertion_sort_limit) return false;
+    }
+    return true;
+}
+
+template <typename Iter, typename Compare>
+void sort2(Iter a, Iter b, Compare comp) {
+    if (comp(*b, *a)) std::iter_swap(a, b);
+}
+
+template <typename Iter, typename Compare>
+void sort3(Iter a, Iter b, Iter c, Compare comp) {
+    sort2(a, b, comp);
+    sort2(b, c, comp);
+    sort2(a, b, comp);
+}
+
+// 以 *begin 为枢轴划分：返回枢轴最终位置，以及划分前是否已经有序划分
+template <typename Iter, typename Compare>
+std::pair<Iter, bool> partition_right(Iter begin, Iter end, Compare comp) {
+    auto pivot = std::move(*begin);
+    Iter first = begin;
+    Iter last = end;
+
+    // 找第一个 >= pivot 的元素（中值选取保证存在）
+    while (comp(*++first, pivot)) {}
+
+    // 找第一个 < pivot 的元素（若左侧没有交换过，需防越界）
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {}
+    } else {
+        while (!comp(*--last, pivot)) {}
+    }
+
+    const bool already_partitioned = first >= last;
+
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (comp(*++first, pivot)) {}
+        while (!comp(*--last, pivot)) {}
+    }
+
+    Iter pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return {pivot_pos, already_partitioned};
+}
+
+// 与 partition_right 相反：等于枢轴的元素放左侧，用于大量重复元素
+template <typename Iter, typename Compare>
+Iter partition_left(Iter begin, Iter end, Compare comp) {
+    auto pivot = std::move(*begin);
+    Iter first = begin;
+    Iter last = end;
+
+    while (comp(pivot, *--last)) {}
+
+    if (last + 1 == end) {
+        while (first < last && !comp(pivot, *++first)) {}
+    } else {
+        while (!comp(pivot, *++first)) {}
+    }
+
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (comp(pivot, *--last)) {}
+        while (!comp(pivot, *++first)) {}
+    }
+
+    Iter pivot_pos = last;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+template <typename Iter, typename Compare>
+void pdqsort_loop(Iter begin, Iter end, Compare comp, int bad_allowed, bool leftmost) {
+    using diff_t = typename std::iterator_traits<Iter>::difference_type;
+
+    while (true) {
+        const diff_t size = end - begin;
+
+        if (size < insertion_sort_threshold) {
+            if (leftmost) {
+                insertion_sort(begin, end, comp);
+            } else {
+                unguarded_insertion_sort(begin, end, comp);
+            }
+            return;
+        }
+
+        // 枢轴：三数取中，大区间用九数取中；选出的枢轴放到 begin
+        const diff_t s2 = size / 2;
+        if (size > ninther_threshold) {
+            sort3(begin, begin + s2, end - 1, comp);
+            sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+            sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+            sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+            std::iter_swap(begin, begin + s2);
+        } else {
+            sort3(begin + s2, begin, end - 1, comp);
+        }
+
+        // 左侧已有不大于本区间的哨兵且与枢轴相等：大量重复元素，放左侧后跳过
+        if (!leftmost && !comp(*(begin - 1), *begin)) {
+            begin = partition_left(begin, end, comp) + 1;
+            continue;
+        }
+
+        const auto [pivot_pos, already_partitioned] = partition_right(begin, end, comp);
+
+        const diff_t l_size = pivot_pos - begin;
+        const diff_t r_size = end - (pivot_pos + 1);
+        const bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced) {
+            // 失衡过多：改用堆排序保证最坏情况
+            if (--bad_allowed == 0) {
+                std::make_heap(begin, end, comp);
+                std::sort_heap(begin, end, comp);
+                return;
+            }
+            // 打乱若干元素以破坏导致失衡的模式
+            if (l_size >= insertion_sort_threshold) {
+                std::iter_swap(begin, begin + l_size / 4);
+                std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if (l_size > ninther_threshold) {
+                    std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                    std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                    std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= insertion_sort_threshold) {
+                std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                std::iter_swap(end - 1, end - r_size / 4);
+                if (r_size > ninther_threshold) {
+                    std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    std::iter_swap(end - 2, end - (1 + r_size / 4));
+                    std::iter_swap(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        } else if (already_partitioned
+                   && partial_insertion_sort(begin, pivot_pos, comp)
+                   && partial_insertion_sort(pivot_pos + 1, end, comp)) {
+            // 划分前就已有序划分，且两侧都接近有序：直接完成
+            return;
+        }
+
+        // 递归处理左侧，循环处理右侧
+        pdqsort_loop(begin, pivot_pos, comp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+template <typename Iter, typename Compare>
+void sort(Iter begin, Iter end, Compare comp) {
+    if (begin == end) return;
+    pdqsort_loop(begin, end, comp, log2_floor(end - begin), true);
+}
+
+} // namespace deps::pdq
@@ -0,0 +1,264 @@
+/**
+ * @file rrb_vector.hpp
+ * @brief 持久化向量（Relaxed Radix Balanced tree），分支因子 32
+ * 所有操作返回新向量，与旧向量共享未改动的节点；下标、更新、push、拼接、切片均为 O(log n)
+ * 内部节点带累计大小表（relaxed），拼接只在接缝处合并 / 拆分节点，不整体重建
+ * @author azhz1107cat
+ * @date 2025-12-21
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace deps {
+
+template <typename T>
+class RrbVector {
+    static constexpr size_t BITS = 5;
+    static constexpr size_t WIDTH = size_t(1) << BITS;
+
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    // 叶子只用 items；内部节点用 children 与累计大小 sizes（sizes[i] = 前 i+1 个子树的元素总数）
+    struct Node {
+        std::vector<T> items;
+        std::vector<NodePtr> children;
+        std::vector<size_t> sizes;
+    };
+
+    NodePtr root_;
+    size_t size_ = 0;
+    size_t height_ = 0;  // 0 表示根即叶子
+
+    RrbVector(NodePtr root, const size_t size, const size_t height)
+        : root_(std::move(root)), size_(size), height_(height) {}
+
+    static size_t node_size(const NodePtr& node, const size_t height) {
+        return height == 0 ? node->items.size() : node->sizes.back();
+    }
+
+    static NodePtr make_leaf(std::vector<T> items) {
+        auto node = std::make_shared<Node>();
+        node->items = std::move(items);
+        return node;
+    }
+
+    static NodePtr make_internal(std::vector<NodePtr> children, const size_t height) {
+        auto node = std::make_shared<Node>();
+        node->sizes.reserve(children.size());
+        size_t total = 0;
+        for (const NodePtr& child : children) {
+            total += node_size(child, height - 1);
+            node->sizes.push_back(total);
+        }
+        node->children = std::move(children);
+        return node;
+    }
+
+    // 在高度 height 的内部节点中定位下标 i 所在的子节点：先按满树的基数位猜测，再沿大小表右移
+    static size_t child_index(const Node& node, const size_t height, const size_t i) {
+        size_t idx = i >> (BITS * height);
+        if (idx >= node.sizes.size()) idx = node.sizes.size() - 1;
+        while (node.sizes[idx] <= i) ++idx;
+        return idx;
+    }
+
+    // 把不超过 2 * WIDTH 个同层元素打包成 1 或 2 个节点：满的一侧背离 small_left 所指的一侧，
+    // 零头留在较短操作数那边，反复 push / 在头部拼接时零头会被下一次拼接继续填满，不会堆积成稀疏节点
+    static std::vector<NodePtr> pack_leaves(std::vector<T> items, const bool small_left) {
+        if (items.size() <= WIDTH) return {make_leaf(std::move(items))};
+        const size_t cut = small_left ? items.size() - WIDTH : WIDTH;
+        std::vector<T> rest(items.begin() + cut, items.end());
+        items.resize(cut);
+        return {make_leaf(std::move(items)), make_leaf(std::move(rest))};
+    }
+
+    static std::vector<NodePtr> pack_children(std::vector<NodePtr> children, const size_t height, const bool small_left) {
+        if (children.size() <= WIDTH) return {make_internal(std::move(children), height)};
+        const size_t cut = small_left ? children.size() - WIDTH : WIDTH;
+        std::vector<NodePtr> rest(children.begin() + cut, children.end());
+        children.resize(cut);
+        return {make_internal(std::move(children), height), make_internal(std::move(rest), height)};
+    }
+
+    // 拼接两棵子树，返回高度为 max(ha, hb) 的 1 或 2 个节点
+    static std::vector<NodePtr> merge(const NodePtr& a, const size_t ha, const NodePtr& b, const size_t hb,
+                                      const bool small_left) {
+        if (ha == 0 && hb == 0) {
+            std::vector<T> items;
+            items.reserve(a->items.size() + b->items.size());
+            items.insert(items.end(), a->items.begin(), a->items.end());
+            items.insert(items.end(), b->items.begin(), b->items.end());
+            return pack_leaves(std::move(items), small_left);
+        }
+
+        std::vector<NodePtr> children;
+        if (ha > hb) {
+            // 沿 a 的右边缘下降到与 b 同高
+            const auto mid = merge(a->children.back(), ha - 1, b, hb, small_left);
+            children.assign(a->children.begin(), a->children.end() - 1);
+            children.insert(children.end(), mid.begin(), mid.end());
+            return pack_children(std::move(children), ha, small_left);
+        }
+        if (ha < hb) {
+            const auto mid = merge(a, ha, b->children.front(), hb - 1, small_left);
+            children.assign(mid.begin(), mid.end());
+            children.insert(children.end(), b->children.begin() + 1, b->children.end());
+            return pack_children(std::move(children), hb, small_left);
+        }
+        // 同高：合并接缝两侧的子树
+        const auto mid = merge(a->children.back(), ha - 1, b->children.front(), hb - 1, small_left);
+        children.reserve(a->children.size() + b->children.size());
+        children.assign(a->children.begin(), a->children.end() - 1);
+        children.insert(children.end(), mid.begin(), mid.end());
+        children.insert(children.end(), b->children.begin() + 1, b->children.end());
+        return pack_children(std::move(children), ha, small_left);
+    }
+
+    // 保留前 n 个元素（0 < n <= 子树大小）
+    static NodePtr take(const NodePtr& node, const size_t height, const size_t n) {
+        if (n == node_size(node, height)) return node;
+        if (height == 0) return make_leaf(std::vector<T>(node->items.begin(), node->items.begin() + n));
+        const size_t idx = child_index(*node, height, n - 1);
+        const size_t before = idx == 0 ? 0 : node->sizes[idx - 1];
+        std::vector<NodePtr> children(node->children.begin(), node->children.begin() + idx);
+        children.push_back(take(node->children[idx], height - 1, n - before));
+        return make_internal(std::move(children), height);
+    }
+
+    // 丢弃前 n 个元素（0 <= n < 子树大小）
+    static NodePtr drop(const NodePtr& node, const size_t height, const size_t n) {
+        if (n == 0) return node;
+        if (height == 0) return make_leaf(std::vector<T>(node->items.begin() + n, node->items.end()));
+        const size_t idx = child_index(*node, height, n);
+        const size_t before = idx == 0 ? 0 : node->sizes[idx - 1];
+        std::vector<NodePtr> children;
+        children.reserve(node->children.size() - idx);
+        children.push_back(drop(node->children[idx], height - 1, n - before));
+        children.insert(children.end(), node->children.begin() + idx + 1, node->children.end());
+        return make_internal(std::move(children), height);
+    }
+
+    static NodePtr assoc(const NodePtr& node, const size_t height, const size_t i, const T& value) {
+        auto copy = std::make_shared<Node>(*node);
+        if (height == 0) {
+            copy->items[i] = value;
+        } else {
+            const size_t idx = child_index(*node, height, i);
+            const size_t before = idx == 0 ? 0 : node->sizes[idx - 1];
+            copy->children[idx] = assoc(node->children[idx], height - 1, i - before, value);
+        }
+        return copy;
+    }
+
+    template <typename F>
+    static void walk(const NodePtr& node, const size_t height, F& f) {
+        if (height == 0) {
+            for (const T& item : node->items) f(item);
+            return;
+        }
+        for (const NodePtr& child : node->children) walk(child, height - 1, f);
+    }
+
+    // 去掉只有一个子节点的根，降低树高
+    static RrbVector normalized(NodePtr root, const size_t size, size_t height) {
+        while (height > 0 && root->children.size() == 1) {
+            root = root->children.front();
+            --height;
+        }
+        return RrbVector(std::move(root), size, height);
+    }
+
+public:
+    RrbVector() = default;
+
+    // 由连续数组自底向上批量构建（O(n)，每层节点都是满的）
+    static RrbVector from_vector(const std::vector<T>& items) {
+        if (items.empty()) return {};
+        std::vector<NodePtr> level;
+        level.reserve((items.size() + WIDTH - 1) / WIDTH);
+        for (size_t i = 0; i < items.size(); i += WIDTH) {
+            const size_t end = std::min(items.size(), i + WIDTH);
+            level.push_back(make_leaf(std::vector<T>(items.begin() + i, items.begin() + end)));
+        }
+        size_t height = 0;
+        while (level.size() > 1) {
+            ++height;
+            std::vector<NodePtr> parents;
+            parents.reserve((level.size() + WIDTH - 1) / WIDTH);
+            for (size_t i = 0; i < level.size(); i += WIDTH) {
+                const size_t end = std::min(level.size(), i + WIDTH);
+                parents.push_back(make_internal(std::vector<NodePtr>(level.begin() + i, level.begin() + end), height));
+            }
+            level = std::move(parents);
+        }
+        return RrbVector(level.front(), items.size(), height);
+    }
+
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] const T& get(size_t i) const {
+        assert(i < size_ && "RrbVector index out of range");
+        const Node* node = root_.get();
+        for (size_t h = height_; h > 0; --h) {
+            const size_t idx = child_index(*node, h, i);
+            if (idx > 0) i -= node->sizes[idx - 1];
+            node = node->children[idx].get();
+        }
+        return node->items[i];
+    }
+
+    [[nodiscard]] RrbVector set(const size_t i, const T& value) const {
+        assert(i < size_ && "RrbVector index out of range");
+        return RrbVector(assoc(root_, height_, i, value), size_, height_);
+    }
+
+    [[nodiscard]] RrbVector push_back(const T& value) const {
+        return concat(*this, RrbVector(make_leaf({value}), 1, 0));
+    }
+
+    [[nodiscard]] static RrbVector concat(const RrbVector& a, const RrbVector& b) {
+        if (a.empty()) return b;
+        if (b.empty()) return a;
+        const auto nodes = merge(a.root_, a.height_, b.root_, b.height_, a.size_ < b.size_);
+        const size_t height = std::max(a.height_, b.height_);
+        if (nodes.size() == 1) return RrbVector(nodes.front(), a.size_ + b.size_, height);
+        return RrbVector(make_internal(nodes, height + 1), a.size_ + b.size_, height + 1);
+    }
+
+    // 区间 [begin, end)
+    [[nodiscard]] RrbVector slice(const size_t begin, const size_t end) const {
+        assert(begin <= end && end <= size_ && "RrbVector slice out of range");
+        if (begin == end) return {};
+        NodePtr root = take(root_, height_, end);
+        root = drop(root, height_, begin);
+        return normalized(std::move(root), end - begin, height_);
+    }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        if (root_) walk(root_, height_, f);
+    }
+
+    [[nodiscard]] std::vector<T> to_vector() const {
+        std::vector<T> out;
+        out.reserve(size_);
+        for_each([&out](const T& item) { out.push_back(item); });
+        return out;
+    }
+};
+
+} // namespace deps
@@ -0,0 +1,76 @@
+/**
+ * @file simd_search.hpp
+ * @brief 子串查找：单字节走 memchr，多字节用 SIMD 首/尾字节过滤后再逐个确认
+ * 每次比较 16（SSE2）字节窗口，首字节与尾字节同时命中的位置才调用 memcmp
+ * @author azhz1107cat
+ * @date 2025-12-17
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "bit_ops.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DEPS_SEARCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace deps::search {
+
+constexpr size_t npos = static_cast<size_t>(-1);
+
+// 在 hay[from, n) 中查找 needle[0, m)，返回首个匹配的字节偏移，找不到返回 npos
+inline size_t find(const char* hay, const size_t n, const char* needle, const size_t m, size_t from = 0) {
+    if (m == 0) return from <= n ? from : npos;
+    if (from >= n || m > n - from) return npos;
+
+    if (m == 1) {
+        const void* hit = std::memchr(hay + from, needle[0], n - from);
+        return hit ? static_cast<size_t>(static_cast<const char*>(hit) - hay) : npos;
+    }
+
+    const size_t last = n - m;  // 最后一个可能的起点
+    size_t i = from;
+#if defined(DEPS_SEARCH_SSE2)
+    const __m128i first_v = _mm_set1_epi8(needle[0]);
+    const __m128i last_v = _mm_set1_epi8(needle[m - 1]);
+    for (; i + 16 <= last + 1; i += 16) {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + m - 1));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block_first, first_v), _mm_cmpeq_epi8(block_last, last_v))));
+        while (mask) {
+            const auto bit = static_cast<size_t>(bits::ctz(mask));
+            if (std::memcmp(hay + i + bit + 1, needle + 1, m - 2) == 0) return i + bit;
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i <= last; ++i) {
+        if (hay[i] == needle[0] && hay[i + m - 1] == needle[m - 1]
+            && std::memcmp(hay + i + 1, needle + 1, m - 2) == 0) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+// 收集全部不重叠匹配的起始偏移，供 split/replace 预先计算输出大小
+inline std::vector<size_t> find_all(const char* hay, const size_t n, const char* needle, const size_t m) {
+    std::vector<size_t> hits;
+    if (m == 0) return hits;
+    for (size_t pos = find(hay, n, needle, m); pos != npos; pos = find(hay, n, needle, m, pos + m)) {
+        hits.push_back(pos);
+    }
+    return hits;
+}
+
+inline bool is_space(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+} // namespace deps::search
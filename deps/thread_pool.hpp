@@ -0,0 +1,183 @@
+/**
+ * @file thread_pool.hpp
+ * @brief 常驻线程池与带工作窃取的 parallel_for
+ * 任务下标 [0, n) 先按线程均分为连续区间；线程从自己区间的头部取任务，
+ * 取完后从其他线程区间的尾部一次窃取一半。区间的起止打包在一个 64 位原子量里，取与窃取都是一次 CAS
+ * @author azhz1107cat
+ * @date 2025-12-27
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "mpmc_queue.hpp"
+
+namespace deps {
+
+class ThreadPool {
+    // 高 32 位为 begin，低 32 位为 end；begin >= end 表示区间已空
+    struct alignas(cache_line) Range {
+        std::atomic<uint64_t> bounds{0};
+    };
+
+    static uint64_t pack(const uint64_t begin, const uint64_t end) { return begin << 32 | end; }
+    static uint32_t begin_of(const uint64_t bounds) { return static_cast<uint32_t>(bounds >> 32); }
+    static uint32_t end_of(const uint64_t bounds) { return static_cast<uint32_t>(bounds); }
+
+    size_t size_;  // 参与计算的线程数（含调用线程）
+    std::unique_ptr<Range[]> ranges_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable start_cv_, done_cv_;
+    uint64_t generation_ = 0;
+    size_t running_ = 0;
+    const std::function<void(size_t)>* job_ = nullptr;
+    bool stopping_ = false;
+
+    std::mutex run_mutex_;  // 同一时刻只执行一个 parallel_for
+
+    static bool& in_pool() {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    // 从自己的区间头部取一个任务
+    bool pop(const size_t self, size_t& task) {
+        uint64_t bounds = ranges_[self].bounds.load(std::memory_order_relaxed);
+        while (begin_of(bounds) < end_of(bounds)) {
+            if (ranges_[self].bounds.compare_exchange_weak(bounds, pack(begin_of(bounds) + 1, end_of(bounds)),
+                                                           std::memory_order_acq_rel)) {
+                task = begin_of(bounds);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 从 victim 区间尾部窃取一半放入自己的区间
+    bool steal(const size_t self, const size_t victim) {
+        uint64_t bounds = ranges_[victim].bounds.load(std::memory_order_relaxed);
+        while (begin_of(bounds) < end_of(bounds)) {
+            const uint32_t begin = begin_of(bounds), end = end_of(bounds);
+            const uint32_t mid = end - (end - begin + 1) / 2;
+            if (ranges_[victim].bounds.compare_exchange_weak(bounds, pack(begin, mid), std::memory_order_acq_rel)) {
+                // 自己的区间已空，其他线程不会再修改它
+                ranges_[self].bounds.store(pack(mid, end), std::memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(const size_t self, const std::function<void(size_t)>& job) {
+        size_t task = 0;
+        for (;;) {
+            while (pop(self, task)) job(task);
+            bool stolen = false;
+            for (size_t k = 1; k < size_ && !stolen; ++k) stolen = steal(self, (self + k) % size_);
+            if (!stolen) return;
+        }
+    }
+
+    void worker_loop(const size_t self) {
+        in_pool() = true;
+        uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(size_t)>* job = nullptr;
+            {
+                std::unique_lock lock(mutex_);
+                start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_) return;
+                seen = generation_;
+                job = job_;
+            }
+            run(self, *job);
+            {
+                std::lock_guard lock(mutex_);
+                if (--running_ == 0) done_cv_.notify_one();
+            }
+        }
+    }
+
+    explicit ThreadPool(const size_t threads) : size_(std::max<size_t>(1, threads)),
+                                                 ranges_(std::make_unique<Range[]>(size_)) {
+        workers_.reserve(size_ - 1);
+        for (size_t i = 1; i < size_; ++i) workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+
+public:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 进程内唯一的线程池，线程数为硬件线程数，首次使用时创建
+    static ThreadPool& instance() {
+        static ThreadPool pool(std::thread::hardware_concurrency());
+        return pool;
+    }
+
+    [[nodiscard]] size_t size() const { return size_; }
+
+    // 当前线程是否正在执行 parallel_for 的任务（含参与计算的调用线程）
+    static bool in_worker() { return in_pool(); }
+
+    // 对 [0, n) 的每个下标调用 job，返回时全部完成；调用线程也参与计算。
+    // 在池内线程中再次调用时直接顺序执行
+    void parallel_for(const size_t n, const std::function<void(size_t)>& job) {
+        if (n == 0) return;
+        if (size_ == 1 || n == 1 || in_pool()) {
+            // 顺序执行时同样标记为任务内，in_worker() 的结果不随线程数变化
+            const bool nested = in_pool();
+            in_pool() = true;
+            for (size_t i = 0; i < n; ++i) job(i);
+            in_pool() = nested;
+            return;
+        }
+        assert(n <= UINT32_MAX && "parallel_for: 任务数过多");
+        std::lock_guard run_lock(run_mutex_);
+        const size_t per = n / size_, extra = n % size_;
+        size_t begin = 0;
+        for (size_t t = 0; t < size_; ++t) {
+            const size_t end = begin + per + (t < extra ? 1 : 0);
+            ranges_[t].bounds.store(pack(begin, end), std::memory_order_relaxed);
+            begin = end;
+        }
+        {
+            std::lock_guard lock(mutex_);
+            job_ = &job;
+            running_ = size_ - 1;
+            ++generation_;
+        }
+        start_cv_.notify_all();
+
+        in_pool() = true;
+        run(0, job);
+        in_pool() = false;
+
+        std::unique_lock lock(mutex_);
+        done_cv_.wait(lock, [&] { return running_ == 0; });
+        job_ = nullptr;
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+};
+
+} // namespace deps
@@ -0,0 +1,173 @@
+/**
+ * @file utf8.hpp
+ * @brief UTF-8 辅助函数：校验、码点计数、稀疏偏移索引
+ * ASCII 段与码点计数按 16 字节用 SSE2 批量处理
+ * @author azhz1107cat
+ * @date 2025-12-16
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DEPS_UTF8_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace deps::utf8 {
+
+// 稀疏索引步长：每隔 INDEX_STRIDE 个码点记录一次字节偏移
+constexpr size_t INDEX_STRIDE = 64;
+
+inline bool is_continuation(const unsigned char c) {
+    return (c & 0xC0) == 0x80;
+}
+
+inline int popcount16(unsigned mask) {
+    int n = 0;
+    while (mask) {
+        mask &= mask - 1;
+        ++n;
+    }
+    return n;
+}
+
+// 是否全部为 ASCII 字节
+inline bool is_ascii(const char* s, const size_t n) {
+    size_t i = 0;
+#if defined(DEPS_UTF8_SSE2)
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        if (_mm_movemask_epi8(v) != 0) return false;
+    }
+#endif
+    for (; i < n; ++i) {
+        if (static_cast<unsigned char>(s[i]) >= 0x80) return false;
+    }
+    return true;
+}
+
+// 校验 UTF-8 合法性（拒绝过长编码、代理区与超出 U+10FFFF 的码点）
+inline bool validate(const char* s, const size_t n) {
+    size_t i = 0;
+    while (i < n) {
+#if defined(DEPS_UTF8_SSE2)
+        // 跳过整段 ASCII
+        while (i + 16 <= n && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i))) == 0) {
+            i += 16;
+        }
+        if (i >= n) break;
+#endif
+        const auto c = static_cast<unsigned char>(s[i]);
+        if (c < 0x80) {
+            ++i;
+            continue;
+        }
+        size_t len;
+        unsigned char lo = 0x80, hi = 0xBF;  // 第二个字节的合法范围
+        if (c >= 0xC2 && c <= 0xDF) {
+            len = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            len = 3;
+            if (c == 0xE0) lo = 0xA0;
+            if (c == 0xED) hi = 0x9F;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            len = 4;
+            if (c == 0xF0) lo = 0x90;
+            if (c == 0xF4) hi = 0x8F;
+        } else {
+            return false;
+        }
+        if (i + len > n) return false;
+        const auto c1 = static_cast<unsigned char>(s[i + 1]);
+        if (c1 < lo || c1 > hi) return false;
+        for (size_t k = 2; k < len; ++k) {
+            if (!is_continuation(static_cast<unsigned char>(s[i + k]))) return false;
+        }
+        i += len;
+    }
+    return true;
+}
+
+// 统计码点数（即非延续字节的个数；调用方保证已通过校验）
+inline size_t count_code_points(const char* s, const size_t n) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(DEPS_UTF8_SSE2)
+    // 有符号比较：延续字节 0x80-0xBF 即 -128..-65，其余字节 > -65
+    const __m128i threshold = _mm_set1_epi8(-65);
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        count += popcount16(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, threshold))));
+    }
+#endif
+    for (; i < n; ++i) {
+        if (!is_continuation(static_cast<unsigned char>(s[i]))) ++count;
+    }
+    return count;
+}
+
+// 构建稀疏偏移索引：offsets[k] 为第 k * INDEX_STRIDE 个码点的字节偏移；返回码点总数
+inline size_t build_index(const char* s, const size_t n, std::vector<size_t>& offsets) {
+    offsets.clear();
+    size_t cp = 0;  // 已经过的码点数
+    size_t i = 0;
+    while (i < n) {
+#if defined(DEPS_UTF8_SSE2)
+        // 整块跳过：块内起始的码点下标为 [cp, cp + in_block)，其中没有需要记录的点时直接累加
+        if (i + 16 <= n) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            const size_t in_block = popcount16(static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_cmpgt_epi8(v, _mm_set1_epi8(-65)))));
+            if (cp + in_block <= offsets.size() * INDEX_STRIDE) {
+                cp += in_block;
+                i += 16;
+                continue;
+            }
+        }
+#endif
+        if (!is_continuation(static_cast<unsigned char>(s[i]))) {
+            if (cp % INDEX_STRIDE == 0) offsets.push_back(i);
+            ++cp;
+        }
+        ++i;
+    }
+    return cp;
+}
+
+// 借助稀疏索引求第 cp_idx 个码点的字节偏移（cp_idx == 码点总数时返回 n）
+inline size_t offset_of(const char* s, const size_t n, const std::vector<size_t>& offsets, const size_t cp_idx) {
+    const size_t slot = cp_idx / INDEX_STRIDE;
+    if (slot >= offsets.size()) return n;
+    size_t i = offsets[slot];
+    for (size_t remaining = cp_idx % INDEX_STRIDE; remaining > 0 && i < n; --remaining) {
+        ++i;
+        while (i < n && is_continuation(static_cast<unsigned char>(s[i]))) ++i;
+    }
+    return i;
+}
+
+// 把码点 cp 编码为 UTF-8 追加到 out
+inline void append_code_point(std::string& out, const uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+} // namespace deps::utf8
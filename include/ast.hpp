@@ -15,14 +15,15 @@ namespace kiz {
 
 enum class AstType {
     // 表达式类型（对应 Expression 子类）
-    StringExpr, NumberExpr, ListExpr, IdentifierExpr,
+    StringExpr, NumberExpr, ListExpr, TupleExpr, IdentifierExpr,
     BinaryExpr, UnaryExpr,
     CallExpr,
     GetMemberExpr, SetMemberExpr, GetItemExpr, SetItemExpr,
-    FuncDeclExpr, DictDeclExpr,
+    FuncDeclExpr, DictDeclExpr, StructDeclExpr,
+    AwaitExpr,
 
     // 语句类型（对应 Statement 子类）
-    AssignStmt, NonlocalAssignStmt, GlobalAssignStmt,
+    AssignStmt, UnpackAssignStmt, NonlocalAssignStmt, GlobalAssignStmt,
     BlockStmt, IfStmt, WhileStmt,
     ReturnStmt, ImportStmt,
     NullStmt, ExprStmt,
@@ -87,6 +88,16 @@ struct ListExpr final :  Expression {
     }
 };
 
+// 元组字面量 (a, b) / return a, b / x = a, b
+struct TupleExpr final :  Expression {
+    std::vector<std::unique_ptr<Expression>> elements;
+    explicit TupleExpr(std::vector<std::unique_ptr<Expression>> elems)
+        : elements(std::move(elems)) {
+        this->ast_type = AstType::TupleExpr;
+        this->type_info = std::make_unique<TypeInfo>("tuple");
+    }
+};
+
 // 标识符
 struct IdentifierExpr final :  Expression {
     std::string name;
@@ -129,6 +140,16 @@ struct AssignStmt final :  Statement {
     }
 };
 
+// 解包赋值 a, b = expr
+struct UnpackAssignStmt final :  Statement {
+    std::vector<std::string> names;
+    std::unique_ptr<Expression> expr;
+    UnpackAssignStmt(std::vector<std::string> n, std::unique_ptr<Expression> e)
+        : names(std::move(n)), expr(std::move(e)) {
+        this->ast_type = AstType::UnpackAssignStmt;
+    }
+};
+
 // nonlocal赋值
 struct NonlocalAssignStmt final :  Statement {
     std::string name;
@@ -211,10 +232,11 @@ struct SetMemberExpr final :  Expression {
     }
 };
 
-// 获取项
+// 获取项（is_slice 为 true 时 params 为 [start, stop]，缺省边界为 nullptr）
 struct GetItemExpr final :  Expression {
     std::unique_ptr<Expression> father;
     std::vector<std::unique_ptr<Expression>> params;
+    bool is_slice = false;
     GetItemExpr(std::unique_ptr<Expression> f, std::vector<std::unique_ptr<Expression>> p)
         : father(std::move(f)), params(std::move(p)) {
         this->ast_type = AstType::GetItemExpr;
@@ -222,11 +244,23 @@ struct GetItemExpr final :  Expression {
     }
 };
 
+// 设置项
+struct SetItemExpr final :  Expression {
+    std::unique_ptr<Expression> g_item;
+    std::unique_ptr<Expression> val;
+    SetItemExpr(std::unique_ptr<Expression> g_item, std::unique_ptr<Expression> val)
+        : g_item(std::move(g_item)), val(std::move(val)) {
+        this->ast_type = AstType::SetItemExpr;
+        this->type_info = std::make_unique<TypeInfo>("set_item_expr");
+    }
+};
+
 // 声明匿名函数
 struct FnDeclExpr final :  Expression {
     std::string name;
     std::vector<std::string> params;
     std::unique_ptr<BlockStmt> body;
+    bool is_async = false;  // async fn：调用时返回协程，函数体内可以 await
     FnDeclExpr(std::string n, std::vector<std::string> p, std::unique_ptr<BlockStmt> b)
         : name(std::move(n)), params(std::move(p)), body(std::move(b)) {
         this->ast_type = AstType::FuncDeclExpr;
@@ -245,6 +279,27 @@ struct DictDeclExpr final :  Expression {
     }
 };
 
+// 声明结构体（字段在编译期确定）
+struct StructDeclExpr final :  Expression {
+    std::string name;
+    std::vector<std::string> fields;
+    StructDeclExpr(std::string n, std::vector<std::string> f)
+        : name(std::move(n)), fields(std::move(f)) {
+        this->ast_type = AstType::StructDeclExpr;
+        this->type_info = std::make_unique<TypeInfo>("struct");
+    }
+};
+
+// await 表达式：挂起当前协程，直到 operand（协程或 Future）完成，值为其结果
+struct AwaitExpr final :  Expression {
+    std::unique_ptr<Expression> operand;
+    explicit AwaitExpr(std::unique_ptr<Expression> e)
+        : operand(std::move(e)) {
+        this->ast_type = AstType::AwaitExpr;
+        this->type_info = std::make_unique<TypeInfo>("await_expr");
+    }
+};
+
 // return 语句
 struct ReturnStmt final :  Statement {
     std::unique_ptr<Expression> expr;
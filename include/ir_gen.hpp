@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <stack>
+#include <unordered_map>
 #include <vector>
 
 
@@ -25,6 +26,10 @@ class IRGenerator {
     std::vector<Instruction> curr_code_list;
     std::vector<model::Object*> curr_consts;
     std::vector<std::tuple<size_t, size_t>> curr_lineno_map;
+    bool in_async = false;  // 正在生成 async fn 的函数体（只有其中允许 await）
+
+    // 已声明结构体的字段名 → 下标；同名字段在不同结构体中下标不同时记为 StructType::npos
+    std::unordered_map<std::string, size_t> field_slots;
 
     const std::string& file_path;
 public:
@@ -47,6 +52,7 @@ public:
     void gen_literal(Expression* expr);
     void gen_fn_call(CallExpr* expr);
     void gen_dict(DictDeclExpr* expr);
+    void gen_struct(const StructDeclExpr* expr);
     void gen_expr(Expression* expr);
 
     void gen_if(IfStmt* if_stmt);
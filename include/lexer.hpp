@@ -18,8 +18,8 @@ namespace kiz {
 // Token 类型与结构体
 enum class TokenType {
     // 关键字
-    Var, Func, If, Else, While, Return, Import, Break, Dict,
-    True, False, Null, End, Next, Nonlocal, Global,
+    Var, Func, If, Else, While, Return, Import, Break, Dict, Struct,
+    True, False, Null, End, Next, Nonlocal, Global, Async, Await,
     // 标识符
     Identifier,
     // 赋值运算符
@@ -28,7 +28,7 @@ enum class TokenType {
     Number, String,
     // 分隔符
     LParen, RParen, LBrace, RBrace, LBracket, RBracket,
-    Comma, Dot, TripleDot, Semicolon,
+    Comma, Dot, TripleDot, Semicolon, Colon,
     // 运算符
     ExclamationMark, Plus, Minus, Star, Slash, Backslash,
     Percent, Caret, Bang, Equal, NotEqual,
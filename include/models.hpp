@@ -7,9 +7,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <charconv>
+#include <cstdint>
 #include <functional>
 #include <iomanip>
+#include <limits>
+#include <memory>
+#include <string_view>
 #include <utility>
 
 #include "kiz.hpp" // 不能删 !!!
@@ -17,6 +23,9 @@
 #include "../deps/hashmap.hpp"
 #include "../deps/bigint.hpp"
 #include "../deps/rational.hpp"
+#include "../deps/utf8.hpp"
+#include "../deps/open_table.hpp"
+#include "../deps/rrb_vector.hpp"
 
 namespace kiz {
 
@@ -57,7 +66,10 @@ public:
     enum class ObjectType {
         OT_Object, OT_Nil, OT_Bool, OT_Int, OT_Rational, OT_String,
         OT_List, OT_Dictionary, OT_CodeObject, OT_Function,
-        OT_CppFunction, OT_Module
+        OT_CppFunction, OT_Module, OT_Array, OT_Matrix,
+        OT_StringBuilder, OT_Set, OT_Iterator, OT_Tuple,
+        OT_StructType, OT_Struct, OT_File, OT_Bytes,
+        OT_Channel, OT_Future, OT_Coroutine
     };
 
     // 获取实际类型的虚函数
@@ -75,11 +87,26 @@ public:
             delete this;
         }
     }
+    // 放弃一个引用但不释放对象：已持有引用的对象回到新建时的 0 引用状态，
+    // 用于 CppFunction 返回（调用方会再 make_ref）
+    void drop_ref() {
+        refc_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    // 注册表持有的对象（内置方法等）：引用计数放到远离 0 的位置，
+    // 调用路径上成对或不成对的 make_ref / del_ref 都不会释放它
+    void make_immortal() {
+        refc_.store(std::numeric_limits<size_t>::max() / 2, std::memory_order_relaxed);
+    }
 
     [[nodiscard]] virtual std::string to_string() const {
         return "<Object at " + ptr_to_string(this) + ">";
     }
 
+    // 把表示直接追加到 out（print 与容器的 to_string 使用），容器逐个元素写入，不产生中间字符串
+    virtual void append_repr(std::string& out) const {
+        out += to_string();
+    }
+
     virtual ~Object() {
         auto kv_list = attrs.to_vector();
         for (auto& [key, obj] : kv_list) {
@@ -88,15 +115,30 @@ public:
     }
 };
 
-inline auto based_obj = new Object();
-inline auto based_list = new Object();
-inline auto based_function = new Object();
-inline auto based_dict = new Object();
-inline auto based_int = new Object();
-inline auto based_rational = new Object();
-inline auto based_bool = new Object();
-inline auto based_nil = new Object();
-inline auto based_str = new Object();
+// 类型对象被每个实例的 __parent__ 引用，但 attrs.insert 不计引用，实例析构时却会释放它：设为常驻
+inline Object* make_based_object() {
+    auto* obj = new Object();
+    obj->make_immortal();
+    return obj;
+}
+
+inline auto based_obj = make_based_object();
+inline auto based_list = make_based_object();
+inline auto based_function = make_based_object();
+inline auto based_dict = make_based_object();
+inline auto based_int = make_based_object();
+inline auto based_rational = make_based_object();
+inline auto based_bool = make_based_object();
+inline auto based_nil = make_based_object();
+inline auto based_str = make_based_object();
+inline auto based_str_builder = make_based_object();
+inline auto based_set = make_based_object();
+inline auto based_iterator = make_based_object();
+inline auto based_tuple = make_based_object();
+inline auto based_bytes = make_based_object();
+inline auto based_channel = make_based_object();
+inline auto based_future = make_based_object();
+inline auto based_coroutine = make_based_object();
 
 
 class List;
@@ -134,13 +176,13 @@ class Module : public Object {
 public:
     std::string name;
     CodeObject *code = nullptr;
-    deps::HashMap<Object*> attrs;
 
     static constexpr ObjectType TYPE = ObjectType::OT_Module;
     [[nodiscard]] ObjectType get_type() const override { return TYPE; }
 
     explicit Module(std::string name, CodeObject *code) : name(std::move(name)), code(code) {
-        code->make_ref();
+        // std模块由 C++ 构造，没有对应的 CodeObject
+        if (this->code != nullptr) this->code->make_ref();
     }
 
     [[nodiscard]] std::string to_string() const override {
@@ -153,6 +195,7 @@ public:
     std::string name;
     CodeObject *code = nullptr;
     size_t argc = 0;
+    bool is_async = false;  // async fn：调用时不执行函数体，返回协程
 
     static constexpr ObjectType TYPE = ObjectType::OT_Function;
     [[nodiscard]] ObjectType get_type() const override { return TYPE; }
@@ -172,11 +215,18 @@ class CppFunction : public Object {
 public:
     std::string name;
     std::function<Object*(Object*, List*)> func;
+    // 纯函数：只读参数、只创建新对象，不回调 VM 也不碰共享的可变状态，parallel 可在工作线程中直接调用
+    bool pure = false;
 
     static constexpr ObjectType TYPE = ObjectType::OT_CppFunction;
     [[nodiscard]] ObjectType get_type() const override { return TYPE; }
 
-    explicit CppFunction(std::function<Object*(Object*, List*)> func) : func(std::move(func)) {}
+    // CppFunction 只在注册时创建（builtins / 各类型与模块的 attrs），注册表不计引用，
+    // 而 get_attr 取出的方法有的调用路径 make_ref 后释放、有的直接释放，因此构造即设为常驻
+    explicit CppFunction(std::function<Object*(Object*, List*)> func, const bool pure = false)
+        : func(std::move(func)), pure(pure) {
+        make_immortal();
+    }
     [[nodiscard]] std::string to_string() const override {
     return "<CppFunction" + 
            (name.empty() 
@@ -189,7 +239,15 @@ public:
 
 class List : public Object {
 public:
+    // 扁平表示（persistent 为假时有效）：可原地修改
     std::vector<Object*> val;
+    // 持久化表示（persistent 为真时有效，此时 val 为空）：拼接 / 切片 / appended / updated
+    // 产生的 List 与来源共享 RRB 树节点；原地修改前先 flat() 转回扁平表示
+    deps::RrbVector<Object*> pvec;
+    bool persistent = false;
+
+    // 结果不超过该长度时直接复制成扁平 List，复制比建树更便宜
+    static constexpr size_t persistent_threshold = 32;
 
     static constexpr ObjectType TYPE = ObjectType::OT_List;
     [[nodiscard]] ObjectType get_type() const override { return TYPE; }
@@ -197,21 +255,232 @@ public:
     explicit List(std::vector<Object*> val) : val(std::move(val)) {
         attrs.insert("__parent__", based_list);
     }
+    // 以持久化表示构造（不提供同名构造函数：避免 List({}) 产生歧义）
+    static List* from_shared(deps::RrbVector<Object*> pvec) {
+        const auto list = new List(std::vector<Object*>{});
+        list->pvec = std::move(pvec);
+        list->persistent = !list->pvec.empty();
+        return list;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return persistent ? pvec.size() : val.size();
+    }
+
+    [[nodiscard]] Object* at(const size_t i) const {
+        return persistent ? pvec.get(i) : val[i];
+    }
+
+    // 转为扁平表示并返回 val（树节点可能仍被其他 List 共享，所以逐个 make_ref）
+    std::vector<Object*>& flat() {
+        if (persistent) {
+            val = pvec.to_vector();
+            for (Object* elem : val) elem->make_ref();
+            pvec = {};
+            persistent = false;
+        }
+        return val;
+    }
+    // 只读访问同样需要连续数组时使用（只切换表示，不改变逻辑值）
+    const std::vector<Object*>& flat() const {
+        return const_cast<List*>(this)->flat();
+    }
+
+    // 取持久化视图：扁平 List 按 O(n) 建树（树持有元素引用），不改变自身表示
+    [[nodiscard]] deps::RrbVector<Object*> shared() const {
+        if (persistent) return pvec;
+        for (Object* elem : val) elem->make_ref();
+        return deps::RrbVector<Object*>::from_vector(val);
+    }
+
+    // 区间 [begin, end) 的新 List：来源已是持久化表示且结果较长时共享结构，否则复制
+    [[nodiscard]] List* slice(const size_t begin, const size_t end) const {
+        if (persistent && end - begin > persistent_threshold) {
+            return from_shared(pvec.slice(begin, end));
+        }
+        std::vector<Object*> new_vals;
+        new_vals.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            Object* elem = at(i);
+            elem->make_ref();
+            new_vals.push_back(elem);
+        }
+        return new List(std::move(new_vals));
+    }
+
     [[nodiscard]] std::string to_string() const override {
-        std::string result = "[";
-        for (size_t i = 0; i < val.size(); ++i) {
-            if (val[i] != nullptr) {
-                result += val[i]->to_string();  // 递归调用元素的 to_string
+        std::string result;
+        append_repr(result);
+        return result;
+    }
+
+    void append_repr(std::string& out) const override {
+        out += '[';
+        bool first = true;
+        const auto append_elem = [&](const Object* elem) {
+            if (!first) out += ", ";
+            first = false;
+            if (elem != nullptr) {
+                elem->append_repr(out);  // 递归写入元素
             } else {
-                result += "Nil";
+                out += "Nil";
             }
-            if (i != val.size() - 1) {
-                result += ", ";
+        };
+        if (persistent) {
+            pvec.for_each(append_elem);
+        } else {
+            for (const Object* elem : val) append_elem(elem);
+        }
+        out += ']';
+    }
+};
+
+// 不可变元组：元素个数创建后固定，不超过 inline_capacity 个时直接存放在对象内，不另行分配
+class Tuple : public Object {
+public:
+    static constexpr size_t inline_capacity = 4;
+
+private:
+    Object* inline_[inline_capacity] = {};
+    std::unique_ptr<Object*[]> heap_;
+    size_t size_ = 0;
+
+public:
+    static constexpr ObjectType TYPE = ObjectType::OT_Tuple;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    // 接管 elems 中每个元素的引用（与 List 构造函数一致）
+    Tuple(Object* const* elems, const size_t n) : size_(n) {
+        attrs.insert("__parent__", based_tuple);
+        Object** dst = inline_;
+        if (n > inline_capacity) {
+            heap_ = std::make_unique<Object*[]>(n);
+            dst = heap_.get();
+        }
+        std::copy(elems, elems + n, dst);
+    }
+    explicit Tuple(const std::vector<Object*>& elems) : Tuple(elems.data(), elems.size()) {}
+
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    [[nodiscard]] Object* const* data() const {
+        return heap_ ? heap_.get() : inline_;
+    }
+
+    [[nodiscard]] Object* at(const size_t i) const {
+        return data()[i];
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        std::string result;
+        append_repr(result);
+        return result;
+    }
+
+    void append_repr(std::string& out) const override {
+        out += '(';
+        for (size_t i = 0; i < size_; ++i) {
+            if (i != 0) out += ", ";
+            if (at(i) != nullptr) {
+                at(i)->append_repr(out);
+            } else {
+                out += "Nil";
             }
         }
-        result += "]";
+        if (size_ == 1) out += ',';
+        out += ')';
+    }
+
+    ~Tuple() override {
+        for (size_t i = 0; i < size_; ++i) {
+            if (at(i) != nullptr) at(i)->del_ref();
+        }
+    }
+};
+
+// 结构体类型：字段在声明时确定，实例按字段下标（slot）存放字段值
+class StructType : public Object {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    std::string name;
+    std::vector<std::string> fields;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_StructType;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    StructType(std::string name, std::vector<std::string> fields)
+        : name(std::move(name)), fields(std::move(fields)) {
+        attrs.insert("__parent__", based_obj);
+    }
+
+    // 字段名 → 下标（字段通常很少，线性查找比哈希更快），不存在返回 npos
+    [[nodiscard]] size_t slot_of(const std::string& field) const {
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i] == field) return i;
+        }
+        return npos;
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return "<struct " + name + ">";
+    }
+};
+
+// 结构体实例：只有类型指针与定长 slot 数组，attrs 保持为空（不分配桶）；
+// 找不到的属性（方法等）沿类型对象查找
+class Struct : public Object {
+public:
+    StructType* type;
+    std::unique_ptr<Object*[]> slots;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Struct;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    explicit Struct(StructType* type)
+        : type(type), slots(std::make_unique<Object*[]>(type->fields.size())) {
+        type->make_ref();
+    }
+
+    [[nodiscard]] size_t size() const {
+        return type->fields.size();
+    }
+
+    // GET_SLOT / SET_SLOT 的守卫：编译期算出的下标确实对应同名字段
+    [[nodiscard]] bool has_field_at(const size_t slot, const std::string& field) const {
+        return slot < size() && type->fields[slot] == field;
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        std::string result;
+        append_repr(result);
         return result;
     }
+
+    void append_repr(std::string& out) const override {
+        out += type->name;
+        out += '(';
+        for (size_t i = 0; i < size(); ++i) {
+            if (i != 0) out += ", ";
+            out += type->fields[i];
+            out += '=';
+            if (slots[i] != nullptr) {
+                slots[i]->append_repr(out);
+            } else {
+                out += "Nil";
+            }
+        }
+        out += ')';
+    }
+
+    ~Struct() override {
+        for (size_t i = 0; i < size(); ++i) {
+            if (slots[i] != nullptr) slots[i]->del_ref();
+        }
+        type->del_ref();
+    }
 };
 
 class Int : public Object {
@@ -230,6 +499,17 @@ public:
     [[nodiscard]] std::string to_string() const override {
         return val.to_string();
     }
+
+    // 机器整数范围内直接格式化进 out
+    void append_repr(std::string& out) const override {
+        if (!val.fits_long_long()) {
+            out += val.to_string();
+            return;
+        }
+        char digits[24];
+        const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), val.to_long_long());
+        out.append(digits, end);
+    }
 };
 
 class Rational : public Object {
@@ -245,11 +525,49 @@ public:
     [[nodiscard]] std::string to_string() const override {
         return val.numerator.to_string() + "/" + val.denominator.to_string();
     }
+
+    void append_repr(std::string& out) const override {
+        out += val.numerator.to_string();
+        out += '/';
+        out += val.denominator.to_string();
+    }
 };
 
+// 短字符串（libstdc++ 为 15 字节以内）由 std::string 的 SSO 内联存储，不额外分配堆内存
+// 惰性缓存（哈希、码点索引）以原子方式发布：多个线程可同时读取同一 String（通道传递、parallel 工作线程）
 class String : public Object {
+    mutable std::atomic<size_t> hash_ = 0;
+    mutable std::atomic<bool> hash_cached_ = false;
+
+    // UTF-8 码点信息（首次按码点访问时构建）
+    struct Utf8Info {
+        bool byte_mode = true;        // 纯 ASCII（或非法 UTF-8，按字节处理）：一个字节即一个字符
+        size_t cp_count = 0;          // 码点总数
+        std::vector<size_t> offsets;  // 稀疏偏移索引，见 deps::utf8::build_index
+    };
+    mutable std::atomic<Utf8Info*> utf8_ = nullptr;
+
+    const Utf8Info& utf8() const {
+        if (const Utf8Info* cached = utf8_.load(std::memory_order_acquire)) return *cached;
+        auto info = std::make_unique<Utf8Info>();
+        const char* data = val.data();
+        if (deps::utf8::is_ascii(data, val.size()) || !deps::utf8::validate(data, val.size())) {
+            info->cp_count = val.size();
+        } else {
+            info->byte_mode = false;
+            info->cp_count = deps::utf8::build_index(data, val.size(), info->offsets);
+        }
+        // 多个线程同时构建时只保留先发布的一份
+        Utf8Info* expected = nullptr;
+        if (utf8_.compare_exchange_strong(expected, info.get(), std::memory_order_acq_rel)) {
+            return *info.release();
+        }
+        return *expected;
+    }
 public:
     std::string val;
+    // 是否为驻留字符串：内容相同的驻留字符串是同一个对象，可按指针比较
+    bool interned = false;
 
     static constexpr ObjectType TYPE = ObjectType::OT_String;
     [[nodiscard]] ObjectType get_type() const override { return TYPE; }
@@ -257,42 +575,318 @@ public:
     explicit String(std::string val) : val(std::move(val)) {
         attrs.insert("__parent__", based_str);
     }
+    // 已知哈希值时直接写入缓存
+    explicit String(std::string val, const size_t hash) : hash_(hash), hash_cached_(true), val(std::move(val)) {
+        attrs.insert("__parent__", based_str);
+    }
     [[nodiscard]] std::string to_string() const override {
         return "\"" + val + "\"";
     }
+
+    void append_repr(std::string& out) const override {
+        out += '"';
+        out += val;
+        out += '"';
+    }
+
+    // 哈希值（首次使用时计算并缓存；String 创建后 val 不应再被修改）
+    [[nodiscard]] size_t hash() const {
+        if (!hash_cached_.load(std::memory_order_acquire)) {
+            hash_.store(deps::hash_string(val), std::memory_order_relaxed);
+            hash_cached_.store(true, std::memory_order_release);
+        }
+        return hash_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] bool hash_cached() const { return hash_cached_.load(std::memory_order_acquire); }
+
+    // 码点个数（纯 ASCII 时即字节数）
+    [[nodiscard]] size_t cp_len() const { return utf8().cp_count; }
+    [[nodiscard]] bool is_byte_mode() const { return utf8().byte_mode; }
+
+    // 第 cp 个码点的字节偏移（cp == cp_len() 时为 val.size()）
+    [[nodiscard]] size_t cp_offset(const size_t cp) const {
+        const Utf8Info& info = utf8();
+        if (info.byte_mode) return cp;
+        return deps::utf8::offset_of(val.data(), val.size(), info.offsets, cp);
+    }
+
+    // 码点区间 [begin, end) 对应的子串
+    [[nodiscard]] std::string cp_substr(const size_t begin, const size_t end) const {
+        const size_t byte_begin = cp_offset(begin);
+        size_t byte_end = byte_begin;
+        if (is_byte_mode()) {
+            byte_end = end;
+        } else {
+            // 从起点向后走 end - begin 个码点，避免再查一次索引
+            for (size_t remaining = end - begin; remaining > 0 && byte_end < val.size(); --remaining) {
+                ++byte_end;
+                while (byte_end < val.size() && deps::utf8::is_continuation(static_cast<unsigned char>(val[byte_end]))) {
+                    ++byte_end;
+                }
+            }
+        }
+        return val.substr(byte_begin, byte_end - byte_begin);
+    }
+
+    ~String() override {
+        delete utf8_.load(std::memory_order_relaxed);
+    }
+};
+
+// 字符串驻留表：驻留表持有每个驻留字符串的一个引用，驻留字符串永不释放
+inline deps::HashMap<String*> interned_strings;
+
+// 获取内容为 s 的驻留字符串（不存在则创建）
+inline String* intern_string(const std::string& s) {
+    const size_t hash = deps::hash_string(s);
+    if (const auto node = interned_strings.find_in_current(s, hash)) {
+        return node->value;
+    }
+    const auto str_obj = new String(s, hash);
+    str_obj->interned = true;
+    str_obj->make_ref();
+    interned_strings.insert(s, str_obj, hash);
+    return str_obj;
+}
+
+// 可变字符串缓冲区：append 为均摊 O(1)，用于替代循环中的 s = s + piece
+class StringBuilder : public Object {
+public:
+    std::string buf;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_StringBuilder;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    explicit StringBuilder(std::string init = "") : buf(std::move(init)) {
+        attrs.insert("__parent__", based_str_builder);
+    }
+    [[nodiscard]] std::string to_string() const override {
+        return "<StringBuilder: len=" + std::to_string(buf.size()) + " at " + ptr_to_string(this) + ">";
+    }
+};
+
+// 字节序列：视图 [data_, data_ + size_) 指向 owner_ 持有的缓冲。
+// 切片与 memoryview 一样共享缓冲、不复制；bytes 只读，bytearray 长度固定、可按下标写入，
+// 写入对共享同一缓冲的其他切片可见
+class Bytes : public Object {
+    std::shared_ptr<void> owner_;
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    mutable std::atomic<size_t> hash_ = 0;
+    mutable std::atomic<bool> hash_cached_ = false;
+
+public:
+    bool writable;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Bytes;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    // 新建 n 个 0 字节
+    Bytes(const size_t n, const bool writable) : size_(n), writable(writable) {
+        attrs.insert("__parent__", based_bytes);
+        auto buf = std::make_shared<uint8_t[]>(std::max<size_t>(n, 1));
+        data_ = buf.get();
+        owner_ = std::move(buf);
+    }
+    // 复制 content
+    Bytes(const std::string_view content, const bool writable) : Bytes(content.size(), writable) {
+        std::copy(content.begin(), content.end(), data_);
+    }
+    // 共享 owner 持有的缓冲（切片、内存映射文件）
+    Bytes(std::shared_ptr<void> owner, const uint8_t* data, const size_t n, const bool writable)
+        : owner_(std::move(owner)), data_(const_cast<uint8_t*>(data)), size_(n), writable(writable) {
+        attrs.insert("__parent__", based_bytes);
+    }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] const uint8_t* data() const { return data_; }
+    [[nodiscard]] uint8_t* mutable_data() {
+        assert(writable && "bytes 只读，不能修改");
+        return data_;
+    }
+    [[nodiscard]] std::string_view view() const {
+        return {reinterpret_cast<const char*>(data_), size_};
+    }
+
+    // 子区间 [begin, end) 的零拷贝视图
+    [[nodiscard]] Bytes* slice(const size_t begin, const size_t end) const {
+        return new Bytes(owner_, data_ + begin, end - begin, writable);
+    }
+
+    // 只读字节序列内容不变，哈希值可缓存
+    [[nodiscard]] size_t hash() const {
+        if (!hash_cached_.load(std::memory_order_acquire)) {
+            hash_.store(deps::hash_string(view()), std::memory_order_relaxed);
+            hash_cached_.store(true, std::memory_order_release);
+        }
+        return hash_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        std::string result;
+        append_repr(result);
+        return result;
+    }
+
+    // b"..."：可打印 ASCII 原样输出，其余字节写成 \xNN
+    void append_repr(std::string& out) const override {
+        static constexpr char hex_digits[] = "0123456789abcdef";
+        out += writable ? "bytearray(b\"" : "b\"";
+        for (size_t i = 0; i < size_; ++i) {
+            const uint8_t c = data_[i];
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += static_cast<char>(c);
+            } else if (c >= 0x20 && c < 0x7f) {
+                out += static_cast<char>(c);
+            } else {
+                out += "\\x";
+                out += hex_digits[c >> 4];
+                out += hex_digits[c & 0xf];
+            }
+        }
+        out += writable ? "\")" : "\"";
+    }
 };
 
+// 原生哈希协议：Int / Rational / String / Bool / Nil 按值哈希与比较，其他不可变对象按身份
+inline bool is_hashable(const Object* obj);
+inline size_t hash_object(const Object* obj);
+inline bool objects_equal(const Object* a, const Object* b);
+
+struct ObjectKeyTraits {
+    static size_t hash(Object* const& key) {
+        return hash_object(key);
+    }
+    static bool equal(Object* const& a, Object* const& b) {
+        return objects_equal(a, b);
+    }
+};
+
+// 以对象为键的开放寻址表（键与值均持有引用）
+using ObjectTable = deps::OpenTable<Object*, Object*, ObjectKeyTraits>;
+
 class Dictionary : public Object {
 public:
+    // String 键仍存于 attrs（使用缓存哈希）；其余可哈希键存于 items
+    ObjectTable items;
 
     static constexpr ObjectType TYPE = ObjectType::OT_Dictionary;
     [[nodiscard]] ObjectType get_type() const override { return TYPE; }
 
+    // 形如 __xxx__ 的 String 键会与 attrs 中的 __parent__ / 魔术方法冲突，改存于 items
+    static bool is_reserved_key(const std::string_view key) {
+        return key.size() >= 4 && key.starts_with("__") && key.ends_with("__");
+    }
+
     explicit Dictionary(const deps::HashMap<Object*>& attrs_input){
         attrs = attrs_input;
         attrs.insert("__parent__", based_dict);
     }
     explicit Dictionary() {
         attrs.insert("__parent__", based_dict);
-        attrs = deps::HashMap<Object*>{};
     }
 
     [[nodiscard]] std::string to_string() const override {
-        std::string result = "{";
-        auto kv_list = attrs.to_vector();
-        for (size_t i = 0; i < kv_list.size(); ++i) {
-            auto& [key, val] = kv_list[i];
-
-            std::string val_str = (val != nullptr) ? val->to_string() : "nil";
+        std::string result;
+        append_repr(result);
+        return result;
+    }
 
-            result += key + ": " + val_str;
-            if (i != kv_list.size() - 1) {
-                result += ", ";
+    void append_repr(std::string& out) const override {
+        out += '{';
+        bool first = true;
+        const auto append_val = [&out](const Object* val) {
+            if (val != nullptr) {
+                val->append_repr(out);
+            } else {
+                out += "nil";
             }
-        }
-        result += "}";
+        };
+        attrs.for_each([&](const std::string& key, const Object* val) {
+            if (is_reserved_key(key)) return;  // __parent__
+            if (!first) out += ", ";
+            first = false;
+            out += key;
+            out += ": ";
+            append_val(val);
+        });
+        items.for_each([&](const Object* key, const Object* val) {
+            if (!first) out += ", ";
+            first = false;
+            key->append_repr(out);
+            out += ": ";
+            append_val(val);
+        });
+        out += '}';
+    }
+
+    ~Dictionary() override {
+        items.for_each([](Object* key, Object* val) {
+            key->del_ref();
+            if (val != nullptr) val->del_ref();
+        });
+    }
+};
+
+// 集合：开放寻址表存放可哈希元素，成员判断与去重为 O(1)
+class Set : public Object {
+public:
+    deps::OpenTable<Object*, deps::Unit, ObjectKeyTraits> val;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Set;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    explicit Set() {
+        attrs.insert("__parent__", based_set);
+    }
+
+    // 加入元素（已存在则忽略），返回是否为新元素
+    bool add(Object* elem) {
+        assert(is_hashable(elem) && "Set 元素必须可哈希");
+        if (!val.emplace(elem).second) return false;
+        elem->make_ref();
+        return true;
+    }
+
+    // 移除元素，返回是否存在
+    bool remove(Object* elem) {
+        Object* old_elem = nullptr;
+        if (!val.erase(elem, &old_elem)) return false;
+        old_elem->del_ref();
+        return true;
+    }
+
+    [[nodiscard]] bool contains(Object* elem) const {
+        return is_hashable(elem) && val.contains(elem);
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        std::string result;
+        append_repr(result);
         return result;
     }
+
+    void append_repr(std::string& out) const override {
+        if (val.size() == 0) {
+            out += "set()";
+            return;
+        }
+        out += '{';
+        bool first = true;
+        val.for_each([&](const Object* elem, const deps::Unit&) {
+            if (!first) out += ", ";
+            first = false;
+            elem->append_repr(out);
+        });
+        out += '}';
+    }
+
+    ~Set() override {
+        val.for_each([](Object* elem, const deps::Unit&) {
+            elem->del_ref();
+        });
+    }
 };
 
 class Bool : public Object {
@@ -308,6 +902,10 @@ public:
     [[nodiscard]] std::string to_string() const override {
         return val ? "True" : "False";
     }
+
+    void append_repr(std::string& out) const override {
+        out += val ? "True" : "False";
+    }
 };
 
 class Nil : public Object {
@@ -322,8 +920,176 @@ public:
     [[nodiscard]] std::string to_string() const override {
         return "Nil";
     }
+
+    void append_repr(std::string& out) const override {
+        out += "Nil";
+    }
+};
+
+// Future：尚未就绪的结果（定时器、I/O、gather、协程都用它表示），await 会挂起直到其完成。
+// 完成时按注册顺序调用回调；事件循环、gather、timeout 与协程的唤醒都建立在回调上
+class Future : public Object {
+    std::vector<std::function<void()>> callbacks_;
+
+public:
+    bool done = false;
+    Object* result = nullptr;  // 完成后有效（持有引用）
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Future;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    Future() {
+        attrs.insert("__parent__", based_future);
+    }
+
+    // 已完成时立即调用 cb
+    void add_done_callback(std::function<void()> cb) {
+        if (done) cb();
+        else callbacks_.push_back(std::move(cb));
+    }
+
+    void resolve(Object* value) {
+        assert(!done && "Future 只能完成一次");
+        if (value == nullptr) value = new Nil();
+        value->make_ref();
+        result = value;
+        done = true;
+        // 回调中可能再注册回调或释放其他 Future，先取出再调用
+        const auto callbacks = std::move(callbacks_);
+        for (const auto& cb : callbacks) cb();
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return std::string("<Future: ") + (done ? "done" : "pending") + " at " + ptr_to_string(this) + ">";
+    }
+
+    ~Future() override {
+        if (result != nullptr) result->del_ref();
+    }
 };
 
+inline bool is_hashable(const Object* obj) {
+    if (obj == nullptr) return false;
+    switch (obj->get_type()) {
+        case Object::ObjectType::OT_List:
+        case Object::ObjectType::OT_Dictionary:
+        case Object::ObjectType::OT_Set:
+        case Object::ObjectType::OT_StringBuilder:
+        case Object::ObjectType::OT_Array:
+        case Object::ObjectType::OT_Matrix:
+            return false;  // 可变容器不可作为键
+        case Object::ObjectType::OT_Bytes:
+            return !static_cast<const Bytes*>(obj)->writable;
+        case Object::ObjectType::OT_Tuple: {
+            // 元组可哈希当且仅当所有元素可哈希
+            const auto tuple = static_cast<const Tuple*>(obj);
+            for (size_t i = 0; i < tuple->size(); ++i) {
+                if (!is_hashable(tuple->at(i))) return false;
+            }
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
+inline size_t hash_object(const Object* obj) {
+    switch (obj->get_type()) {
+        case Object::ObjectType::OT_Int:
+            return static_cast<const Int*>(obj)->val.hash();
+        case Object::ObjectType::OT_Rational: {
+            const auto& r = static_cast<const Rational*>(obj)->val;
+            return r.numerator.hash() * 31 ^ r.denominator.hash();
+        }
+        case Object::ObjectType::OT_String:
+            return static_cast<const String*>(obj)->hash();
+        case Object::ObjectType::OT_Bytes:
+            return static_cast<const Bytes*>(obj)->hash();
+        case Object::ObjectType::OT_Bool:
+            return static_cast<const Bool*>(obj)->val ? 0x51ed27 : 0x2c1b3c6d;
+        case Object::ObjectType::OT_Nil:
+            return 0x6e696c;
+        case Object::ObjectType::OT_Tuple: {
+            // 按顺序组合元素哈希（boost::hash_combine）
+            const auto tuple = static_cast<const Tuple*>(obj);
+            size_t h = 0x7475706cULL ^ tuple->size();
+            for (size_t i = 0; i < tuple->size(); ++i) {
+                h ^= hash_object(tuple->at(i)) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+            }
+            return h;
+        }
+        default: {
+            // 按身份哈希（地址低位因对齐恒为 0，先移掉）
+            const auto addr = reinterpret_cast<uintptr_t>(obj);
+            return static_cast<size_t>((addr >> 4) * 0x9e3779b97f4a7c15ULL);
+        }
+    }
+}
+
+inline bool objects_equal(const Object* a, const Object* b) {
+    if (a == b) return true;
+    if (a == nullptr || b == nullptr || a->get_type() != b->get_type()) return false;
+    switch (a->get_type()) {
+        case Object::ObjectType::OT_Int:
+            return static_cast<const Int*>(a)->val == static_cast<const Int*>(b)->val;
+        case Object::ObjectType::OT_Rational: {
+            const auto& ra = static_cast<const Rational*>(a)->val;
+            const auto& rb = static_cast<const Rational*>(b)->val;
+            return ra.numerator == rb.numerator && ra.denominator == rb.denominator;
+        }
+        case Object::ObjectType::OT_String: {
+            const auto sa = static_cast<const String*>(a);
+            const auto sb = static_cast<const String*>(b);
+            if (sa->interned && sb->interned) return false;
+            return sa->hash() == sb->hash() && sa->val == sb->val;
+        }
+        case Object::ObjectType::OT_Bytes:
+            return static_cast<const Bytes*>(a)->view() == static_cast<const Bytes*>(b)->view();
+        case Object::ObjectType::OT_Bool:
+            return static_cast<const Bool*>(a)->val == static_cast<const Bool*>(b)->val;
+        case Object::ObjectType::OT_Nil:
+            return true;
+        case Object::ObjectType::OT_Tuple: {
+            const auto ta = static_cast<const Tuple*>(a);
+            const auto tb = static_cast<const Tuple*>(b);
+            if (ta->size() != tb->size()) return false;
+            for (size_t i = 0; i < ta->size(); ++i) {
+                if (!objects_equal(ta->at(i), tb->at(i))) return false;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// 工具函数：将 Int 下标规范化为 [0, len) 的机器整数（支持负数下标，越界断言报错）
+inline size_t normalize_index(const deps::BigInt& idx, const size_t len) {
+    assert(idx.fits_long_long() && "下标超出范围");
+    long long i = idx.to_long_long();
+    if (i < 0) i += static_cast<long long>(len);
+    assert(i >= 0 && static_cast<size_t>(i) < len && "下标超出范围");
+    return static_cast<size_t>(i);
+}
+
+// 工具函数：将切片边界 [start, stop) 规范化并裁剪到 [0, len]（Nil 表示缺省边界）
+inline std::pair<size_t, size_t> normalize_slice(const Object* start, const Object* stop, const size_t len) {
+    const auto clamp_bound = [len](const Object* bound, const size_t default_val) -> size_t {
+        if (bound == nullptr || bound->get_type() == Object::ObjectType::OT_Nil) return default_val;
+        const auto bound_int = dynamic_cast<const Int*>(bound);
+        assert(bound_int != nullptr && "切片边界必须是 Int 或 Nil");
+        long long i = bound_int->val.fits_long_long()
+            ? bound_int->val.to_long_long()
+            : (bound_int->val < deps::BigInt(0) ? -static_cast<long long>(len) : static_cast<long long>(len));
+        if (i < 0) i += static_cast<long long>(len);
+        if (i < 0) return 0;
+        return std::min(static_cast<size_t>(i), len);
+    };
+    const size_t begin = clamp_bound(start, 0);
+    const size_t end = clamp_bound(stop, len);
+    return {begin, std::max(begin, end)};
+}
+
 inline deps::HashMap<Object*> std_modules;
 
 void registering_std_modules();
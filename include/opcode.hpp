@@ -15,12 +15,15 @@ enum class Opcode {
     OP_EQ, OP_GT, OP_LT,
     OP_AND, OP_NOT, OP_OR,
     OP_IS, OP_IN,
-    CALL, RET,
+    CALL, RET, RET_MULTI, AWAIT,
     GET_ATTR, SET_ATTR, CALL_METHOD,
+    GET_SLOT, SET_SLOT,
+    GET_ITEM, SET_ITEM, GET_SLICE,
     LOAD_VAR, LOAD_CONST,
     SET_GLOBAL, SET_LOCAL, SET_NONLOCAL,
+    IMPORT,
     JUMP, JUMP_IF_FALSE, THROW, 
-    MAKE_LIST, MAKE_DICT,
+    MAKE_LIST, MAKE_DICT, MAKE_TUPLE, UNPACK_SEQ,
     POP_TOP, SWAP, COPY_TOP, STOP
 };
 
@@ -50,11 +53,20 @@ inline std::string opcode_to_string(Opcode opc) {
         // 函数调用/返回
         case Opcode::CALL:        return "CALL";
         case Opcode::RET:         return "RET";
+        case Opcode::RET_MULTI:   return "RET_MULTI";
+        case Opcode::AWAIT:       return "AWAIT";
 
         // 属性操作
         case Opcode::GET_ATTR:    return "GET_ATTR";
         case Opcode::SET_ATTR:    return "SET_ATTR";
         case Opcode::CALL_METHOD: return "CALL_METHOD";
+        case Opcode::GET_SLOT:    return "GET_SLOT";
+        case Opcode::SET_SLOT:    return "SET_SLOT";
+
+        // 下标/切片操作
+        case Opcode::GET_ITEM:    return "GET_ITEM";
+        case Opcode::SET_ITEM:    return "SET_ITEM";
+        case Opcode::GET_SLICE:   return "GET_SLICE";
 
         // 变量加载/存储
         case Opcode::LOAD_VAR:    return "LOAD_VAR";
@@ -63,6 +75,9 @@ inline std::string opcode_to_string(Opcode opc) {
         case Opcode::SET_LOCAL:   return "SET_LOCAL";
         case Opcode::SET_NONLOCAL:return "SET_NONLOCAL";
 
+        // 模块导入
+        case Opcode::IMPORT:      return "IMPORT";
+
         // 流程控制
         case Opcode::JUMP:        return "JUMP";
         case Opcode::JUMP_IF_FALSE: return "JUMP_IF_FALSE";
@@ -71,6 +86,8 @@ inline std::string opcode_to_string(Opcode opc) {
         // 容器创建
         case Opcode::MAKE_LIST:   return "MAKE_LIST";
         case Opcode::MAKE_DICT:   return "MAKE_DICT";
+        case Opcode::MAKE_TUPLE:  return "MAKE_TUPLE";
+        case Opcode::UNPACK_SEQ:  return "UNPACK_SEQ";
 
         // 栈操作
         case Opcode::POP_TOP:     return "POP_TOP";
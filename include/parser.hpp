@@ -37,6 +37,7 @@ private:
 
     // parse expr
     std::unique_ptr<Expression> parse_expression();
+    std::unique_ptr<Expression> parse_expr_or_tuple();
     std::unique_ptr<Expression> parse_and_or();
     std::unique_ptr<Expression> parse_comparison();
     std::unique_ptr<Expression> parse_add_sub();
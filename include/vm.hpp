@@ -9,6 +9,8 @@
 
 #include "../deps/hashmap.hpp"
 
+#include <deque>
+#include <functional>
 #include <stack>
 #include <tuple>
 
@@ -34,6 +36,37 @@ struct CallFrame {
     model::CodeObject* code_object;
     std::vector<std::tuple<size_t, size_t>> curr_lineno_map;
     std::vector<std::string> names;
+    bool boxed_return = false;  // 由 Vm::invoke 压入：返回值交给 C++，多值返回不能留在栈上
+};
+
+// 协程：调用 async fn 得到的 Future。调用时只建好调用帧，被 await / gather / run 启动后由调度器运行；
+// 在 AWAIT 处挂起时把调用帧与操作数栈上属于自己的值移出 VM，等待的对象完成后再放回继续执行
+class Coroutine : public model::Future {
+public:
+    enum class State { Created, Ready, Running, Suspended };
+
+    State state = State::Created;
+    std::unique_ptr<CallFrame> frame;
+    std::vector<model::Object*> saved_stack;  // 挂起时的操作数栈片段（自底向上，持有引用）
+    size_t stack_base = 0;                    // 运行时操作数栈上属于本协程的起始位置
+    model::Future* awaiting = nullptr;        // 挂起时等待的对象（持有引用）
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Coroutine;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    explicit Coroutine(std::unique_ptr<CallFrame> frame) : frame(std::move(frame)) {
+        attrs.insert("__parent__", model::based_coroutine);
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return "<Coroutine: name='" + (frame ? frame->name : std::string("?")) + "'"
+               + (done ? ", done" : "") + " at " + model::ptr_to_string(this) + ">";
+    }
+
+    ~Coroutine() override {
+        for (model::Object* obj : saved_stack) obj->del_ref();
+        if (awaiting != nullptr) awaiting->del_ref();
+    }
 };
 
 class Vm {
@@ -41,8 +74,13 @@ class Vm {
     static model::Module* main_module;
     static std::stack<model::Object *> op_stack_;
     static std::vector<std::unique_ptr<CallFrame>> call_stack_;
+    // 当前栈顶调用帧的常量表（LOAD_CONST 使用），每次切换栈顶帧时同步
+    static std::vector<model::Object*> constant_pool_;
     static bool running_;
     static const std::string& file_path;
+    // 协程调度：就绪队列（每项持有一个引用）与正在运行的协程（resume 可以嵌套）
+    static std::deque<Coroutine*> ready_;
+    static std::vector<Coroutine*> running_coroutines_;
 public:
     static deps::HashMap<model::Object*> builtins;
 
@@ -56,6 +94,9 @@ public:
     static std::tuple<model::Object*, model::Object*> fetch_two_from_stack_top(const std::string& curr_instruction_name);
     static model::Object* get_attr(const model::Object* obj, const std::string& attr);
     static void call_function(model::Object* func_obj, model::Object* args_obj, model::Object* self);
+    static model::Object* invoke(model::Object* func_obj, model::List* args, model::Object* self = nullptr);
+    static void start(model::Future* future);
+    static model::Object* run_until_complete(model::Future* future);
 
 private:
     void exec_ADD(const Instruction& instruction);
@@ -74,16 +115,29 @@ private:
     void exec_IS(const Instruction& instruction);
     void exec_IN(const Instruction& instruction);
     void exec_MAKE_LIST(const Instruction& instruction);
+    void exec_MAKE_TUPLE(const Instruction& instruction);
+    void exec_MAKE_DICT(const Instruction& instruction);
+    void exec_UNPACK_SEQ(const Instruction& instruction);
     void exec_CALL(const Instruction& instruction);
     void exec_RET(const Instruction& instruction);
+    void exec_RET_MULTI(const Instruction& instruction);
+    void exec_AWAIT(const Instruction& instruction);
+    static void resume(Coroutine* coro);
+    static void run_until_depth(size_t base_depth, const std::function<bool()>& should_pause = {});
     void exec_GET_ATTR(const Instruction& instruction);
     void exec_SET_ATTR(const Instruction& instruction);
     void exec_CALL_METHOD(const Instruction& instruction);
+    void exec_GET_SLOT(const Instruction& instruction);
+    void exec_SET_SLOT(const Instruction& instruction);
+    void exec_GET_ITEM(const Instruction& instruction);
+    void exec_SET_ITEM(const Instruction& instruction);
+    void exec_GET_SLICE(const Instruction& instruction);
     void exec_LOAD_VAR(const Instruction& instruction);
     void exec_LOAD_CONST(const Instruction& instruction);
     void exec_SET_GLOBAL(const Instruction& instruction);
     void exec_SET_LOCAL(const Instruction& instruction);
     void exec_SET_NONLOCAL(const Instruction& instruction);
+    void exec_IMPORT(const Instruction& instruction);
     void exec_JUMP(const Instruction& instruction);
     void exec_JUMP_IF_FALSE(const Instruction& instruction);
     void exec_THROW(const Instruction& instruction);
@@ -0,0 +1,451 @@
+/**
+ * @file kiz_aio.hpp
+ * @brief aio 标准库模块：事件循环上的非阻塞 I/O（文件 / FIFO / 管道 / Unix 域套接字）
+ * 读写方法返回 Future，在 async fn 中 await。每个操作先直接尝试一次系统调用，
+ * 遇到 EAGAIN 才向事件循环登记 fd 就绪通知、就绪后重试，多个协程的等待因此在同一线程里重叠。
+ * 普通文件不支持就绪通知，对它的读写总是立即完成
+ * @author azhz1107cat
+ * @date 2025-12-27
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../../include/models.hpp"
+#include "../../deps/event_loop.hpp"
+#include "../builtins/builtin_methods/bytes_obj.hpp"
+
+namespace aio_lib {
+
+constexpr size_t read_chunk = 64 * 1024;
+// Unix 域套接字的监听队列已满时，隔多久重试 connect
+constexpr auto connect_retry = std::chrono::milliseconds(1);
+
+inline auto based_stream = new model::Object();
+inline auto based_listener = new model::Object();
+
+inline void set_nonblocking(const int fd) {
+    const int flags = fcntl(fd, F_GETFL);
+    const int ok = flags >= 0 ? fcntl(fd, F_SETFL, flags | O_NONBLOCK) : -1;
+    assert(ok == 0 && "aio: 无法设置非阻塞模式");
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+// 持有一个非阻塞 fd；读、写两个方向各自同时只允许一个未完成的操作
+class Pollable : public model::Object {
+protected:
+    int fd_;
+    model::Future* pending_[2] = {nullptr, nullptr};  // [0] 读方向，[1] 写方向（持有引用）
+
+    // 尝试完成一次操作：完成时返回结果，需要等 fd 就绪时返回 nullptr
+    using Step = std::function<model::Object*()>;
+
+    // 先直接尝试；未完成则登记就绪通知，就绪后重试
+    model::Future* submit(const bool writable, Step step) {
+        assert(fd_ >= 0 && "aio: 已关闭");
+        assert(pending_[writable] == nullptr && "aio: 同一方向上已有未完成的操作");
+        auto* future = new model::Future();
+        if (model::Object* result = step()) {
+            future->resolve(result);
+            return future;
+        }
+        future->make_ref();
+        pending_[writable] = future;
+        wait(writable, std::move(step));
+        return future;
+    }
+
+    void wait(const bool writable, Step step) {
+        // 回调只在 fd 仍打开时触发（close 会 unwatch），不会访问已释放的对象
+        const bool ok = deps::EventLoop::instance().watch(fd_, writable, [this, writable, step] {
+            model::Object* result = step();
+            if (result == nullptr) {
+                wait(writable, step);
+                return;
+            }
+            model::Future* future = pending_[writable];
+            pending_[writable] = nullptr;
+            future->resolve(result);
+            future->del_ref();
+        });
+        assert(ok && "aio: fd 不支持就绪通知");
+    }
+
+public:
+    explicit Pollable(const int fd) : fd_(fd) {}
+
+    [[nodiscard]] bool is_closed() const { return fd_ < 0; }
+
+    // 关闭 fd；未完成的操作以 Nil 结束，等待它们的协程得以继续
+    virtual void close() {
+        if (fd_ < 0) return;
+        deps::EventLoop::instance().unwatch(fd_);
+        ::close(fd_);
+        fd_ = -1;
+        for (model::Future*& future : pending_) {
+            if (future == nullptr) continue;
+            model::Future* pending = future;
+            future = nullptr;
+            pending->resolve(nullptr);
+            pending->del_ref();
+        }
+    }
+
+    ~Pollable() override {
+        Pollable::close();
+    }
+};
+
+// 字节流：read / readline / write
+class Stream : public Pollable {
+    // [rpos_, rbuf_.size()) 为 readline 多读入、尚未取走的数据
+    std::string rbuf_;
+    size_t rpos_ = 0;
+
+    static bool would_block() {
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+
+    void consume(const size_t n) {
+        rpos_ += n;
+        if (rpos_ == rbuf_.size()) {
+            rbuf_.clear();
+            rpos_ = 0;
+        } else if (rpos_ >= read_chunk) {
+            rbuf_.erase(0, rpos_);
+            rpos_ = 0;
+        }
+    }
+
+public:
+    std::string name;
+
+    Stream(const int fd, std::string name) : Pollable(fd), name(std::move(name)) {
+        attrs.insert("__parent__", based_stream);
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return "<aio.Stream: '" + name + "'" + (is_closed() ? ", closed" : "") + " at " + model::ptr_to_string(this) + ">";
+    }
+
+    // 读取至多 n 个字节；文件末尾 / 对端关闭时为空 bytes
+    model::Future* read(const size_t n) {
+        return submit(false, [this, n]() -> model::Object* {
+            if (rpos_ < rbuf_.size()) {
+                const size_t take = std::min(n, rbuf_.size() - rpos_);
+                auto* bytes = new model::Bytes(std::string_view(rbuf_).substr(rpos_, take), false);
+                consume(take);
+                return bytes;
+            }
+            std::string chunk(n, '\0');
+            for (;;) {
+                const ssize_t got = ::read(fd_, chunk.data(), n);
+                if (got >= 0) return new model::Bytes(std::string_view(chunk.data(), static_cast<size_t>(got)), false);
+                if (would_block()) return nullptr;
+                assert(errno == EINTR && "aio: read 失败");
+            }
+        });
+    }
+
+    // 读取一行（不含行尾的 \n 或 \r\n）；文件末尾为 Nil
+    model::Future* readline() {
+        return submit(false, [this]() -> model::Object* {
+            for (;;) {
+                const size_t nl = rbuf_.find('\n', rpos_);
+                if (nl != std::string::npos) {
+                    size_t len = nl - rpos_;
+                    if (len > 0 && rbuf_[nl - 1] == '\r') --len;
+                    auto* line = new model::String(rbuf_.substr(rpos_, len));
+                    consume(nl + 1 - rpos_);
+                    return line;
+                }
+                const size_t old_size = rbuf_.size();
+                rbuf_.resize(old_size + read_chunk);
+                const ssize_t got = ::read(fd_, rbuf_.data() + old_size, read_chunk);
+                rbuf_.resize(old_size + (got > 0 ? static_cast<size_t>(got) : 0));
+                if (got > 0) continue;
+                if (got == 0) {
+                    // 最后一行没有换行符
+                    if (rpos_ == rbuf_.size()) return new model::Nil();
+                    auto* line = new model::String(rbuf_.substr(rpos_));
+                    consume(rbuf_.size() - rpos_);
+                    return line;
+                }
+                if (would_block()) return nullptr;
+                assert(errno == EINTR && "aio: read 失败");
+            }
+        });
+    }
+
+    // 写入全部内容，结果为写入的字节数；对端已关闭时为实际写入的部分
+    model::Future* write(const std::string_view content) {
+        auto data = std::make_shared<std::string>(content);
+        auto written = std::make_shared<size_t>(0);
+        return submit(true, [this, data, written]() -> model::Object* {
+            while (*written < data->size()) {
+                const ssize_t got = ::write(fd_, data->data() + *written, data->size() - *written);
+                if (got >= 0) {
+                    *written += static_cast<size_t>(got);
+                    continue;
+                }
+                if (would_block()) return nullptr;
+                if (errno == EPIPE) break;
+                assert(errno == EINTR && "aio: write 失败");
+            }
+            return new model::Int(deps::BigInt::from_long_long(static_cast<long long>(*written)));
+        });
+    }
+};
+
+// Unix 域套接字监听端：accept 得到 Stream
+class Listener : public Pollable {
+public:
+    std::string path;
+
+    Listener(const int fd, std::string path) : Pollable(fd), path(std::move(path)) {
+        attrs.insert("__parent__", based_listener);
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return "<aio.Listener: '" + path + "'" + (is_closed() ? ", closed" : "") + " at " + model::ptr_to_string(this) + ">";
+    }
+
+    model::Future* accept() {
+        return submit(false, [this]() -> model::Object* {
+            for (;;) {
+                const int conn = ::accept(fd_, nullptr, nullptr);
+                if (conn >= 0) {
+                    set_nonblocking(conn);
+                    return new Stream(conn, path);
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) return nullptr;
+                assert(errno == EINTR && "aio: accept 失败");
+            }
+        });
+    }
+
+    // 关闭时删除 listen 创建的套接字文件
+    void close() override {
+        if (is_closed()) return;
+        Pollable::close();
+        ::unlink(path.c_str());
+    }
+
+    ~Listener() override {
+        Listener::close();
+    }
+};
+
+inline sockaddr_un unix_address(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    assert(path.size() < sizeof(addr.sun_path) && "aio: 套接字路径过长");
+    std::memcpy(addr.sun_path, path.data(), path.size());
+    return addr;
+}
+
+// 发起连接；能立即连上时直接完成 future，否则由重试定时器或就绪回调持有 future 直到连接建立。
+// 监听队列已满（EAGAIN）时稍后重试，连接中（EINPROGRESS）时等 fd 可写
+inline void connect_unix(const std::string& path, model::Future* future) {
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    assert(fd >= 0 && "aio.connect: 无法创建套接字");
+    set_nonblocking(fd);
+    const sockaddr_un addr = unix_address(path);
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0) {
+        future->resolve(new Stream(fd, path));
+        return;
+    }
+    auto& loop = deps::EventLoop::instance();
+    future->make_ref();
+    if (errno == EAGAIN) {
+        ::close(fd);
+        loop.call_later(connect_retry, [path, future] {
+            connect_unix(path, future);
+            future->del_ref();
+        });
+        return;
+    }
+    assert(errno == EINPROGRESS && "aio.connect: 无法连接");
+    loop.watch(fd, true, [fd, path, future] {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        assert(err == 0 && "aio.connect: 无法连接");
+        future->resolve(new Stream(fd, path));
+        future->del_ref();
+    });
+}
+
+inline Stream* get_stream(model::Object* self, const char* msg) {
+    const auto stream = dynamic_cast<Stream*>(self);
+    assert(stream != nullptr && msg);
+    return stream;
+}
+
+inline std::string get_path_arg(const model::Object* obj, const char* msg) {
+    const auto path_obj = dynamic_cast<const model::String*>(obj);
+    assert(path_obj != nullptr && msg);
+    return path_obj->val;
+}
+
+// ========================= Stream / Listener 方法 =========================
+// Stream.read([n])：读取至多 n 个字节（默认 64KiB）为 bytes，末尾为空 bytes
+inline auto stream_read = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (stream_read)");
+    assert(args->val.size() <= 1 && "function Stream.read need 0 or 1 arg");
+    const size_t n = args->val.empty()
+        ? read_chunk
+        : model::get_size_arg(args->val[0], "Stream.read: n 必须是非负整数");
+    return get_stream(self, "stream_read must be called by Stream object")->read(n);
+};
+
+// Stream.readline()：读取一行（不含换行符），末尾为 Nil
+inline auto stream_readline = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (stream_readline)");
+    assert(args->val.empty() && "function Stream.readline need 0 arg");
+    return get_stream(self, "stream_readline must be called by Stream object")->readline();
+};
+
+// Stream.write(s)：写入字符串或 bytes，结果为写入的字节数
+inline auto stream_write = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (stream_write)");
+    assert(args->val.size() == 1 && "function Stream.write need 1 arg");
+    std::string_view content;
+    if (const auto str_obj = dynamic_cast<const model::String*>(args->val[0])) {
+        content = str_obj->val;
+    } else if (const auto bytes_obj = dynamic_cast<const model::Bytes*>(args->val[0])) {
+        content = bytes_obj->view();
+    } else {
+        assert(false && "Stream.write only supports String or Bytes type argument");
+    }
+    return get_stream(self, "stream_write must be called by Stream object")->write(content);
+};
+
+// Listener.accept()：等待下一个连接，结果为 Stream
+inline auto listener_accept = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (listener_accept)");
+    assert(args->val.empty() && "function Listener.accept need 0 arg");
+    const auto listener = dynamic_cast<Listener*>(self);
+    assert(listener != nullptr && "listener_accept must be called by Listener object");
+    return listener->accept();
+};
+
+// Stream.close() / Listener.close()（重复关闭无副作用）
+inline auto pollable_close = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (pollable_close)");
+    assert(args->val.empty() && "function close need 0 arg");
+    const auto pollable = dynamic_cast<Pollable*>(self);
+    assert(pollable != nullptr && "close must be called by Stream or Listener object");
+    pollable->close();
+    return new model::Nil();
+};
+
+// ========================= 模块函数 =========================
+// aio.open(path[, mode])：以非阻塞方式打开文件或 FIFO，mode 为 r（默认）/ w / a
+inline auto open = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (aio.open)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function aio.open need 1 or 2 args: (path[, mode])");
+    const std::string path = get_path_arg(args->val[0], "aio.open: path 必须是字符串");
+    int flags = O_RDONLY;
+    if (args->val.size() == 2) {
+        const std::string mode = get_path_arg(args->val[1], "aio.open: mode 必须是字符串");
+        if (mode == "w") flags = O_WRONLY | O_CREAT | O_TRUNC;
+        else if (mode == "a") flags = O_WRONLY | O_CREAT | O_APPEND;
+        else assert(mode == "r" && "aio.open: 未知的打开方式（可选 r/w/a）");
+    }
+    // 只写打开还没有读端的 FIFO 会失败（ENXIO）
+    const int fd = ::open(path.c_str(), flags | O_NONBLOCK | O_CLOEXEC, 0644);
+    assert(fd >= 0 && "aio.open: 无法打开文件");
+    return new Stream(fd, path);
+};
+
+// aio.pipe()：(读端, 写端)
+inline auto pipe = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (aio.pipe)");
+    assert(args->val.empty() && "function aio.pipe need 0 arg");
+    int fds[2];
+    const int ok = ::pipe(fds);
+    assert(ok == 0 && "aio.pipe: 无法创建管道");
+    set_nonblocking(fds[0]);
+    set_nonblocking(fds[1]);
+    model::Object* ends[2] = {new Stream(fds[0], "<pipe:r>"), new Stream(fds[1], "<pipe:w>")};
+    ends[0]->make_ref();
+    ends[1]->make_ref();
+    return new model::Tuple(ends, 2);
+};
+
+// aio.connect(path)：连接 Unix 域套接字，结果为 Stream
+inline auto connect = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (aio.connect)");
+    assert(args->val.size() == 1 && "function aio.connect need 1 arg");
+    auto* future = new model::Future();
+    connect_unix(get_path_arg(args->val[0], "aio.connect: path 必须是字符串"), future);
+    return future;
+};
+
+// aio.listen(path[, backlog])：在 path 上监听 Unix 域套接字
+inline auto listen = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (aio.listen)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function aio.listen need 1 or 2 args: (path[, backlog])");
+    const std::string path = get_path_arg(args->val[0], "aio.listen: path 必须是字符串");
+    const size_t backlog = args->val.size() == 2
+        ? model::get_size_arg(args->val[1], "aio.listen: backlog 必须是非负整数")
+        : 128;
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    assert(fd >= 0 && "aio.listen: 无法创建套接字");
+    set_nonblocking(fd);
+    const sockaddr_un addr = unix_address(path);
+    const int bound = ::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    assert(bound == 0 && "aio.listen: 无法绑定（路径已存在？）");
+    const int listening = ::listen(fd, static_cast<int>(backlog));
+    assert(listening == 0 && "aio.listen: listen 失败");
+    return new Listener(fd, path);
+};
+
+inline void register_stream_methods() {
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+
+    using model::CppFunction;
+    based_stream->attrs.insert("__parent__", model::based_obj);
+    based_stream->attrs.insert("read", new CppFunction(stream_read));
+    based_stream->attrs.insert("readline", new CppFunction(stream_readline));
+    based_stream->attrs.insert("write", new CppFunction(stream_write));
+    based_stream->attrs.insert("close", new CppFunction(pollable_close));
+    based_listener->attrs.insert("__parent__", model::based_obj);
+    based_listener->attrs.insert("accept", new CppFunction(listener_accept));
+    based_listener->attrs.insert("close", new CppFunction(pollable_close));
+}
+
+inline auto __init_module__ = [](model::Object* self, const model::List* args) -> model::Object* {
+    register_stream_methods();
+    // 向已关闭的管道 / 套接字写入时由 write 得到 EPIPE，而不是让解释器被 SIGPIPE 终止
+    std::signal(SIGPIPE, SIG_IGN);
+
+    auto mod = new model::Module(
+        "aio",
+        nullptr
+    );
+
+    mod->attrs.insert("open", new model::CppFunction(open));
+    mod->attrs.insert("pipe", new model::CppFunction(pipe));
+    mod->attrs.insert("connect", new model::CppFunction(connect));
+    mod->attrs.insert("listen", new model::CppFunction(listen));
+
+    return mod;
+};
+
+} // namespace aio_lib
@@ -0,0 +1,650 @@
+/**
+ * @file kiz_array.hpp
+ * @brief array 标准库模块：同类型数值数组（f64 / i64 / i32）
+ * 元素以连续的机器数值存储（不装箱为 Int/Rational），逐元素运算、比较和归约走 SIMD 内核
+ * @author azhz1107cat
+ * @date 2025-12-12
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <sstream>
+
+#include "../../include/models.hpp"
+#include "simd_kernels.hpp"
+
+namespace array_lib {
+
+// 元素类型；Bool 为比较运算得到的掩码（每元素 1 字节，0/1）
+enum class DType { F64, I64, I32, Bool };
+
+inline size_t dtype_size(const DType dtype) {
+    switch (dtype) {
+        case DType::F64: return sizeof(double);
+        case DType::I64: return sizeof(int64_t);
+        case DType::I32: return sizeof(int32_t);
+        case DType::Bool: return sizeof(uint8_t);
+    }
+    return 1;
+}
+
+inline std::string dtype_name(const DType dtype) {
+    switch (dtype) {
+        case DType::F64: return "f64";
+        case DType::I64: return "i64";
+        case DType::I32: return "i32";
+        case DType::Bool: return "bool";
+    }
+    return "unknown";
+}
+
+inline DType dtype_from_name(const std::string& name) {
+    if (name == "f64") return DType::F64;
+    if (name == "i64") return DType::I64;
+    if (name == "i32") return DType::I32;
+    if (name == "bool") return DType::Bool;
+    assert(false && "array: 未知的 dtype（可选 f64/i64/i32/bool）");
+    return DType::F64;
+}
+
+// 按 dtype 分发到对应的 C++ 元素类型：f 接收一个该类型的值作为类型标签
+template <typename F>
+decltype(auto) visit_dtype(const DType dtype, F&& f) {
+    switch (dtype) {
+        case DType::F64: return f(double{});
+        case DType::I64: return f(int64_t{});
+        case DType::I32: return f(int32_t{});
+        case DType::Bool: break;
+    }
+    return f(uint8_t{});
+}
+
+// 64 字节对齐的数据缓冲区（对齐到缓存行，便于向量化加载）
+constexpr size_t buffer_alignment = 64;
+
+inline std::shared_ptr<void> alloc_buffer(const size_t bytes) {
+    void* ptr = ::operator new(std::max<size_t>(bytes, 1), std::align_val_t(buffer_alignment));
+    return {ptr, [](void* p) { ::operator delete(p, std::align_val_t(buffer_alignment)); }};
+}
+
+inline auto based_array = new model::Object();
+
+class Array : public model::Object {
+public:
+    DType dtype;
+    size_t length;
+    std::shared_ptr<void> storage;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Array;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    // 新建未初始化的数组
+    explicit Array(const DType dtype, const size_t length)
+        : dtype(dtype), length(length), storage(alloc_buffer(length * dtype_size(dtype))) {
+        attrs.insert("__parent__", based_array);
+    }
+
+    // 共享已有缓冲区（如矩阵展开），不复制数据
+    explicit Array(const DType dtype, const size_t length, std::shared_ptr<void> storage)
+        : dtype(dtype), length(length), storage(std::move(storage)) {
+        attrs.insert("__parent__", based_array);
+    }
+
+    template <typename T>
+    [[nodiscard]] T* data() const { return static_cast<T*>(storage.get()); }
+
+    [[nodiscard]] std::string to_string() const override {
+        // 元素过多时只显示首尾各几个
+        constexpr size_t edge = 6;
+        std::ostringstream oss;
+        oss << "array." << dtype_name(dtype) << "([";
+        visit_dtype(dtype, [&](auto tag) {
+            using T = decltype(tag);
+            const T* d = data<T>();
+            for (size_t i = 0; i < length; ++i) {
+                if (length > edge * 2 && i == edge) {
+                    oss << "..., ";
+                    i = length - edge;
+                }
+                if constexpr (std::is_same_v<T, uint8_t>) oss << (d[i] ? "True" : "False");
+                else if constexpr (std::is_same_v<T, double>) oss << std::setprecision(17) << d[i];
+                else oss << d[i];
+                if (i + 1 != length) oss << ", ";
+            }
+        });
+        oss << "])";
+        return oss.str();
+    }
+};
+
+// ========================= 与 kiz 对象的转换 =========================
+inline double bigint_to_double(const deps::BigInt& val) {
+    if (val.fits_long_long()) return static_cast<double>(val.to_long_long());
+    return std::stod(val.to_string());
+}
+
+inline double obj_to_double(const model::Object* obj) {
+    if (const auto int_obj = dynamic_cast<const model::Int*>(obj)) {
+        return bigint_to_double(int_obj->val);
+    }
+    if (const auto rat_obj = dynamic_cast<const model::Rational*>(obj)) {
+        return bigint_to_double(rat_obj->val.numerator) / bigint_to_double(rat_obj->val.denominator);
+    }
+    if (const auto bool_obj = dynamic_cast<const model::Bool*>(obj)) {
+        return bool_obj->val ? 1.0 : 0.0;
+    }
+    assert(false && "array: 元素必须是 Int、Rational 或 Bool");
+    return 0.0;
+}
+
+inline int64_t obj_to_i64(const model::Object* obj) {
+    if (const auto int_obj = dynamic_cast<const model::Int*>(obj)) {
+        assert(int_obj->val.fits_long_long() && "array: 整数超出 i64 范围");
+        return int_obj->val.to_long_long();
+    }
+    if (const auto bool_obj = dynamic_cast<const model::Bool*>(obj)) {
+        return bool_obj->val ? 1 : 0;
+    }
+    assert(false && "array: 整数数组的元素必须是 Int 或 Bool");
+    return 0;
+}
+
+// double 精确转换为 Rational：x = mantissa * 2^exp，mantissa 为 53 位整数
+inline model::Object* double_to_obj(const double x) {
+    assert(std::isfinite(x) && "array: 结果为 NaN 或无穷大，无法转换为 Rational");
+    if (x == 0.0) return new model::Rational(deps::Rational(deps::BigInt(0)));
+    int exp = 0;
+    const double frac = std::frexp(x, &exp);
+    auto mantissa = static_cast<long long>(std::ldexp(frac, 53));
+    exp -= 53;
+    // 先去掉尾部的 0 比特，使分母尽量小
+    while ((mantissa & 1) == 0 && exp < 0) {
+        mantissa /= 2;
+        ++exp;
+    }
+    deps::BigInt num = deps::BigInt::from_long_long(mantissa);
+    deps::BigInt den(1);
+    const deps::BigInt two(2);
+    if (exp > 0) num = num * two.pow(deps::BigInt(static_cast<size_t>(exp)));
+    else if (exp < 0) den = two.pow(deps::BigInt(static_cast<size_t>(-exp)));
+    return new model::Rational(deps::Rational(num, den));
+}
+
+inline model::Object* i64_to_obj(const int64_t x) {
+    return new model::Int(deps::BigInt::from_long_long(x));
+}
+
+// 取出单个元素并装箱为 kiz 对象
+inline model::Object* element_to_obj(const Array* arr, const size_t i) {
+    switch (arr->dtype) {
+        case DType::F64: return double_to_obj(arr->data<double>()[i]);
+        case DType::I64: return i64_to_obj(arr->data<int64_t>()[i]);
+        case DType::I32: return i64_to_obj(arr->data<int32_t>()[i]);
+        case DType::Bool: return new model::Bool(arr->data<uint8_t>()[i] != 0);
+    }
+    return new model::Nil();
+}
+
+// 将 kiz 对象写入第 i 个元素
+inline void store_element(Array* arr, const size_t i, const model::Object* obj) {
+    switch (arr->dtype) {
+        case DType::F64: arr->data<double>()[i] = obj_to_double(obj); break;
+        case DType::I64: arr->data<int64_t>()[i] = obj_to_i64(obj); break;
+        case DType::I32: {
+            const int64_t v = obj_to_i64(obj);
+            assert(v >= INT32_MIN && v <= INT32_MAX && "array: 整数超出 i32 范围");
+            arr->data<int32_t>()[i] = static_cast<int32_t>(v);
+            break;
+        }
+        case DType::Bool: arr->data<uint8_t>()[i] = obj_to_i64(obj) != 0; break;
+    }
+}
+
+inline Array* from_list(const model::List* list, const DType dtype) {
+    const std::vector<model::Object*>& items = list->flat();
+    const auto arr = new Array(dtype, items.size());
+    for (size_t i = 0; i < items.size(); ++i) store_element(arr, i, items[i]);
+    return arr;
+}
+
+inline model::List* to_list(const Array* arr) {
+    std::vector<model::Object*> vals;
+    vals.reserve(arr->length);
+    for (size_t i = 0; i < arr->length; ++i) {
+        model::Object* elem = element_to_obj(arr, i);
+        elem->make_ref();
+        vals.push_back(elem);
+    }
+    return new model::List(std::move(vals));
+}
+
+// 转换为另一种 dtype（同类型时复制，保证返回新数组）
+inline Array* cast(const Array* src, const DType dtype) {
+    const auto dst = new Array(dtype, src->length);
+    visit_dtype(src->dtype, [&](auto src_tag) {
+        using S = decltype(src_tag);
+        visit_dtype(dtype, [&](auto dst_tag) {
+            using D = decltype(dst_tag);
+            const S* in = src->data<S>();
+            D* out = dst->data<D>();
+            if constexpr (std::is_same_v<S, D>) {
+                std::memcpy(out, in, src->length * sizeof(S));
+            } else {
+                for (size_t i = 0; i < src->length; ++i) out[i] = static_cast<D>(in[i]);
+            }
+        });
+    });
+    return dst;
+}
+
+// ========================= 运算 =========================
+// 两个操作数的结果类型：f64 > i64 > i32，掩码参与算术时按 i32 处理
+inline DType promote(const DType a, const DType b) {
+    if (a == DType::F64 || b == DType::F64) return DType::F64;
+    if (a == DType::I64 || b == DType::I64) return DType::I64;
+    return DType::I32;
+}
+
+// 标量操作数对应的 dtype：Int 按数组的整数类型（放不下 i32 时升到 i64），其余按 f64
+inline DType scalar_dtype(const model::Object* scalar, const DType arr_dtype) {
+    if (const auto int_obj = dynamic_cast<const model::Int*>(scalar)) {
+        if (arr_dtype == DType::F64) return DType::F64;
+        assert(int_obj->val.fits_long_long() && "array: 整数超出 i64 范围");
+        const long long v = int_obj->val.to_long_long();
+        if (arr_dtype != DType::I64 && v >= INT32_MIN && v <= INT32_MAX) return DType::I32;
+        return DType::I64;
+    }
+    return DType::F64;
+}
+
+// 将操作数（Array 或标量）准备为 dtype 类型的数据：返回数据指针与是否为标量
+// 需要类型转换时，转换结果暂存在 holder / scalar_buf 中
+struct Operand {
+    std::unique_ptr<Array, void(*)(Array*)> holder{nullptr, [](Array* a) { delete a; }};
+    alignas(8) unsigned char scalar_buf[8] = {};
+    const void* ptr = nullptr;
+    bool is_scalar = false;
+};
+
+inline void prepare_operand(Operand& operand, const model::Object* obj, const DType dtype) {
+    if (const auto arr = dynamic_cast<const Array*>(obj)) {
+        if (arr->dtype == dtype) {
+            operand.ptr = arr->storage.get();
+        } else {
+            operand.holder.reset(cast(arr, dtype));
+            operand.ptr = operand.holder->storage.get();
+        }
+        return;
+    }
+    operand.is_scalar = true;
+    switch (dtype) {
+        case DType::F64: {
+            const double v = obj_to_double(obj);
+            std::memcpy(operand.scalar_buf, &v, sizeof v);
+            break;
+        }
+        case DType::I64: {
+            const int64_t v = obj_to_i64(obj);
+            std::memcpy(operand.scalar_buf, &v, sizeof v);
+            break;
+        }
+        case DType::I32: {
+            const auto v = static_cast<int32_t>(obj_to_i64(obj));
+            std::memcpy(operand.scalar_buf, &v, sizeof v);
+            break;
+        }
+        case DType::Bool: {
+            const auto v = static_cast<uint8_t>(obj_to_i64(obj) != 0);
+            std::memcpy(operand.scalar_buf, &v, sizeof v);
+            break;
+        }
+    }
+    operand.ptr = operand.scalar_buf;
+}
+
+inline DType result_dtype(const Array* self, const model::Object* other) {
+    if (const auto other_arr = dynamic_cast<const Array*>(other)) {
+        assert(other_arr->length == self->length && "array: 两个数组长度不一致");
+        return promote(self->dtype, other_arr->dtype);
+    }
+    return promote(self->dtype, scalar_dtype(other, self->dtype));
+}
+
+template <simd::BinOp OP>
+inline Array* binary_op(const Array* self, const model::Object* other) {
+    DType dtype = result_dtype(self, other);
+    // 整数除法的结果按 f64 计算
+    if constexpr (OP == simd::BinOp::Div) dtype = DType::F64;
+
+    Operand lhs, rhs;
+    prepare_operand(lhs, self, dtype);
+    prepare_operand(rhs, other, dtype);
+    const auto result = new Array(dtype, self->length);
+    visit_dtype(dtype, [&](auto tag) {
+        using T = decltype(tag);
+        if constexpr (!std::is_same_v<T, uint8_t>) {
+            simd::binary<OP>(static_cast<const T*>(lhs.ptr), static_cast<const T*>(rhs.ptr),
+                rhs.is_scalar, result->data<T>(), self->length);
+        }
+    });
+    return result;
+}
+
+template <simd::CmpOp OP>
+inline Array* compare_op(const Array* self, const model::Object* other) {
+    DType dtype = result_dtype(self, other);
+    Operand lhs, rhs;
+    prepare_operand(lhs, self, dtype);
+    prepare_operand(rhs, other, dtype);
+    const auto result = new Array(DType::Bool, self->length);
+    visit_dtype(dtype, [&](auto tag) {
+        using T = decltype(tag);
+        if constexpr (!std::is_same_v<T, uint8_t>) {
+            simd::compare_to<OP>(static_cast<const T*>(lhs.ptr), static_cast<const T*>(rhs.ptr),
+                rhs.is_scalar, result->data<uint8_t>(), self->length);
+        }
+    });
+    return result;
+}
+
+// 按掩码筛选元素，返回新数组
+inline Array* filter(const Array* self, const Array* mask) {
+    assert(mask->dtype == DType::Bool && "array: 筛选参数必须是比较得到的 bool 数组");
+    assert(mask->length == self->length && "array: 掩码长度与数组长度不一致");
+    const uint8_t* m = mask->data<uint8_t>();
+    const auto result = new Array(self->dtype, simd::count_mask(m, mask->length));
+    visit_dtype(self->dtype, [&](auto tag) {
+        using T = decltype(tag);
+        const T* in = self->data<T>();
+        T* out = result->data<T>();
+        size_t j = 0;
+        for (size_t i = 0; i < self->length; ++i) {
+            // 结果恰好 count_mask 个元素，只在掩码为真时写入，不越界
+            if (m[i]) out[j++] = in[i];
+        }
+    });
+    return result;
+}
+
+inline Array* get_self(model::Object* self, const char* method_name) {
+    const auto arr = dynamic_cast<Array*>(self);
+    if (arr == nullptr) {
+        assert(false && ("array: " + std::string(method_name) + " must be called by Array object").c_str());
+    }
+    return arr;
+}
+
+// ========================= Array 方法 =========================
+#define KIZ_ARRAY_BINARY(fn_name, method, OP) \
+inline auto fn_name = [](model::Object* self, const model::List* args) -> model::Object* { \
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (" #fn_name ")"); \
+    assert(args->val.size() == 1 && "function Array." method " need 1 arg"); \
+    return binary_op<OP>(get_self(self, method), args->val[0]); \
+};
+
+KIZ_ARRAY_BINARY(array_add, "add", simd::BinOp::Add)
+KIZ_ARRAY_BINARY(array_sub, "sub", simd::BinOp::Sub)
+KIZ_ARRAY_BINARY(array_mul, "mul", simd::BinOp::Mul)
+KIZ_ARRAY_BINARY(array_div, "div", simd::BinOp::Div)
+#undef KIZ_ARRAY_BINARY
+
+#define KIZ_ARRAY_COMPARE(fn_name, method, OP) \
+inline auto fn_name = [](model::Object* self, const model::List* args) -> model::Object* { \
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (" #fn_name ")"); \
+    assert(args->val.size() == 1 && "function Array." method " need 1 arg"); \
+    return compare_op<OP>(get_self(self, method), args->val[0]); \
+};
+
+KIZ_ARRAY_COMPARE(array_lt, "lt", simd::CmpOp::Lt)
+KIZ_ARRAY_COMPARE(array_gt, "gt", simd::CmpOp::Gt)
+KIZ_ARRAY_COMPARE(array_eq, "eq", simd::CmpOp::Eq)
+#undef KIZ_ARRAY_COMPARE
+
+// Array.getitem：arr[i] 取元素，arr[mask] 按掩码筛选，arr[a:b] 复制切片
+inline auto array_getitem = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_getitem)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function Array.getitem need 1 or 2 args");
+    const auto arr = get_self(self, "getitem");
+
+    if (args->val.size() == 2) {
+        const auto [begin, end] = model::normalize_slice(args->val[0], args->val[1], arr->length);
+        const auto result = new Array(arr->dtype, end - begin);
+        const size_t elem_size = dtype_size(arr->dtype);
+        std::memcpy(result->storage.get(),
+            static_cast<const char*>(arr->storage.get()) + begin * elem_size,
+            (end - begin) * elem_size);
+        return result;
+    }
+    if (const auto mask = dynamic_cast<const Array*>(args->val[0])) {
+        return filter(arr, mask);
+    }
+    const auto idx = dynamic_cast<const model::Int*>(args->val[0]);
+    assert(idx != nullptr && "Array index must be Int or bool Array");
+    return element_to_obj(arr, model::normalize_index(idx->val, arr->length));
+};
+
+// Array.setitem：arr[i] = x
+inline auto array_setitem = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_setitem)");
+    assert(args->val.size() == 2 && "function Array.setitem need 2 args");
+    const auto arr = get_self(self, "setitem");
+    const auto idx = dynamic_cast<const model::Int*>(args->val[0]);
+    assert(idx != nullptr && "Array index must be Int");
+    store_element(arr, model::normalize_index(idx->val, arr->length), args->val[1]);
+    return new model::Nil();
+};
+
+// Array.sum：求和（整数数组以 i64 累加）
+inline auto array_sum = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_sum)");
+    assert(args->val.empty() && "function Array.sum need 0 arg");
+    const auto arr = get_self(self, "sum");
+    if (arr->dtype == DType::Bool) return i64_to_obj(static_cast<int64_t>(simd::count_mask(arr->data<uint8_t>(), arr->length)));
+    return visit_dtype(arr->dtype, [&](auto tag) -> model::Object* {
+        using T = decltype(tag);
+        if constexpr (std::is_same_v<T, double>) return double_to_obj(simd::sum(arr->data<T>(), arr->length));
+        else return i64_to_obj(static_cast<int64_t>(simd::sum(arr->data<T>(), arr->length)));
+    });
+};
+
+// Array.mean：平均值（整数数组返回精确的 Rational）
+inline auto array_mean = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_mean)");
+    assert(args->val.empty() && "function Array.mean need 0 arg");
+    const auto arr = get_self(self, "mean");
+    assert(arr->length > 0 && "Array.mean of empty array");
+    if (arr->dtype == DType::F64) {
+        return double_to_obj(simd::sum(arr->data<double>(), arr->length) / static_cast<double>(arr->length));
+    }
+    const int64_t total = arr->dtype == DType::Bool
+        ? static_cast<int64_t>(simd::count_mask(arr->data<uint8_t>(), arr->length))
+        : visit_dtype(arr->dtype, [&](auto tag) -> int64_t {
+            using T = decltype(tag);
+            return static_cast<int64_t>(simd::sum(arr->data<T>(), arr->length));
+        });
+    return new model::Rational(deps::Rational(
+        deps::BigInt::from_long_long(total), deps::BigInt(arr->length)
+    ));
+};
+
+template <bool IS_MIN>
+inline model::Object* array_min_max(model::Object* self, const model::List* args, const char* method) {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_" + method + ")");
+    assert(args->val.empty() && "function Array.min/max need 0 arg");
+    const auto arr = get_self(self, method);
+    assert(arr->length > 0 && "Array.min/max of empty array");
+    return visit_dtype(arr->dtype, [&](auto tag) -> model::Object* {
+        using T = decltype(tag);
+        const T v = simd::min_max<IS_MIN>(arr->data<T>(), arr->length);
+        if constexpr (std::is_same_v<T, double>) return double_to_obj(v);
+        else if constexpr (std::is_same_v<T, uint8_t>) return new model::Bool(v != 0);
+        else return i64_to_obj(v);
+    });
+}
+
+// Array.min / Array.max
+inline auto array_min = [](model::Object* self, const model::List* args) -> model::Object* {
+    return array_min_max<true>(self, args, "min");
+};
+inline auto array_max = [](model::Object* self, const model::List* args) -> model::Object* {
+    return array_min_max<false>(self, args, "max");
+};
+
+// Array.dot：点积
+inline auto array_dot = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_dot)");
+    assert(args->val.size() == 1 && "function Array.dot need 1 arg");
+    const auto arr = get_self(self, "dot");
+    const auto other = dynamic_cast<const Array*>(args->val[0]);
+    assert(other != nullptr && "Array.dot only supports Array type argument");
+    const DType dtype = result_dtype(arr, other);
+    Operand lhs, rhs;
+    prepare_operand(lhs, arr, dtype);
+    prepare_operand(rhs, other, dtype);
+    return visit_dtype(dtype, [&](auto tag) -> model::Object* {
+        using T = decltype(tag);
+        const auto v = simd::dot(static_cast<const T*>(lhs.ptr), static_cast<const T*>(rhs.ptr), arr->length);
+        if constexpr (std::is_same_v<T, double>) return double_to_obj(v);
+        else return i64_to_obj(static_cast<int64_t>(v));
+    });
+};
+
+// Array.count：bool 数组中 True 的个数
+inline auto array_count = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_count)");
+    assert(args->val.empty() && "function Array.count need 0 arg");
+    const auto arr = get_self(self, "count");
+    assert(arr->dtype == DType::Bool && "Array.count only supports bool array");
+    return i64_to_obj(static_cast<int64_t>(simd::count_mask(arr->data<uint8_t>(), arr->length)));
+};
+
+// Array.filter：等价于 arr[mask]
+inline auto array_filter = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_filter)");
+    assert(args->val.size() == 1 && "function Array.filter need 1 arg");
+    const auto mask = dynamic_cast<const Array*>(args->val[0]);
+    assert(mask != nullptr && "Array.filter only supports bool Array argument");
+    return filter(get_self(self, "filter"), mask);
+};
+
+// Array.size：元素个数
+inline auto array_size = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_size)");
+    return i64_to_obj(static_cast<int64_t>(get_self(self, "size")->length));
+};
+
+// Array.dtype：元素类型名
+inline auto array_dtype = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_dtype)");
+    return new model::String(dtype_name(get_self(self, "dtype")->dtype));
+};
+
+// Array.astype：转换为另一种 dtype
+inline auto array_astype = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_astype)");
+    assert(args->val.size() == 1 && "function Array.astype need 1 arg");
+    const auto name = dynamic_cast<const model::String*>(args->val[0]);
+    assert(name != nullptr && "Array.astype only supports String type argument");
+    return cast(get_self(self, "astype"), dtype_from_name(name->val));
+};
+
+// Array.to_list：装箱为 List
+inline auto array_to_list = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array_to_list)");
+    return to_list(get_self(self, "to_list"));
+};
+
+// ========================= 模块函数 =========================
+// 构造函数：array.f64(list) / array.f64(n)（n 个 0）
+inline model::Object* make_array(const model::List* args, const DType dtype) {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array." + dtype_name(dtype) + ")");
+    assert(args->val.size() == 1 && "function array.<dtype> need 1 arg");
+    if (const auto list = dynamic_cast<const model::List*>(args->val[0])) {
+        return from_list(list, dtype);
+    }
+    if (const auto src = dynamic_cast<const Array*>(args->val[0])) {
+        return cast(src, dtype);
+    }
+    const auto n = dynamic_cast<const model::Int*>(args->val[0]);
+    assert(n != nullptr && "array.<dtype> only supports List, Array or Int argument");
+    assert(n->val >= deps::BigInt(0) && n->val.fits_long_long() && "array length out of range");
+    const auto arr = new Array(dtype, static_cast<size_t>(n->val.to_long_long()));
+    std::memset(arr->storage.get(), 0, arr->length * dtype_size(dtype));
+    return arr;
+}
+
+// array.arange(n[, dtype])：0, 1, ..., n-1（默认 i64）
+inline auto arange = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (array.arange)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function array.arange need 1 or 2 args");
+    const auto n = dynamic_cast<const model::Int*>(args->val[0]);
+    assert(n != nullptr && n->val >= deps::BigInt(0) && n->val.fits_long_long() && "array.arange need a non-negative Int");
+    DType dtype = DType::I64;
+    if (args->val.size() == 2) {
+        const auto name = dynamic_cast<const model::String*>(args->val[1]);
+        assert(name != nullptr && "array.arange dtype must be String");
+        dtype = dtype_from_name(name->val);
+    }
+    const auto arr = new Array(dtype, static_cast<size_t>(n->val.to_long_long()));
+    visit_dtype(dtype, [&](auto tag) {
+        using T = decltype(tag);
+        T* d = arr->data<T>();
+        for (size_t i = 0; i < arr->length; ++i) d[i] = static_cast<T>(i);
+    });
+    return arr;
+};
+
+// 注册 Array 的方法（其他模块返回 Array 时也会调用，只注册一次）
+inline void register_array_methods() {
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+
+    using model::CppFunction;
+    based_array->attrs.insert("__parent__", model::based_obj);
+    based_array->attrs.insert("__add__", new CppFunction(array_add));
+    based_array->attrs.insert("__sub__", new CppFunction(array_sub));
+    based_array->attrs.insert("__mul__", new CppFunction(array_mul));
+    based_array->attrs.insert("__div__", new CppFunction(array_div));
+    based_array->attrs.insert("__lt__", new CppFunction(array_lt));
+    based_array->attrs.insert("__gt__", new CppFunction(array_gt));
+    based_array->attrs.insert("__eq__", new CppFunction(array_eq));
+    based_array->attrs.insert("__getitem__", new CppFunction(array_getitem));
+    based_array->attrs.insert("__setitem__", new CppFunction(array_setitem));
+    based_array->attrs.insert("sum", new CppFunction(array_sum));
+    based_array->attrs.insert("mean", new CppFunction(array_mean));
+    based_array->attrs.insert("min", new CppFunction(array_min));
+    based_array->attrs.insert("max", new CppFunction(array_max));
+    based_array->attrs.insert("dot", new CppFunction(array_dot));
+    based_array->attrs.insert("count", new CppFunction(array_count));
+    based_array->attrs.insert("filter", new CppFunction(array_filter));
+    based_array->attrs.insert("size", new CppFunction(array_size));
+    based_array->attrs.insert("__len__", new CppFunction(array_size));
+    based_array->attrs.insert("dtype", new CppFunction(array_dtype));
+    based_array->attrs.insert("astype", new CppFunction(array_astype));
+    based_array->attrs.insert("to_list", new CppFunction(array_to_list));
+}
+
+inline auto __init_module__ = [](model::Object* self, const model::List* args) -> model::Object* {
+    register_array_methods();
+
+    auto mod = new model::Module(
+        "array",
+        nullptr
+    );
+
+    mod->attrs.insert("array", based_array);
+    mod->attrs.insert("f64", new model::CppFunction([](model::Object*, const model::List* a) { return make_array(a, DType::F64); }));
+    mod->attrs.insert("i64", new model::CppFunction([](model::Object*, const model::List* a) { return make_array(a, DType::I64); }));
+    mod->attrs.insert("i32", new model::CppFunction([](model::Object*, const model::List* a) { return make_array(a, DType::I32); }));
+    mod->attrs.insert("arange", new model::CppFunction(arange));
+
+    return mod;
+};
+
+} // namespace array_lib
@@ -0,0 +1,424 @@
+/**
+ * @file simd_kernels.hpp
+ * @brief 数值数组（Array）的 SIMD 计算内核
+ * 运行时检测 CPU 指令集，按 AVX2 → SSE2 → 标量 的顺序选择实现
+ * @author azhz1107cat
+ * @date 2025-12-12
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define KIZ_ARCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要按函数开启指令集，MSVC 可直接使用内建函数
+#if defined(KIZ_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define KIZ_TARGET_AVX2 __attribute__((target("avx2")))
+#define KIZ_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define KIZ_TARGET_AVX2
+#define KIZ_TARGET_SSE2
+#endif
+
+namespace array_lib::simd {
+
+enum class Level { Scalar, SSE2, AVX2 };
+enum class BinOp { Add, Sub, Mul, Div };
+enum class CmpOp { Lt, Gt, Eq };
+
+// 检测当前CPU支持的最高指令集等级
+inline Level detect_level() {
+#if defined(KIZ_ARCH_X86)
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+    if (__builtin_cpu_supports("sse2")) return Level::SSE2;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    const bool os_saves_ymm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+    __cpuidex(info, 7, 0);
+    if (os_saves_ymm && (info[1] & (1 << 5))) return Level::AVX2;
+    return Level::SSE2;
+#endif
+#endif
+    return Level::Scalar;
+}
+
+// 进程启动时检测一次
+inline const Level level = detect_level();
+
+// ========================= 标量实现（兜底 + 处理尾部元素） =========================
+template <BinOp OP, typename T>
+inline T apply(const T a, const T b) {
+    if constexpr (OP == BinOp::Add) return a + b;
+    else if constexpr (OP == BinOp::Sub) return a - b;
+    else if constexpr (OP == BinOp::Mul) return a * b;
+    else return a / b;
+}
+
+template <CmpOp OP, typename T>
+inline uint8_t compare(const T a, const T b) {
+    if constexpr (OP == CmpOp::Lt) return a < b;
+    else if constexpr (OP == CmpOp::Gt) return a > b;
+    else return a == b;
+}
+
+template <BinOp OP, typename T>
+inline void binary_scalar(const T* a, const T* b, const bool b_scalar, T* out, const size_t begin, const size_t n) {
+    for (size_t i = begin; i < n; ++i) out[i] = apply<OP>(a[i], b_scalar ? b[0] : b[i]);
+}
+
+template <CmpOp OP, typename T>
+inline void compare_scalar(const T* a, const T* b, const bool b_scalar, uint8_t* out, const size_t begin, const size_t n) {
+    for (size_t i = begin; i < n; ++i) out[i] = compare<OP>(a[i], b_scalar ? b[0] : b[i]);
+}
+
+#if defined(KIZ_ARCH_X86)
+// ========================= f64 内核 =========================
+template <BinOp OP>
+KIZ_TARGET_AVX2 inline __m256d apply_pd256(const __m256d a, const __m256d b) {
+    if constexpr (OP == BinOp::Add) return _mm256_add_pd(a, b);
+    else if constexpr (OP == BinOp::Sub) return _mm256_sub_pd(a, b);
+    else if constexpr (OP == BinOp::Mul) return _mm256_mul_pd(a, b);
+    else return _mm256_div_pd(a, b);
+}
+
+template <BinOp OP>
+KIZ_TARGET_SSE2 inline __m128d apply_pd128(const __m128d a, const __m128d b) {
+    if constexpr (OP == BinOp::Add) return _mm_add_pd(a, b);
+    else if constexpr (OP == BinOp::Sub) return _mm_sub_pd(a, b);
+    else if constexpr (OP == BinOp::Mul) return _mm_mul_pd(a, b);
+    else return _mm_div_pd(a, b);
+}
+
+template <BinOp OP>
+KIZ_TARGET_AVX2 inline void binary_f64_avx2(const double* a, const double* b, const bool b_scalar, double* out, const size_t n) {
+    size_t i = 0;
+    if (b_scalar) {
+        const __m256d vb = _mm256_set1_pd(b[0]);
+        for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, apply_pd256<OP>(_mm256_loadu_pd(a + i), vb));
+    } else {
+        for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, apply_pd256<OP>(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    binary_scalar<OP>(a, b, b_scalar, out, i, n);
+}
+
+template <BinOp OP>
+KIZ_TARGET_SSE2 inline void binary_f64_sse2(const double* a, const double* b, const bool b_scalar, double* out, const size_t n) {
+    size_t i = 0;
+    if (b_scalar) {
+        const __m128d vb = _mm_set1_pd(b[0]);
+        for (; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, apply_pd128<OP>(_mm_loadu_pd(a + i), vb));
+    } else {
+        for (; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, apply_pd128<OP>(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    binary_scalar<OP>(a, b, b_scalar, out, i, n);
+}
+
+template <CmpOp OP>
+KIZ_TARGET_AVX2 inline void compare_f64_avx2(const double* a, const double* b, const bool b_scalar, uint8_t* out, const size_t n) {
+    constexpr int pred = OP == CmpOp::Lt ? _CMP_LT_OQ : (OP == CmpOp::Gt ? _CMP_GT_OQ : _CMP_EQ_OQ);
+    size_t i = 0;
+    const __m256d vs = _mm256_set1_pd(b[0]);
+    for (; i + 4 <= n; i += 4) {
+        const __m256d vb = b_scalar ? vs : _mm256_loadu_pd(b + i);
+        const int bits = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i), vb, pred));
+        for (int k = 0; k < 4; ++k) out[i + k] = static_cast<uint8_t>((bits >> k) & 1);
+    }
+    compare_scalar<OP>(a, b, b_scalar, out, i, n);
+}
+
+KIZ_TARGET_AVX2 inline double hsum_pd256(const __m256d v) {
+    const __m128d lo = _mm256_castpd256_pd128(v);
+    const __m128d hi = _mm256_extractf128_pd(v, 1);
+    const __m128d s = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+KIZ_TARGET_AVX2 inline double sum_f64_avx2(const double* a, const size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(a + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(a + i + 4));
+    }
+    double total = hsum_pd256(_mm256_add_pd(acc0, acc1));
+    for (; i < n; ++i) total += a[i];
+    return total;
+}
+
+KIZ_TARGET_SSE2 inline double sum_f64_sse2(const double* a, const size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) acc = _mm_add_pd(acc, _mm_loadu_pd(a + i));
+    double total = _mm_cvtsd_f64(_mm_add_sd(acc, _mm_unpackhi_pd(acc, acc)));
+    for (; i < n; ++i) total += a[i];
+    return total;
+}
+
+KIZ_TARGET_AVX2 inline double dot_f64_avx2(const double* a, const double* b, const size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+    double total = hsum_pd256(_mm256_add_pd(acc0, acc1));
+    for (; i < n; ++i) total += a[i] * b[i];
+    return total;
+}
+
+KIZ_TARGET_SSE2 inline double dot_f64_sse2(const double* a, const double* b, const size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    double total = _mm_cvtsd_f64(_mm_add_sd(acc, _mm_unpackhi_pd(acc, acc)));
+    for (; i < n; ++i) total += a[i] * b[i];
+    return total;
+}
+
+template <bool IS_MIN>
+KIZ_TARGET_AVX2 inline double minmax_f64_avx2(const double* a, const size_t n) {
+    __m256d acc = _mm256_set1_pd(a[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d v = _mm256_loadu_pd(a + i);
+        acc = IS_MIN ? _mm256_min_pd(acc, v) : _mm256_max_pd(acc, v);
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    double result = lanes[0];
+    for (int k = 1; k < 4; ++k) result = IS_MIN ? std::min(result, lanes[k]) : std::max(result, lanes[k]);
+    for (; i < n; ++i) result = IS_MIN ? std::min(result, a[i]) : std::max(result, a[i]);
+    return result;
+}
+
+// ========================= i64 内核 =========================
+template <BinOp OP>
+KIZ_TARGET_AVX2 inline void binary_i64_avx2(const int64_t* a, const int64_t* b, const bool b_scalar, int64_t* out, const size_t n) {
+    static_assert(OP == BinOp::Add || OP == BinOp::Sub, "AVX2 只提供 i64 加减");
+    size_t i = 0;
+    const __m256i vs = _mm256_set1_epi64x(b[0]);
+    for (; i + 4 <= n; i += 4) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = b_scalar ? vs : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        const __m256i r = OP == BinOp::Add ? _mm256_add_epi64(va, vb) : _mm256_sub_epi64(va, vb);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+    }
+    binary_scalar<OP>(a, b, b_scalar, out, i, n);
+}
+
+KIZ_TARGET_AVX2 inline int64_t sum_i64_avx2(const int64_t* a, const size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) acc = _mm256_add_epi64(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    int64_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i) total += a[i];
+    return total;
+}
+
+template <CmpOp OP>
+KIZ_TARGET_AVX2 inline void compare_i64_avx2(const int64_t* a, const int64_t* b, const bool b_scalar, uint8_t* out, const size_t n) {
+    size_t i = 0;
+    const __m256i vs = _mm256_set1_epi64x(b[0]);
+    for (; i + 4 <= n; i += 4) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = b_scalar ? vs : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i m;
+        if constexpr (OP == CmpOp::Lt) m = _mm256_cmpgt_epi64(vb, va);
+        else if constexpr (OP == CmpOp::Gt) m = _mm256_cmpgt_epi64(va, vb);
+        else m = _mm256_cmpeq_epi64(va, vb);
+        const int bits = _mm256_movemask_pd(_mm256_castsi256_pd(m));
+        for (int k = 0; k < 4; ++k) out[i + k] = static_cast<uint8_t>((bits >> k) & 1);
+    }
+    compare_scalar<OP>(a, b, b_scalar, out, i, n);
+}
+
+// ========================= i32 内核 =========================
+template <BinOp OP>
+KIZ_TARGET_AVX2 inline void binary_i32_avx2(const int32_t* a, const int32_t* b, const bool b_scalar, int32_t* out, const size_t n) {
+    static_assert(OP != BinOp::Div, "AVX2 不提供 i32 除法");
+    size_t i = 0;
+    const __m256i vs = _mm256_set1_epi32(b[0]);
+    for (; i + 8 <= n; i += 8) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = b_scalar ? vs : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i r;
+        if constexpr (OP == BinOp::Add) r = _mm256_add_epi32(va, vb);
+        else if constexpr (OP == BinOp::Sub) r = _mm256_sub_epi32(va, vb);
+        else r = _mm256_mullo_epi32(va, vb);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+    }
+    binary_scalar<OP>(a, b, b_scalar, out, i, n);
+}
+
+// i32 求和时扩展为 i64 累加，避免溢出
+KIZ_TARGET_AVX2 inline int64_t sum_i32_avx2(const int32_t* a, const size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    int64_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i) total += a[i];
+    return total;
+}
+
+template <bool IS_MIN>
+KIZ_TARGET_AVX2 inline int32_t minmax_i32_avx2(const int32_t* a, const size_t n) {
+    __m256i acc = _mm256_set1_epi32(a[0]);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        acc = IS_MIN ? _mm256_min_epi32(acc, v) : _mm256_max_epi32(acc, v);
+    }
+    alignas(32) int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    int32_t result = lanes[0];
+    for (int k = 1; k < 8; ++k) result = IS_MIN ? std::min(result, lanes[k]) : std::max(result, lanes[k]);
+    for (; i < n; ++i) result = IS_MIN ? std::min(result, a[i]) : std::max(result, a[i]);
+    return result;
+}
+
+template <CmpOp OP>
+KIZ_TARGET_AVX2 inline void compare_i32_avx2(const int32_t* a, const int32_t* b, const bool b_scalar, uint8_t* out, const size_t n) {
+    size_t i = 0;
+    const __m256i vs = _mm256_set1_epi32(b[0]);
+    for (; i + 8 <= n; i += 8) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = b_scalar ? vs : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i m;
+        if constexpr (OP == CmpOp::Lt) m = _mm256_cmpgt_epi32(vb, va);
+        else if constexpr (OP == CmpOp::Gt) m = _mm256_cmpgt_epi32(va, vb);
+        else m = _mm256_cmpeq_epi32(va, vb);
+        const int bits = _mm256_movemask_ps(_mm256_castsi256_ps(m));
+        for (int k = 0; k < 8; ++k) out[i + k] = static_cast<uint8_t>((bits >> k) & 1);
+    }
+    compare_scalar<OP>(a, b, b_scalar, out, i, n);
+}
+
+// ========================= mask 内核 =========================
+KIZ_TARGET_AVX2 inline size_t count_mask_avx2(const uint8_t* m, const size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        // 每字节为 0/1，用 SAD 对 8 字节一组求和
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(m + i)), _mm256_setzero_si256()));
+    }
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    size_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i) total += m[i];
+    return total;
+}
+#endif
+
+// ========================= 对外分发接口 =========================
+template <BinOp OP, typename T>
+inline void binary(const T* a, const T* b, const bool b_scalar, T* out, const size_t n) {
+    if (n == 0) return;
+#if defined(KIZ_ARCH_X86)
+    if constexpr (std::is_same_v<T, double>) {
+        if (level == Level::AVX2) return binary_f64_avx2<OP>(a, b, b_scalar, out, n);
+        if (level == Level::SSE2) return binary_f64_sse2<OP>(a, b, b_scalar, out, n);
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        if constexpr (OP == BinOp::Add || OP == BinOp::Sub) {
+            if (level == Level::AVX2) return binary_i64_avx2<OP>(a, b, b_scalar, out, n);
+        }
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        if constexpr (OP != BinOp::Div) {
+            if (level == Level::AVX2) return binary_i32_avx2<OP>(a, b, b_scalar, out, n);
+        }
+    }
+#endif
+    binary_scalar<OP>(a, b, b_scalar, out, 0, n);
+}
+
+template <CmpOp OP, typename T>
+inline void compare_to(const T* a, const T* b, const bool b_scalar, uint8_t* out, const size_t n) {
+    if (n == 0) return;
+#if defined(KIZ_ARCH_X86)
+    if (level == Level::AVX2) {
+        if constexpr (std::is_same_v<T, double>) return compare_f64_avx2<OP>(a, b, b_scalar, out, n);
+        else if constexpr (std::is_same_v<T, int64_t>) return compare_i64_avx2<OP>(a, b, b_scalar, out, n);
+        else if constexpr (std::is_same_v<T, int32_t>) return compare_i32_avx2<OP>(a, b, b_scalar, out, n);
+    }
+#endif
+    compare_scalar<OP>(a, b, b_scalar, out, 0, n);
+}
+
+// 求和：浮点返回 double，整数统一以 int64 累加
+template <typename T>
+inline auto sum(const T* a, const size_t n) {
+    using Acc = std::conditional_t<std::is_floating_point_v<T>, double, int64_t>;
+#if defined(KIZ_ARCH_X86)
+    if constexpr (std::is_same_v<T, double>) {
+        if (level == Level::AVX2) return sum_f64_avx2(a, n);
+        if (level == Level::SSE2) return sum_f64_sse2(a, n);
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        if (level == Level::AVX2) return sum_i64_avx2(a, n);
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        if (level == Level::AVX2) return sum_i32_avx2(a, n);
+    }
+#endif
+    Acc total = 0;
+    for (size_t i = 0; i < n; ++i) total += a[i];
+    return total;
+}
+
+template <typename T>
+inline auto dot(const T* a, const T* b, const size_t n) {
+    using Acc = std::conditional_t<std::is_floating_point_v<T>, double, int64_t>;
+#if defined(KIZ_ARCH_X86)
+    if constexpr (std::is_same_v<T, double>) {
+        if (level == Level::AVX2) return dot_f64_avx2(a, b, n);
+        if (level == Level::SSE2) return dot_f64_sse2(a, b, n);
+    }
+#endif
+    Acc total = 0;
+    for (size_t i = 0; i < n; ++i) total += static_cast<Acc>(a[i]) * static_cast<Acc>(b[i]);
+    return total;
+}
+
+// 最小/最大值（调用方保证 n > 0）
+template <bool IS_MIN, typename T>
+inline T min_max(const T* a, const size_t n) {
+#if defined(KIZ_ARCH_X86)
+    if (level == Level::AVX2) {
+        if constexpr (std::is_same_v<T, double>) return minmax_f64_avx2<IS_MIN>(a, n);
+        else if constexpr (std::is_same_v<T, int32_t>) return minmax_i32_avx2<IS_MIN>(a, n);
+    }
+#endif
+    return IS_MIN ? *std::min_element(a, a + n) : *std::max_element(a, a + n);
+}
+
+inline size_t count_mask(const uint8_t* m, const size_t n) {
+#if defined(KIZ_ARCH_X86)
+    if (level == Level::AVX2) return count_mask_avx2(m, n);
+#endif
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) total += m[i];
+    return total;
+}
+
+} // namespace array_lib::simd
@@ -0,0 +1,136 @@
+/**
+ * @file async.hpp
+ * @brief 协程相关内置函数：run / gather / sleep / timeout
+ * run 驱动事件循环直到给定协程完成；gather 同时启动多个协程 / Future，全部完成后按参数顺序返回结果；
+ * sleep 与 timeout 基于事件循环的定时器。timeout 到期只是不再等待（结果为 Nil），原协程继续运行
+ * @author azhz1107cat
+ * @date 2025-12-27
+ */
+
+#pragma once
+
+#include <cassert>
+#include <memory>
+
+#include "models.hpp"
+#include "vm.hpp"
+#include "channels.hpp"
+#include "../../../deps/event_loop.hpp"
+
+namespace builtin_objects {
+
+inline model::Future* get_future_arg(model::Object* obj, const char* msg) {
+    const auto future = dynamic_cast<model::Future*>(obj);
+    assert(future != nullptr && msg);
+    return future;
+}
+
+// run(coro)：运行事件循环直到 coro 完成，返回其结果
+inline auto run = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() == 1 && "function run need 1 arg");
+    model::Object* result = kiz::Vm::run_until_complete(get_future_arg(args->val[0], "run: 参数必须是协程或 Future"));
+    // run_until_complete 的结果已持有一个引用，CppFunction 以 0 引用返回
+    result->drop_ref();
+    return result;
+};
+
+// gather(a, b, ...) / gather([a, b, ...])：启动全部协程并等待它们完成，结果按参数顺序组成 List
+inline auto gather = [](model::Object* self, const model::List* args) -> model::Object* {
+    std::vector<model::Object*> items = args->val;
+    if (items.size() == 1) {
+        if (const auto list = dynamic_cast<const model::List*>(items[0])) items = list->flat();
+    }
+    std::vector<model::Future*> futures;
+    futures.reserve(items.size());
+    bool all_done = true;
+    for (model::Object* item : items) {
+        model::Future* future = get_future_arg(item, "gather: 参数必须是协程或 Future");
+        kiz::Vm::start(future);
+        all_done = all_done && future->done;
+        futures.push_back(future);
+    }
+
+    auto* all = new model::Future();
+    if (all_done) {
+        std::vector<model::Object*> results;
+        results.reserve(futures.size());
+        for (model::Future* future : futures) {
+            future->result->make_ref();
+            results.push_back(future->result);
+        }
+        all->resolve(new model::List(std::move(results)));
+        return all;
+    }
+
+    // 至少有一个尚未完成，最后一个回调一定在返回之后才运行
+    struct Pending {
+        std::vector<model::Object*> results;
+        size_t remaining;
+    };
+    auto pending = std::make_shared<Pending>(Pending{std::vector<model::Object*>(futures.size(), nullptr), futures.size()});
+    all->make_ref();  // 由最后完成的回调释放
+    for (size_t i = 0; i < futures.size(); ++i) {
+        model::Future* future = futures[i];
+        future->make_ref();
+        future->add_done_callback([all, pending, future, i] {
+            future->result->make_ref();
+            pending->results[i] = future->result;
+            future->del_ref();
+            if (--pending->remaining == 0) {
+                all->resolve(new model::List(std::move(pending->results)));
+                all->del_ref();
+            }
+        });
+    }
+    return all;
+};
+
+// sleep(seconds)：seconds 秒后完成的 Future（结果为 Nil）
+inline auto sleep = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() == 1 && "function sleep need 1 arg");
+    auto* future = new model::Future();
+    future->make_ref();  // 由定时器回调持有
+    deps::EventLoop::instance().call_later(get_seconds_arg(args->val[0]), [future] {
+        future->resolve(nullptr);
+        future->del_ref();
+    });
+    return future;
+};
+
+// timeout(aw, seconds)：aw 在 seconds 秒内完成则结果为 aw 的结果，否则为 Nil
+inline auto timeout = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() == 2 && "function timeout need 2 args");
+    model::Future* inner = get_future_arg(args->val[0], "timeout: 第一个参数必须是协程或 Future");
+    const auto delay = get_seconds_arg(args->val[1]);
+    kiz::Vm::start(inner);
+
+    auto* out = new model::Future();
+    if (inner->done) {
+        out->resolve(inner->result);
+        return out;
+    }
+    auto& loop = deps::EventLoop::instance();
+    out->make_ref();  // 由定时器回调持有
+    const uint64_t timer = loop.call_later(delay, [out] {
+        if (!out->done) out->resolve(nullptr);
+        out->del_ref();
+    });
+    out->make_ref();  // 由 inner 的完成回调持有
+    inner->make_ref();
+    inner->add_done_callback([out, inner, timer] {
+        if (!out->done) out->resolve(inner->result);
+        // 定时器尚未触发：取消它并替它释放引用
+        if (deps::EventLoop::instance().cancel(timer)) out->del_ref();
+        out->del_ref();
+        inner->del_ref();
+    });
+    return out;
+};
+
+// Future.done()：是否已完成
+inline auto future_done = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (future_done)");
+    return new model::Bool(get_future_arg(self, "future_done must be called by Future object")->done);
+};
+
+} // namespace builtin_objects
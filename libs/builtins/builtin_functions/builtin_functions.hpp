@@ -3,6 +3,8 @@
 #include <unordered_set>
 
 #include "models.hpp"
+#include "../../../deps/out_buffer.hpp"
+#include "../../../deps/thread_pool.hpp"
 
 inline model::Object* get_one_arg(const model::List* args) {
     if (!args->val.empty()) {
@@ -39,22 +41,117 @@ inline model::Object* check_based_object(model::Object* src_obj, model::Object*
 
 namespace builtin_objects {
 
+// 标准输出缓冲（每个线程一个，无需加锁）：print 写入此处，缓冲写满、flush()、读输入前、
+// 线程退出或断言失败时写出
+inline deps::OutBuffer& stdout_buffer() {
+    thread_local deps::OutBuffer buffer(stdout);
+    thread_local const bool hooked = (buffer.flush_on_abort(), true);
+    (void)hooked;
+    return buffer;
+}
+
+// print(...)：各参数的表示直接写入输出缓冲，不拼接临时字符串
 inline auto print = [](model::Object* self, const model::List* args) -> model::Object* {
-    std::string text;
+    deps::OutBuffer& out = stdout_buffer();
     for (const auto* arg : args->val) {
-        text += arg->to_string() + " ";
+        arg->append_repr(out.buffer());
+        out.buffer() += ' ';
     }
-    std::cout << text << std::endl;
+    out.end_line();
+    return new model::Nil();
+};
+
+// flush()：立即写出缓冲中的输出
+inline auto flush = [](model::Object* self, const model::List* args) -> model::Object* {
+    stdout_buffer().flush();
     return new model::Nil();
 };
 
 inline auto input = [](model::Object* self, const model::List* args) -> model::Object* {
     const auto prompt_obj = get_one_arg(args);
-    std::cout << prompt_obj->to_string();
+    // 提示为字符串时不带引号输出；写出之前的输出与提示后再读取
+    if (const auto prompt_str = dynamic_cast<const model::String*>(prompt_obj)) {
+        stdout_buffer().write(prompt_str->val);
+    } else {
+        prompt_obj->append_repr(stdout_buffer().buffer());
+    }
+    stdout_buffer().flush();
     std::string result;
     std::getline(std::cin, result);
     return new model::String(result);
 };
+// str_builder([init])：创建 StringBuilder，可选初始内容（String）或预留容量（Int）
+inline auto str_builder = [](model::Object* self, const model::List* args) -> model::Object* {
+    const auto sb = new model::StringBuilder();
+    if (args->val.empty()) return sb;
+    if (const auto init_str = dynamic_cast<const model::String*>(args->val[0])) {
+        sb->buf = init_str->val;
+    } else if (const auto cap_int = dynamic_cast<const model::Int*>(args->val[0])) {
+        assert(cap_int->val >= deps::BigInt(0) && cap_int->val.fits_long_long() && "str_builder capacity out of range");
+        sb->buf.reserve(static_cast<size_t>(cap_int->val.to_long_long()));
+    } else {
+        assert(false && "str_builder 参数必须是 String 或 Int");
+    }
+    return sb;
+};
+
+// len(x)：String 为码点数，List / Tuple / Set 为元素数，Dictionary 为键数；其他对象调用其 __len__（CppFunction）
+inline auto len = [](model::Object* self, const model::List* args) -> model::Object* {
+    const auto obj = get_one_arg(args);
+    size_t n = 0;
+    if (const auto str_obj = dynamic_cast<const model::String*>(obj)) {
+        n = str_obj->cp_len();
+    } else if (const auto list_obj = dynamic_cast<const model::List*>(obj)) {
+        n = list_obj->size();
+    } else if (const auto tuple_obj = dynamic_cast<const model::Tuple*>(obj)) {
+        n = tuple_obj->size();
+    } else if (const auto bytes_obj = dynamic_cast<const model::Bytes*>(obj)) {
+        n = bytes_obj->size();
+    } else if (const auto dict_obj = dynamic_cast<const model::Dictionary*>(obj)) {
+        n = dict_obj->attrs.size() - (dict_obj->attrs.find_in_current("__parent__") ? 1 : 0)  // 不计 __parent__
+            + dict_obj->items.size();
+    } else if (const auto set_obj = dynamic_cast<const model::Set*>(obj)) {
+        n = set_obj->val.size();
+    } else if (const auto sb_obj = dynamic_cast<const model::StringBuilder*>(obj)) {
+        n = sb_obj->buf.size();
+    } else {
+        const auto len_it = obj->attrs.find("__len__");
+        model::Object* len_method = len_it ? len_it->value : nullptr;
+        // 沿 __parent__ 链查找
+        for (auto parent = obj->attrs.find("__parent__"); len_method == nullptr && parent; ) {
+            const auto found = parent->value->attrs.find("__len__");
+            if (found) len_method = found->value;
+            parent = parent->value->attrs.find("__parent__");
+        }
+        const auto len_fn = dynamic_cast<model::CppFunction*>(len_method);
+        assert(len_fn != nullptr && "len: 对象不支持 len");
+        // len 只对内置类型是纯函数：工作线程中不调用未标记为纯的 __len__
+        assert((len_fn->pure || !deps::ThreadPool::in_worker()) && "len: 该对象的 __len__ 不是纯函数，不能在 parallel 中调用");
+        const auto empty_args = new model::List({});
+        model::Object* result = len_fn->func(obj, empty_args);
+        delete empty_args;
+        return result;
+    }
+    return new model::Int(deps::BigInt(n));
+};
+
+// set([list])：创建集合，可选由 List 中的元素初始化（自动去重）
+inline auto set = [](model::Object* self, const model::List* args) -> model::Object* {
+    const auto result = new model::Set();
+    if (args->val.empty()) return result;
+    const auto init_list = dynamic_cast<const model::List*>(args->val[0]);
+    assert(init_list != nullptr && "set 参数必须是 List");
+    result->val.reserve(init_list->size());
+    for (size_t i = 0; i < init_list->size(); ++i) result->add(init_list->at(i));
+    return result;
+};
+
+// hash(x)：返回可哈希对象的哈希值
+inline auto hash = [](model::Object* self, const model::List* args) -> model::Object* {
+    const auto obj = get_one_arg(args);
+    assert(model::is_hashable(obj) && "hash: 对象不可哈希");
+    return new model::Int(deps::BigInt(model::hash_object(obj)));
+};
 
 inline auto isinstance = [](model::Object* self, const model::List* args) -> model::Object* {
     if (!(args->val.size() == 2)) {
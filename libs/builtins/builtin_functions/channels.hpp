@@ -0,0 +1,409 @@
+/**
+ * @file channels.hpp
+ * @brief 有界通道：channel / send / recv / select，在线程（各自的 VM）之间传递值
+ * 收发走无锁 MPMC 环形队列，只有队列满 / 空需要等待时才挂起。
+ * 值按"所有权交接"传递：不可变值（Nil / Bool / Int / Rational / String / 只读 Bytes 及只含这些的 Tuple）
+ * 直接交出引用，其余（List / Dictionary / Set / Struct / bytearray / StringBuilder）做结构化深拷贝，
+ * 收发双方不会共享可变对象。Channel 本身按引用传递，可以把通道发给另一端。
+ * Channel 也是迭代器：关闭且取空后结束，可直接交给 map / filter / sum / list。
+ * 没有其他线程登记为通道另一端（Channel::Peer）时，会永远等待的 send / recv / select 直接报错
+ * @author azhz1107cat
+ * @date 2025-12-27
+ */
+
+#pragma once
+
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+
+#include "models.hpp"
+#include "iterators.hpp"
+#include "../../../deps/mpmc_queue.hpp"
+
+namespace model {
+
+// 跨线程传递一个值：返回值已持有一个引用
+class Transfer {
+    // 已复制的对象 -> 副本：保持原结构中的共享与环
+    std::unordered_map<const Object*, Object*> copied_;
+
+    static bool is_immutable_scalar(const Object* obj) {
+        switch (obj->get_type()) {
+            case Object::ObjectType::OT_Nil:
+            case Object::ObjectType::OT_Bool:
+            case Object::ObjectType::OT_Int:
+            case Object::ObjectType::OT_Rational:
+            case Object::ObjectType::OT_String:
+            case Object::ObjectType::OT_StructType:
+            case Object::ObjectType::OT_Channel:
+                return true;
+            case Object::ObjectType::OT_Bytes:
+                return !dynamic_cast<const Bytes*>(obj)->writable;
+            default:
+                return false;
+        }
+    }
+
+    // 可整体共享：不可变标量，或只含可共享元素的 Tuple
+    static bool is_shareable(const Object* obj) {
+        if (is_immutable_scalar(obj)) return true;
+        const auto tuple_obj = dynamic_cast<const Tuple*>(obj);
+        if (tuple_obj == nullptr) return false;
+        for (size_t i = 0; i < tuple_obj->size(); ++i) {
+            if (tuple_obj->at(i) != nullptr && !is_shareable(tuple_obj->at(i))) return false;
+        }
+        return true;
+    }
+
+    Object* copy_or_null(Object* obj) {
+        return obj == nullptr ? nullptr : copy(obj);
+    }
+
+public:
+    Object* copy(Object* obj) {
+        if (is_shareable(obj)) {
+            // String / Bytes 的惰性缓存以原子方式发布，两端可同时读取
+            obj->make_ref();
+            return obj;
+        }
+        if (const auto found = copied_.find(obj); found != copied_.end()) {
+            found->second->make_ref();
+            return found->second;
+        }
+
+        Object* result = nullptr;
+        switch (obj->get_type()) {
+            case Object::ObjectType::OT_List: {
+                const auto src = dynamic_cast<const List*>(obj);
+                const auto dst = new List(std::vector<Object*>{});
+                copied_.emplace(obj, dst);
+                dst->val.reserve(src->size());
+                for (size_t i = 0; i < src->size(); ++i) dst->val.push_back(copy_or_null(src->at(i)));
+                result = dst;
+                break;
+            }
+            case Object::ObjectType::OT_Tuple: {
+                // 含可变元素的 Tuple：元素逐个传递（元组不可变，不会成环）
+                const auto src = dynamic_cast<const Tuple*>(obj);
+                std::vector<Object*> elems;
+                elems.reserve(src->size());
+                for (size_t i = 0; i < src->size(); ++i) elems.push_back(copy_or_null(src->at(i)));
+                result = new Tuple(elems);
+                copied_.emplace(obj, result);
+                break;
+            }
+            case Object::ObjectType::OT_Dictionary: {
+                const auto src = dynamic_cast<const Dictionary*>(obj);
+                // 先复制 String 键的值，再由构造函数补上 __parent__
+                deps::HashMap<Object*> attrs;
+                src->attrs.for_each([&](const std::string& key, Object* val) {
+                    if (key != "__parent__") attrs.insert(key, copy_or_null(val));
+                });
+                const auto dst = new Dictionary(attrs);
+                copied_.emplace(obj, dst);
+                dst->items.reserve(src->items.size());
+                src->items.for_each([&](Object* key, Object* val) {
+                    *dst->items.emplace(copy(key)).first = copy_or_null(val);
+                });
+                result = dst;
+                break;
+            }
+            case Object::ObjectType::OT_Set: {
+                const auto src = dynamic_cast<const Set*>(obj);
+                const auto dst = new Set();
+                copied_.emplace(obj, dst);
+                dst->val.reserve(src->val.size());
+                src->val.for_each([&](Object* elem, const deps::Unit&) {
+                    dst->val.emplace(copy(elem));
+                });
+                result = dst;
+                break;
+            }
+            case Object::ObjectType::OT_Struct: {
+                const auto src = dynamic_cast<const Struct*>(obj);
+                const auto dst = new Struct(src->type);
+                copied_.emplace(obj, dst);
+                for (size_t i = 0; i < src->size(); ++i) dst->slots[i] = copy_or_null(src->slots[i]);
+                result = dst;
+                break;
+            }
+            case Object::ObjectType::OT_Bytes: {
+                const auto src = dynamic_cast<const Bytes*>(obj);
+                result = new Bytes(src->view(), true);
+                copied_.emplace(obj, result);
+                break;
+            }
+            case Object::ObjectType::OT_StringBuilder: {
+                result = new StringBuilder(dynamic_cast<const StringBuilder*>(obj)->buf);
+                copied_.emplace(obj, result);
+                break;
+            }
+            default:
+                assert(false && "channel: 只能传递数据值，函数、模块、迭代器与文件不能发送");
+        }
+        result->make_ref();
+        return result;
+    }
+};
+
+class Channel : public Iterator {
+    deps::MpmcQueue<Object*> queue_;
+    std::atomic<bool> closed_{false};
+    deps::EventCount not_empty_, not_full_;
+
+    // 挂起前先让出 CPU 重试的次数：对方通常很快就会取走 / 放入，不必进入慢路径
+    static constexpr int spin_limit = 64;
+
+public:
+    static constexpr ObjectType TYPE = ObjectType::OT_Channel;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    explicit Channel(const size_t capacity) : queue_(capacity) {
+        attrs.insert("__parent__", based_channel);
+    }
+
+    // 所有通道共用：select 在多个通道上等待时由任一通道的入队唤醒
+    static deps::EventCount& any_ready() {
+        static deps::EventCount event;
+        return event;
+    }
+
+    // 能收发通道的线程数（主线程计 1）；只有一个时等待永远不会结束，收发直接报错
+    static std::atomic<int>& peers() {
+        static std::atomic<int> count{1};
+        return count;
+    }
+
+    // 启动运行脚本的线程之前创建一个并交给该线程持有到退出，登记为通道的另一端
+    struct Peer {
+        Peer() { peers().fetch_add(1, std::memory_order_relaxed); }
+        ~Peer() { peers().fetch_sub(1, std::memory_order_relaxed); }
+        Peer(const Peer&) = delete;
+        Peer& operator=(const Peer&) = delete;
+    };
+
+    static bool has_peer() {
+        return peers().load(std::memory_order_relaxed) > 1;
+    }
+
+    [[nodiscard]] size_t capacity() const { return queue_.capacity(); }
+    [[nodiscard]] size_t size() const { return queue_.size_approx(); }
+    [[nodiscard]] bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    // 不等待地取一个值（已持有引用），空时返回 nullptr
+    Object* try_recv() {
+        Object* value = nullptr;
+        if (!queue_.try_pop(value)) return nullptr;
+        not_full_.notify_all();
+        return value;
+    }
+
+    // value 的引用交给通道；通道满时等待接收方取走
+    void send(Object* value) {
+        assert(!closed() && "channel: 不能向已关闭的通道发送");
+        for (int spin = 0; !queue_.try_push(value); ++spin) {
+            assert(has_peer() && "channel: 通道已满且没有其他线程接收，send 将永远阻塞");
+            if (spin < spin_limit) {
+                std::this_thread::yield();
+                continue;
+            }
+            const uint64_t key = not_full_.prepare_wait();
+            if (queue_.try_push(value)) {
+                not_full_.cancel_wait();
+                break;
+            }
+            not_full_.wait(key);
+        }
+        not_empty_.notify_all();
+        any_ready().notify_all();
+    }
+
+    // 取一个值（已持有引用）；通道空时等待，关闭且取空后返回 nullptr
+    Object* recv() {
+        for (int spin = 0;; ++spin) {
+            if (Object* value = try_recv()) return value;
+            if (closed()) return try_recv();
+            assert(has_peer() && "channel: 通道为空且没有其他线程发送，recv 将永远阻塞");
+            if (spin < spin_limit) {
+                std::this_thread::yield();
+                continue;
+            }
+            const uint64_t key = not_empty_.prepare_wait();
+            if (Object* value = try_recv()) {
+                not_empty_.cancel_wait();
+                return value;
+            }
+            if (closed()) {
+                not_empty_.cancel_wait();
+                return try_recv();
+            }
+            not_empty_.wait(key);
+        }
+    }
+
+    // 关闭后不能再发送；已在队列中的值仍可取出
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        not_empty_.notify_all();
+        not_full_.notify_all();
+        any_ready().notify_all();
+    }
+
+    Object* next() override {
+        return recv();
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return "<Channel: cap=" + std::to_string(capacity()) + (closed() ? ", closed" : "") + " at "
+               + ptr_to_string(this) + ">";
+    }
+
+    ~Channel() override {
+        Object* value = nullptr;
+        while (queue_.try_pop(value)) value->del_ref();
+    }
+};
+
+} // namespace model
+
+namespace builtin_objects {
+
+inline model::Channel* get_channel_arg(model::Object* obj, const char* msg) {
+    const auto ch = dynamic_cast<model::Channel*>(obj);
+    assert(ch != nullptr && msg);
+    return ch;
+}
+
+// 等待时长（秒，Int 或 Rational）：select / sleep / timeout 共用
+inline std::chrono::steady_clock::duration get_seconds_arg(const model::Object* obj) {
+    double seconds = 0;
+    if (const auto int_obj = dynamic_cast<const model::Int*>(obj)) {
+        assert(int_obj->val.fits_long_long() && "等待时长超出范围");
+        seconds = static_cast<double>(int_obj->val.to_long_long());
+    } else if (const auto rat_obj = dynamic_cast<const model::Rational*>(obj)) {
+        assert(rat_obj->val.numerator.fits_long_long() && rat_obj->val.denominator.fits_long_long()
+               && "等待时长超出范围");
+        seconds = static_cast<double>(rat_obj->val.numerator.to_long_long())
+                  / static_cast<double>(rat_obj->val.denominator.to_long_long());
+    } else {
+        assert(false && "等待时长必须是 Int 或 Rational（秒）");
+    }
+    assert(seconds >= 0 && "等待时长不能为负");
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+// channel(cap)：新建容量为 cap 的通道（向上取整为 2 的幂）
+inline auto channel = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() == 1 && "channel need 1 arg: (capacity)");
+    const size_t cap = model::get_size_arg(args->val[0], "channel: capacity 必须是非负整数");
+    assert(cap > 0 && "channel: capacity 必须大于 0");
+    return new model::Channel(cap);
+};
+
+// send(ch, value)：不可变值交出引用，其余深拷贝后入队；通道满时等待
+inline auto send = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() == 2 && "send need 2 args: (channel, value)");
+    model::Channel* ch = get_channel_arg(args->val[0], "send 的第一个参数必须是 Channel");
+    ch->send(model::Transfer().copy(args->val[1]));
+    return new model::Nil();
+};
+
+// recv(ch)：取出一个值；通道空时等待，关闭且取空后返回 Nil
+inline auto recv = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() == 1 && "recv need 1 arg: (channel)");
+    model::Channel* ch = get_channel_arg(args->val[0], "recv 的参数必须是 Channel");
+    if (model::Object* value = ch->recv()) {
+        value->drop_ref();
+        return value;
+    }
+    return new model::Nil();
+};
+
+// select(chans[, timeout])：从第一个有值的通道取值，返回 (下标, 值)；
+// 全部关闭且取空或超时返回 Nil，timeout 为 0 时只检查一遍不等待
+inline auto select = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert((args->val.size() == 1 || args->val.size() == 2) && "select need 1 or 2 args: (channels[, timeout])");
+    const auto list_obj = dynamic_cast<const model::List*>(args->val[0]);
+    assert(list_obj != nullptr && list_obj->size() > 0 && "select 的第一个参数必须是非空的 Channel List");
+    std::vector<model::Channel*> chans;
+    chans.reserve(list_obj->size());
+    for (size_t i = 0; i < list_obj->size(); ++i) {
+        chans.push_back(get_channel_arg(list_obj->at(i), "select 的列表元素必须是 Channel"));
+    }
+    const bool has_timeout = args->val.size() == 2;
+    const auto deadline = std::chrono::steady_clock::now()
+                          + (has_timeout ? get_seconds_arg(args->val[1]) : std::chrono::steady_clock::duration{});
+
+    // 轮转起点，避免总是偏向前面的通道
+    static thread_local size_t rotation = 0;
+    const size_t n = chans.size();
+    const auto poll = [&](bool& all_closed) -> model::Object* {
+        all_closed = true;
+        const size_t first = rotation++ % n;
+        for (size_t k = 0; k < n; ++k) {
+            const size_t i = (first + k) % n;
+            if (model::Object* value = chans[i]->try_recv()) {
+                model::Object* pair[2] = {new model::Int(deps::BigInt(i)), value};
+                pair[0]->make_ref();
+                return new model::Tuple(pair, 2);
+            }
+            if (!chans[i]->closed()) all_closed = false;
+        }
+        return nullptr;
+    };
+
+    deps::EventCount& event = model::Channel::any_ready();
+    for (;;) {
+        bool all_closed = false;
+        if (model::Object* result = poll(all_closed)) return result;
+        if (all_closed) break;
+        if (has_timeout && std::chrono::steady_clock::now() >= deadline) break;
+        assert((has_timeout || model::Channel::has_peer()) && "select: 通道均为空且没有其他线程发送，将永远阻塞");
+        const uint64_t key = event.prepare_wait();
+        if (model::Object* result = poll(all_closed)) {
+            event.cancel_wait();
+            return result;
+        }
+        if (all_closed) {
+            event.cancel_wait();
+            break;
+        }
+        if (!event.wait(key, has_timeout ? &deadline : nullptr)) break;
+    }
+    return new model::Nil();
+};
+
+// Channel.send(value) / Channel.recv() / Channel.close()
+inline auto channel_send = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (channel_send)");
+    assert(args->val.size() == 1 && "function Channel.send need 1 arg");
+    get_channel_arg(self, "channel_send must be called by Channel object")->send(model::Transfer().copy(args->val[0]));
+    return new model::Nil();
+};
+
+inline auto channel_recv = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (channel_recv)");
+    assert(args->val.empty() && "function Channel.recv need 0 arg");
+    if (model::Object* value = get_channel_arg(self, "channel_recv must be called by Channel object")->recv()) {
+        value->drop_ref();
+        return value;
+    }
+    return new model::Nil();
+};
+
+inline auto channel_close = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (channel_close)");
+    assert(args->val.empty() && "function Channel.close need 0 arg");
+    get_channel_arg(self, "channel_close must be called by Channel object")->close();
+    return new model::Nil();
+};
+
+// len(ch)：当前排队的值个数（近似）
+inline auto channel_len = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (channel_len)");
+    return new model::Int(deps::BigInt(get_channel_arg(self, "channel_len must be called by Channel object")->size()));
+};
+
+} // namespace builtin_objects
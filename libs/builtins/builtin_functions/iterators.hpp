@@ -0,0 +1,645 @@
+/**
+ * @file iterators.hpp
+ * @brief 惰性迭代器：range / map / filter / zip / enumerate / take 与终结操作 sum / reduce / list
+ * 迭代器按需拉取（pull），链式管道在终结操作中一次遍历完成，不生成中间 List
+ * @author azhz1107cat
+ * @date 2025-12-19
+ */
+
+#pragma once
+
+#include <cassert>
+
+#include "models.hpp"
+#include "vm.hpp"
+#include "../builtin_methods/bytes_obj.hpp"
+#include "../../../deps/bit_ops.hpp"
+
+namespace model {
+
+// 惰性迭代器基类（单次遍历：耗尽后不可重新开始）
+class Iterator : public Object {
+public:
+    static constexpr ObjectType TYPE = ObjectType::OT_Iterator;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    Iterator() {
+        attrs.insert("__parent__", based_iterator);
+    }
+
+    // 产出下一个元素（返回值已持有一个引用），耗尽时返回 nullptr
+    virtual Object* next() = 0;
+
+    // 剩余元素个数的上界估计（未知为 0），list() 据此预分配
+    [[nodiscard]] virtual size_t size_hint() const { return 0; }
+
+    [[nodiscard]] std::string to_string() const override {
+        return "<Iterator at " + ptr_to_string(this) + ">";
+    }
+};
+
+// 判断谓词结果的真假（与 JUMP_IF_FALSE 一致：仅 Nil / False 为假）
+inline bool is_truthy(const Object* obj) {
+    if (obj->get_type() == Object::ObjectType::OT_Nil) return false;
+    const auto bool_obj = dynamic_cast<const Bool*>(obj);
+    assert(bool_obj != nullptr && "条件必须是Nil或Bool");
+    return bool_obj->val;
+}
+
+// 以单个参数调用 func(x)，x 的引用仍归调用方
+inline Object* invoke_unary(Object* func, Object* x) {
+    return kiz::Vm::invoke(func, new List({x}));
+}
+
+// range：能放进 long long 时用机器整数计数，否则退回 BigInt
+class RangeIter : public Iterator {
+    deps::BigInt cur_, stop_, step_;
+    long long cur_ll_ = 0, stop_ll_ = 0, step_ll_ = 0;
+    bool small_ = false;
+    bool done_ = false;
+
+public:
+    RangeIter(deps::BigInt start, deps::BigInt stop, deps::BigInt step)
+        : cur_(std::move(start)), stop_(std::move(stop)), step_(std::move(step)) {
+        assert(step_ != deps::BigInt(0) && "range step 不能为 0");
+        small_ = cur_.fits_long_long() && stop_.fits_long_long() && step_.fits_long_long();
+        if (small_) {
+            cur_ll_ = cur_.to_long_long();
+            stop_ll_ = stop_.to_long_long();
+            step_ll_ = step_.to_long_long();
+        }
+    }
+
+    Object* next() override {
+        if (done_) return nullptr;
+        Object* result;
+        if (small_) {
+            if (step_ll_ > 0 ? cur_ll_ >= stop_ll_ : cur_ll_ <= stop_ll_) return nullptr;
+            result = new Int(deps::BigInt::from_long_long(cur_ll_));
+            if (deps::bits::add_overflow(cur_ll_, step_ll_, &cur_ll_)) done_ = true;
+        } else {
+            const bool ascending = step_ > deps::BigInt(0);
+            if (ascending ? cur_ >= stop_ : cur_ <= stop_) return nullptr;
+            result = new Int(cur_);
+            cur_ += step_;
+        }
+        result->make_ref();
+        return result;
+    }
+
+    // 剩余元素个数
+    [[nodiscard]] deps::BigInt remaining() const {
+        if (done_) return deps::BigInt(0);
+        const deps::BigInt cur = small_ ? deps::BigInt::from_long_long(cur_ll_) : cur_;
+        // 注意：BigInt 之间的 / 会匹配到返回 Rational 的全局重载，整除使用 /=
+        deps::BigInt count;
+        if (step_ > deps::BigInt(0)) {
+            if (cur >= stop_) return deps::BigInt(0);
+            count = stop_ - cur + step_ - deps::BigInt(1);
+            count /= step_;
+        } else {
+            if (cur <= stop_) return deps::BigInt(0);
+            const deps::BigInt abs_step = deps::BigInt(0) - step_;
+            count = cur - stop_ + abs_step - deps::BigInt(1);
+            count /= abs_step;
+        }
+        return count;
+    }
+
+    [[nodiscard]] size_t size_hint() const override {
+        const deps::BigInt n = remaining();
+        return n.fits_long_long() ? static_cast<size_t>(n.to_long_long()) : 0;
+    }
+
+    // 闭式求和并耗尽：n * first + step * n * (n - 1) / 2
+    deps::BigInt drain_sum() {
+        const deps::BigInt n = remaining();
+        const deps::BigInt first = small_ ? deps::BigInt::from_long_long(cur_ll_) : cur_;
+        done_ = true;
+        if (n == deps::BigInt(0)) return deps::BigInt(0);
+        deps::BigInt pairs = n * (n - deps::BigInt(1));
+        pairs /= deps::BigInt(2);
+        return n * first + step_ * pairs;
+    }
+};
+
+// 遍历 List（持有列表引用，不复制元素）
+class ListIter : public Iterator {
+    List* list_;
+    size_t idx_ = 0;
+
+public:
+    explicit ListIter(List* list) : list_(list) {
+        list_->make_ref();
+    }
+    ~ListIter() override {
+        list_->del_ref();
+    }
+
+    Object* next() override {
+        if (idx_ >= list_->size()) return nullptr;
+        Object* elem = list_->at(idx_++);
+        elem->make_ref();
+        return elem;
+    }
+
+    [[nodiscard]] size_t size_hint() const override {
+        return list_->size() - std::min(idx_, list_->size());
+    }
+};
+
+// 遍历 Tuple（持有元组引用）
+class TupleIter : public Iterator {
+    Tuple* tuple_;
+    size_t idx_ = 0;
+
+public:
+    explicit TupleIter(Tuple* tuple) : tuple_(tuple) {
+        tuple_->make_ref();
+    }
+    ~TupleIter() override {
+        tuple_->del_ref();
+    }
+
+    Object* next() override {
+        if (idx_ >= tuple_->size()) return nullptr;
+        Object* elem = tuple_->at(idx_++);
+        elem->make_ref();
+        return elem;
+    }
+
+    [[nodiscard]] size_t size_hint() const override {
+        return tuple_->size() - idx_;
+    }
+};
+
+// 遍历 Bytes，逐字节产出 Int（持有字节序列引用）
+class BytesIter : public Iterator {
+    Bytes* bytes_;
+    size_t idx_ = 0;
+
+public:
+    explicit BytesIter(Bytes* bytes) : bytes_(bytes) {
+        bytes_->make_ref();
+    }
+    ~BytesIter() override {
+        bytes_->del_ref();
+    }
+
+    Object* next() override {
+        if (idx_ >= bytes_->size()) return nullptr;
+        auto result = new Int(deps::BigInt::from_long_long(bytes_->data()[idx_++]));
+        result->make_ref();
+        return result;
+    }
+
+    [[nodiscard]] size_t size_hint() const override {
+        return bytes_->size() - idx_;
+    }
+};
+
+// 按码点遍历 String，产出单字符驻留字符串
+class StrIter : public Iterator {
+    String* str_;
+    size_t pos_ = 0;
+
+public:
+    explicit StrIter(String* str) : str_(str) {
+        str_->make_ref();
+    }
+    ~StrIter() override {
+        str_->del_ref();
+    }
+
+    Object* next() override {
+        const std::string& s = str_->val;
+        if (pos_ >= s.size()) return nullptr;
+        size_t end = pos_ + 1;
+        if (!str_->is_byte_mode()) {
+            while (end < s.size() && deps::utf8::is_continuation(static_cast<unsigned char>(s[end]))) ++end;
+        }
+        String* ch = intern_string(s.substr(pos_, end - pos_));
+        pos_ = end;
+        ch->make_ref();
+        return ch;
+    }
+};
+
+// 所有阶段迭代器的公共部分：持有上游迭代器的引用
+class StageIter : public Iterator {
+protected:
+    Iterator* src_;
+
+public:
+    explicit StageIter(Iterator* src) : src_(src) {
+        src_->make_ref();
+    }
+    ~StageIter() override {
+        src_->del_ref();
+    }
+};
+
+class MapIter : public StageIter {
+    Object* func_;
+
+public:
+    MapIter(Object* func, Iterator* src) : StageIter(src), func_(func) {
+        func_->make_ref();
+    }
+    ~MapIter() override {
+        func_->del_ref();
+    }
+
+    Object* next() override {
+        Object* x = src_->next();
+        if (x == nullptr) return nullptr;
+        Object* result = invoke_unary(func_, x);
+        x->del_ref();
+        return result;
+    }
+
+    [[nodiscard]] size_t size_hint() const override {
+        return src_->size_hint();
+    }
+};
+
+class FilterIter : public StageIter {
+    Object* pred_;
+
+public:
+    FilterIter(Object* pred, Iterator* src) : StageIter(src), pred_(pred) {
+        pred_->make_ref();
+    }
+    ~FilterIter() override {
+        pred_->del_ref();
+    }
+
+    Object* next() override {
+        while (Object* x = src_->next()) {
+            Object* cond = invoke_unary(pred_, x);
+            const bool keep = is_truthy(cond);
+            cond->del_ref();
+            if (keep) return x;
+            x->del_ref();
+        }
+        return nullptr;
+    }
+};
+
+class TakeIter : public StageIter {
+    size_t remaining_;
+
+public:
+    TakeIter(Iterator* src, const size_t n) : StageIter(src), remaining_(n) {}
+
+    Object* next() override {
+        if (remaining_ == 0) return nullptr;
+        --remaining_;
+        return src_->next();
+    }
+
+    [[nodiscard]] size_t size_hint() const override {
+        const size_t src_hint = src_->size_hint();
+        return src_hint == 0 ? remaining_ : std::min(src_hint, remaining_);
+    }
+};
+
+// enumerate：产出 (下标, 元素)
+class EnumerateIter : public StageIter {
+    deps::BigInt idx_;
+
+public:
+    EnumerateIter(Iterator* src, deps::BigInt start) : StageIter(src), idx_(std::move(start)) {}
+
+    Object* next() override {
+        Object* x = src_->next();
+        if (x == nullptr) return nullptr;
+        Object* idx_obj = new Int(idx_);
+        idx_obj->make_ref();
+        idx_ += deps::BigInt(1);
+        Object* const elems[2] = {idx_obj, x};
+        Object* pair = new Tuple(elems, 2);
+        pair->make_ref();
+        return pair;
+    }
+
+    [[nodiscard]] size_t size_hint() const override {
+        return src_->size_hint();
+    }
+};
+
+// zip：并行遍历多个迭代器，任一耗尽即结束，产出 (a, b, ...)
+class ZipIter : public Iterator {
+    std::vector<Iterator*> srcs_;
+
+public:
+    explicit ZipIter(std::vector<Iterator*> srcs) : srcs_(std::move(srcs)) {
+        for (Iterator* src : srcs_) src->make_ref();
+    }
+    ~ZipIter() override {
+        for (Iterator* src : srcs_) src->del_ref();
+    }
+
+    Object* next() override {
+        if (srcs_.empty()) return nullptr;
+        std::vector<Object*> items;
+        items.reserve(srcs_.size());
+        for (Iterator* src : srcs_) {
+            Object* x = src->next();
+            if (x == nullptr) {
+                for (Object* item : items) item->del_ref();
+                return nullptr;
+            }
+            items.push_back(x);
+        }
+        Object* tuple = new Tuple(items);
+        tuple->make_ref();
+        return tuple;
+    }
+
+    [[nodiscard]] size_t size_hint() const override {
+        size_t hint = 0;
+        for (const Iterator* src : srcs_) {
+            const size_t h = src->size_hint();
+            if (h == 0) return 0;
+            hint = hint == 0 ? h : std::min(hint, h);
+        }
+        return hint;
+    }
+};
+
+// 把可迭代对象转为迭代器（返回值已持有一个引用）：Iterator / List / Tuple / String / Set
+inline Iterator* iter_of(Object* obj) {
+    Iterator* it = nullptr;
+    if (auto existing = dynamic_cast<Iterator*>(obj)) {
+        it = existing;
+    } else if (auto list_obj = dynamic_cast<List*>(obj)) {
+        it = new ListIter(list_obj);
+    } else if (auto tuple_obj = dynamic_cast<Tuple*>(obj)) {
+        it = new TupleIter(tuple_obj);
+    } else if (auto str_obj = dynamic_cast<String*>(obj)) {
+        it = new StrIter(str_obj);
+    } else if (auto bytes_obj = dynamic_cast<Bytes*>(obj)) {
+        it = new BytesIter(bytes_obj);
+    } else if (auto set_obj = dynamic_cast<Set*>(obj)) {
+        // 集合先导出快照，遍历期间修改集合不影响迭代
+        std::vector<Object*> elems;
+        elems.reserve(set_obj->val.size());
+        set_obj->val.for_each([&elems](Object* elem, const deps::Unit&) {
+            elem->make_ref();
+            elems.push_back(elem);
+        });
+        it = new ListIter(new List(std::move(elems)));
+    } else {
+        assert(false && "对象不可迭代");
+    }
+    it->make_ref();
+    return it;
+}
+
+}  // namespace model
+
+namespace builtin_objects {
+
+inline deps::BigInt get_int_arg(const model::Object* obj, const char* msg) {
+    const auto int_obj = dynamic_cast<const model::Int*>(obj);
+    assert(int_obj != nullptr && msg);
+    return int_obj->val;
+}
+
+// range(stop) / range(start, stop[, step])：惰性整数序列
+inline auto range = [](model::Object* self, const model::List* args) -> model::Object* {
+    const size_t n = args->val.size();
+    assert(n >= 1 && n <= 3 && "range need 1 to 3 args");
+    deps::BigInt start(0), stop, step(1);
+    if (n == 1) {
+        stop = get_int_arg(args->val[0], "range 参数必须是 Int");
+    } else {
+        start = get_int_arg(args->val[0], "range 参数必须是 Int");
+        stop = get_int_arg(args->val[1], "range 参数必须是 Int");
+        if (n == 3) step = get_int_arg(args->val[2], "range 参数必须是 Int");
+    }
+    return new model::RangeIter(std::move(start), std::move(stop), std::move(step));
+};
+
+// map(f, iterable)：惰性地对每个元素调用 f
+inline auto map = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() == 2 && "map need 2 args: (func, iterable)");
+    model::Iterator* src = model::iter_of(args->val[1]);
+    auto result = new model::MapIter(args->val[0], src);
+    src->del_ref();
+    return result;
+};
+
+// filter(pred, iterable)：惰性地保留 pred 为真的元素
+inline auto filter = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() == 2 && "filter need 2 args: (pred, iterable)");
+    model::Iterator* src = model::iter_of(args->val[1]);
+    auto result = new model::FilterIter(args->val[0], src);
+    src->del_ref();
+    return result;
+};
+
+// take(iterable, n)：最多取前 n 个元素
+inline auto take = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() == 2 && "take need 2 args: (iterable, n)");
+    const deps::BigInt n = get_int_arg(args->val[1], "take 的 n 必须是 Int");
+    assert(n >= deps::BigInt(0) && n.fits_long_long() && "take 的 n 超出范围");
+    model::Iterator* src = model::iter_of(args->val[0]);
+    auto result = new model::TakeIter(src, static_cast<size_t>(n.to_long_long()));
+    src->del_ref();
+    return result;
+};
+
+// enumerate(iterable[, start])：产出 (下标, 元素)
+inline auto enumerate = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert((args->val.size() == 1 || args->val.size() == 2) && "enumerate need 1 or 2 args");
+    deps::BigInt start(0);
+    if (args->val.size() == 2) start = get_int_arg(args->val[1], "enumerate 的 start 必须是 Int");
+    model::Iterator* src = model::iter_of(args->val[0]);
+    auto result = new model::EnumerateIter(src, std::move(start));
+    src->del_ref();
+    return result;
+};
+
+// zip(a, b, ...)：并行遍历，最短者耗尽即结束
+inline auto zip = [](model::Object* self, const model::List* args) -> model::Object* {
+    std::vector<model::Iterator*> srcs;
+    srcs.reserve(args->val.size());
+    for (model::Object* arg : args->val) srcs.push_back(model::iter_of(arg));
+    auto result = new model::ZipIter(srcs);
+    for (model::Iterator* src : srcs) src->del_ref();
+    return result;
+};
+
+// list(iterable)：驱动迭代器并收集为 List（作为 list 类型对象的 __call__）
+inline auto list_of = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() <= 1 && "list need 0 or 1 arg");
+    std::vector<model::Object*> vals;
+    if (args->val.empty()) return new model::List(std::move(vals));
+    model::Iterator* it = model::iter_of(args->val[0]);
+    vals.reserve(it->size_hint());
+    while (model::Object* x = it->next()) vals.push_back(x);
+    it->del_ref();
+    return new model::List(std::move(vals));
+};
+
+// tuple(iterable)：驱动迭代器并收集为 Tuple（作为 tuple 类型对象的 __call__）
+inline auto tuple_of = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(args->val.size() <= 1 && "tuple need 0 or 1 arg");
+    std::vector<model::Object*> vals;
+    if (args->val.empty()) return new model::Tuple(vals);
+    model::Iterator* it = model::iter_of(args->val[0]);
+    vals.reserve(it->size_hint());
+    while (model::Object* x = it->next()) vals.push_back(x);
+    it->del_ref();
+    return new model::Tuple(vals);
+};
+
+// bytes(x) / bytearray(x)：x 为长度（全 0）、String（UTF-8 编码）、Bytes（复制）或产出 0~255 整数的可迭代对象
+inline model::Object* make_bytes(const model::List* args, const bool writable) {
+    assert(args->val.size() <= 1 && "bytes / bytearray need 0 or 1 arg");
+    if (args->val.empty()) return new model::Bytes(0, writable);
+    model::Object* src = args->val[0];
+    if (const auto n = dynamic_cast<const model::Int*>(src)) {
+        return new model::Bytes(model::get_size_arg(n, "bytes: 长度必须是非负整数"), writable);
+    }
+    if (const auto str_obj = dynamic_cast<const model::String*>(src)) {
+        return new model::Bytes(std::string_view(str_obj->val), writable);
+    }
+    if (const auto bytes_obj = dynamic_cast<const model::Bytes*>(src)) {
+        return new model::Bytes(bytes_obj->view(), writable);
+    }
+    std::string content;
+    model::Iterator* it = model::iter_of(src);
+    content.reserve(it->size_hint());
+    while (model::Object* x = it->next()) {
+        content.push_back(static_cast<char>(model::get_byte_arg(x)));
+        x->del_ref();
+    }
+    it->del_ref();
+    return new model::Bytes(std::string_view(content), writable);
+}
+
+// bytes 类型对象的 __call__：只读字节序列
+inline auto bytes_of = [](model::Object* self, const model::List* args) -> model::Object* {
+    return make_bytes(args, false);
+};
+
+// bytearray(x)：长度固定、可写的字节缓冲
+inline auto bytearray = [](model::Object* self, const model::List* args) -> model::Object* {
+    return make_bytes(args, true);
+};
+
+// sum(iterable[, start])：数值按 机器整数 → BigInt → Rational 逐级累加，其余类型调用 __add__
+inline auto sum = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert((args->val.size() == 1 || args->val.size() == 2) && "sum need 1 or 2 args");
+    model::Object* start = args->val.size() == 2 ? args->val[1] : nullptr;
+
+    // 裸 range 直接用闭式求和
+    if (auto range_it = dynamic_cast<model::RangeIter*>(args->val[0])) {
+        if (start == nullptr || dynamic_cast<model::Int*>(start)) {
+            deps::BigInt total = range_it->drain_sum();
+            if (start) total += static_cast<model::Int*>(start)->val;
+            return new model::Int(std::move(total));
+        }
+    }
+
+    enum class Mode { Small, Big, Rat, Generic } mode = Mode::Small;
+    long long small = 0;
+    deps::BigInt big(0);
+    deps::Rational rat;
+    model::Object* acc = nullptr;
+
+    const auto current_int = [&]() {
+        return mode == Mode::Small ? deps::BigInt::from_long_long(small) : big;
+    };
+    const auto materialize = [&]() -> model::Object* {
+        switch (mode) {
+            case Mode::Small: return new model::Int(deps::BigInt::from_long_long(small));
+            case Mode::Big: return new model::Int(big);
+            case Mode::Rat: return new model::Rational(rat);
+            default: return acc;
+        }
+    };
+    const auto add_value = [&](model::Object* x) {
+        if (mode != Mode::Generic) {
+            if (const auto x_int = dynamic_cast<model::Int*>(x)) {
+                long long next_small;
+                if (mode == Mode::Small && x_int->val.fits_long_long()
+                    && !deps::bits::add_overflow(small, x_int->val.to_long_long(), &next_small)) {
+                    small = next_small;
+                    return;
+                }
+                if (mode == Mode::Rat) {
+                    rat = rat + deps::Rational(x_int->val);
+                } else {
+                    big = current_int() + x_int->val;
+                    mode = Mode::Big;
+                }
+                return;
+            }
+            if (const auto x_rat = dynamic_cast<model::Rational*>(x)) {
+                if (mode != Mode::Rat) rat = deps::Rational(current_int());
+                rat = rat + x_rat->val;
+                mode = Mode::Rat;
+                return;
+            }
+            acc = materialize();
+            acc->make_ref();
+            mode = Mode::Generic;
+        }
+        model::Object* next_acc = kiz::Vm::invoke(kiz::Vm::get_attr(acc, "__add__"), new model::List({x}), acc);
+        acc->del_ref();
+        acc = next_acc;
+    };
+
+    if (start != nullptr) {
+        if (dynamic_cast<model::Int*>(start) || dynamic_cast<model::Rational*>(start)) {
+            add_value(start);
+        } else {
+            acc = start;
+            acc->make_ref();
+            mode = Mode::Generic;
+        }
+    }
+
+    model::Iterator* it = model::iter_of(args->val[0]);
+    while (model::Object* x = it->next()) {
+        add_value(x);
+        x->del_ref();
+    }
+    it->del_ref();
+    // 通用模式下 acc 持有一个引用：按 CppFunction 约定以 0 引用返回
+    model::Object* result = materialize();
+    if (mode == Mode::Generic) result->drop_ref();
+    return result;
+};
+
+// reduce(f, iterable[, init])：从左到右折叠 f(acc, x)
+inline auto reduce = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert((args->val.size() == 2 || args->val.size() == 3) && "reduce need 2 or 3 args: (func, iterable[, init])");
+    model::Object* func = args->val[0];
+    model::Iterator* it = model::iter_of(args->val[1]);
+
+    model::Object* acc = nullptr;
+    if (args->val.size() == 3) {
+        acc = args->val[2];
+        acc->make_ref();
+    } else {
+        acc = it->next();
+        assert(acc != nullptr && "reduce: 空序列且没有初始值");
+    }
+    while (model::Object* x = it->next()) {
+        model::Object* next_acc = kiz::Vm::invoke(func, new model::List({acc, x}));
+        acc->del_ref();
+        x->del_ref();
+        acc = next_acc;
+    }
+    it->del_ref();
+    // acc 持有一个引用：按 CppFunction 约定以 0 引用返回
+    acc->drop_ref();
+    return acc;
+};
+
+}  // namespace builtin_objects
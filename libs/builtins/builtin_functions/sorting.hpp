@@ -0,0 +1,170 @@
+/**
+ * @file sorting.hpp
+ * @brief List.sort / sorted：pdqsort + 按元素类型特化的比较器
+ * 键全为小整数、字符串或有理数时直接比较机器整数 / 字节串 / 有理数，不经过 __lt__ 调用；
+ * key 函数模式先为每个元素计算一次键再排序
+ * @author azhz1107cat
+ * @date 2025-12-20
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "models.hpp"
+#include "vm.hpp"
+#include "iterators.hpp"
+#include "../../../deps/pdqsort.hpp"
+
+namespace model {
+
+// 按 first 排序 (键, 元素) 对后写回 items；reverse 时交换比较参数（相等元素仍保持原顺序）
+template <typename T, typename Less>
+void sort_pairs(std::vector<Object*>& items, std::vector<std::pair<T, Object*>>& pairs,
+                Less less, const bool reverse, const bool stable) {
+    const auto run = [&](auto comp) {
+        if (stable) {
+            std::stable_sort(pairs.begin(), pairs.end(), comp);
+        } else {
+            deps::pdq::sort(pairs.begin(), pairs.end(), comp);
+        }
+    };
+    using P = std::pair<T, Object*>;
+    if (reverse) {
+        run([&less](const P& a, const P& b) { return less(b.first, a.first); });
+    } else {
+        run([&less](const P& a, const P& b) { return less(a.first, b.first); });
+    }
+    for (size_t i = 0; i < items.size(); ++i) items[i] = pairs[i].second;
+}
+
+// 对 items 原地排序，keys[i] 为 items[i] 的排序键（两者引用都归调用方）
+inline void sort_objects(std::vector<Object*>& items, const std::vector<Object*>& keys,
+                         const bool reverse, const bool stable) {
+    assert(items.size() == keys.size());
+    if (items.size() < 2) return;
+
+    // 扫描一遍键的类型，决定使用哪种比较器
+    bool all_small = true, all_int = true, all_num = true, all_str = true;
+    for (const Object* key : keys) {
+        const auto type = key->get_type();
+        if (type == Object::ObjectType::OT_Int) {
+            all_str = false;
+            if (all_small && !static_cast<const Int*>(key)->val.fits_long_long()) all_small = false;
+        } else if (type == Object::ObjectType::OT_Rational) {
+            all_small = all_int = all_str = false;
+        } else if (type == Object::ObjectType::OT_String) {
+            all_small = all_int = all_num = false;
+        } else {
+            all_small = all_int = all_num = all_str = false;
+            break;
+        }
+    }
+
+    const size_t n = items.size();
+    if (all_int && all_small) {
+        std::vector<std::pair<long long, Object*>> pairs;
+        pairs.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            pairs.emplace_back(static_cast<const Int*>(keys[i])->val.to_long_long(), items[i]);
+        }
+        sort_pairs(items, pairs, [](const long long a, const long long b) { return a < b; }, reverse, stable);
+    } else if (all_int) {
+        std::vector<std::pair<const deps::BigInt*, Object*>> pairs;
+        pairs.reserve(n);
+        for (size_t i = 0; i < n; ++i) pairs.emplace_back(&static_cast<const Int*>(keys[i])->val, items[i]);
+        sort_pairs(items, pairs, [](const deps::BigInt* a, const deps::BigInt* b) { return *a < *b; },
+                   reverse, stable);
+    } else if (all_num) {
+        // Int 与 Rational 混合：统一转为 Rational 比较
+        std::vector<std::pair<deps::Rational, Object*>> pairs;
+        pairs.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (const auto key_int = dynamic_cast<const Int*>(keys[i])) {
+                pairs.emplace_back(deps::Rational(key_int->val), items[i]);
+            } else {
+                pairs.emplace_back(static_cast<const Rational*>(keys[i])->val, items[i]);
+            }
+        }
+        sort_pairs(items, pairs, [](const deps::Rational& a, const deps::Rational& b) { return a < b; },
+                   reverse, stable);
+    } else if (all_str) {
+        // UTF-8 字节序即码点序
+        std::vector<std::pair<const std::string*, Object*>> pairs;
+        pairs.reserve(n);
+        for (size_t i = 0; i < n; ++i) pairs.emplace_back(&static_cast<const String*>(keys[i])->val, items[i]);
+        sort_pairs(items, pairs, [](const std::string* a, const std::string* b) { return *a < *b; },
+                   reverse, stable);
+    } else {
+        // 通用路径：调用键的 __lt__。比较代价高时归并排序的比较次数更少，
+        // 且用户定义的 __lt__ 不满足严格弱序时也不会越界，因此总是使用 stable_sort
+        std::vector<std::pair<Object*, Object*>> pairs;
+        pairs.reserve(n);
+        for (size_t i = 0; i < n; ++i) pairs.emplace_back(keys[i], items[i]);
+        const auto less = [](Object* a, Object* b) {
+            Object* result = kiz::Vm::invoke(kiz::Vm::get_attr(a, "__lt__"), new List({b}), a);
+            const bool truth = is_truthy(result);
+            result->del_ref();
+            return truth;
+        };
+        sort_pairs(items, pairs, less, reverse, true);
+    }
+}
+
+// 解析 (key, reverse, stable) 可选参数，对 items 排序。
+// key 为 Nil 或 nil（脚本里写得出的只有类型对象 nil）表示不用 key 函数：sorted(xs, nil, rev, stable)
+inline void sort_with_args(std::vector<Object*>& items, const List* args, const size_t first) {
+    Object* key_func = nullptr;
+    bool reverse = false, stable = false;
+    if (args->val.size() > first && args->val[first] != based_nil
+        && args->val[first]->get_type() != Object::ObjectType::OT_Nil) {
+        key_func = args->val[first];
+    }
+    if (args->val.size() > first + 1) reverse = is_truthy(args->val[first + 1]);
+    if (args->val.size() > first + 2) stable = is_truthy(args->val[first + 2]);
+
+    if (key_func == nullptr) {
+        sort_objects(items, items, reverse, stable);
+        return;
+    }
+    // key 模式：每个元素只调用一次 key 函数
+    std::vector<Object*> keys;
+    keys.reserve(items.size());
+    for (Object* item : items) keys.push_back(invoke_unary(key_func, item));
+    sort_objects(items, keys, reverse, stable);
+    for (Object* key : keys) key->del_ref();
+}
+
+// List.sort([key[, reverse[, stable]]])：原地排序，返回 Nil
+inline auto list_sort = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_sort)");
+    assert(args->val.size() <= 3 && "function List.sort need 0 to 3 args: ([key[, reverse[, stable]]])");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_sort must be called by List object");
+
+    sort_with_args(self_list->flat(), args, 0);
+    return new Nil();
+};
+
+}  // namespace model
+
+namespace builtin_objects {
+
+// sorted(iterable[, key[, reverse[, stable]]])：收集为新 List 后排序
+inline auto sorted = [](model::Object* self, const model::List* args) -> model::Object* {
+    assert(!args->val.empty() && args->val.size() <= 4
+           && "sorted need 1 to 4 args: (iterable[, key[, reverse[, stable]]])");
+    model::Iterator* it = model::iter_of(args->val[0]);
+    std::vector<model::Object*> vals;
+    vals.reserve(it->size_hint());
+    while (model::Object* x = it->next()) vals.push_back(x);
+    it->del_ref();
+
+    model::sort_with_args(vals, args, 1);
+    return new model::List(std::move(vals));
+};
+
+}  // namespace builtin_objects
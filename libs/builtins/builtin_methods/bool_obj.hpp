@@ -15,4 +15,12 @@ inline auto bool_eq = [](Object* self, const List* args) -> Object* {
     return new Bool(self_bool->val == another_bool->val);
 };
 
+// Bool.hash：返回哈希值
+inline auto bool_hash = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bool_hash)");
+    assert(args->val.empty() && "function Bool.hash need 0 arg");
+    assert(dynamic_cast<Bool*>(self) != nullptr && "bool_hash must be called by Bool object");
+    return new Int(deps::BigInt(hash_object(self)));
+};
+
 }  // namespace model
@@ -6,5 +6,9 @@
 #include "int_obj.hpp"
 #include "rational_obj.hpp"
 #include "str_obj.hpp"
+#include "str_builder_obj.hpp"
 #include "list_obj.hpp"
-#include "dict_obj.hpp"
\ No newline at end of file
+#include "dict_obj.hpp"
+#include "set_obj.hpp"
+#include "tuple_obj.hpp"
+#include "bytes_obj.hpp"
@@ -0,0 +1,268 @@
+#pragma once
+#include <limits>
+
+#include "models.hpp"
+
+namespace model {
+
+inline Bytes* get_bytes_self(Object* self, const char* method_name) {
+    auto self_bytes = dynamic_cast<Bytes*>(self);
+    if (self_bytes == nullptr) {
+        assert(false && (std::string(method_name) + " must be called by Bytes object").c_str());
+    }
+    return self_bytes;
+}
+
+// 非负整数参数（偏移、宽度等）
+inline size_t get_size_arg(const Object* obj, const char* msg) {
+    const auto int_obj = dynamic_cast<const Int*>(obj);
+    assert(int_obj != nullptr && int_obj->val.fits_long_long() && int_obj->val.to_long_long() >= 0 && msg);
+    return static_cast<size_t>(int_obj->val.to_long_long());
+}
+
+// 0~255 的单字节参数
+inline uint8_t get_byte_arg(const Object* obj) {
+    const auto int_obj = dynamic_cast<const Int*>(obj);
+    assert(int_obj != nullptr && int_obj->val.fits_long_long() && "字节值必须是 Int");
+    const long long v = int_obj->val.to_long_long();
+    assert(v >= 0 && v <= 255 && "字节值必须在 0~255 之间");
+    return static_cast<uint8_t>(v);
+}
+
+// 字节序参数："little"（缺省）或 "big"，返回是否大端
+inline bool get_byte_order_arg(const List* args, const size_t pos) {
+    if (args->val.size() <= pos) return false;
+    const auto order = dynamic_cast<const String*>(args->val[pos]);
+    assert(order != nullptr && (order->val == "little" || order->val == "big")
+           && "字节序必须是 \"little\" 或 \"big\"");
+    return order->val == "big";
+}
+
+// 按字节序读写 width（1/2/4/8）字节的无符号整数
+inline uint64_t load_uint(const uint8_t* p, const size_t width, const bool big_endian) {
+    uint64_t v = 0;
+    if (big_endian) {
+        for (size_t i = 0; i < width; ++i) v = v << 8 | p[i];
+    } else {
+        for (size_t i = width; i-- > 0;) v = v << 8 | p[i];
+    }
+    return v;
+}
+
+inline void store_uint(uint8_t* p, uint64_t v, const size_t width, const bool big_endian) {
+    for (size_t i = 0; i < width; ++i) {
+        p[big_endian ? width - 1 - i : i] = static_cast<uint8_t>(v & 0xff);
+        v >>= 8;
+    }
+}
+
+inline size_t get_width_arg(const Object* obj) {
+    const size_t width = get_size_arg(obj, "width 必须是非负整数");
+    assert((width == 1 || width == 2 || width == 4 || width == 8) && "width 只能是 1/2/4/8");
+    return width;
+}
+
+// Bytes.add：拼接，返回新的字节序列（可写性与 self 相同）
+inline auto bytes_add = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_add)");
+    assert(args->val.size() == 1 && "function Bytes.add need 1 arg");
+    Bytes* self_bytes = get_bytes_self(self, "bytes_add");
+
+    const auto other = dynamic_cast<const Bytes*>(args->val[0]);
+    assert(other != nullptr && "Bytes.add only supports Bytes type argument");
+
+    auto result = new Bytes(self_bytes->size() + other->size(), true);
+    uint8_t* dst = result->mutable_data();
+    std::copy(self_bytes->data(), self_bytes->data() + self_bytes->size(), dst);
+    std::copy(other->data(), other->data() + other->size(), dst + self_bytes->size());
+    result->writable = self_bytes->writable;
+    return result;
+};
+
+// Bytes.eq：按内容比较
+inline auto bytes_eq = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_eq)");
+    assert(args->val.size() == 1 && "function Bytes.eq need 1 arg");
+    get_bytes_self(self, "bytes_eq");
+    return new Bool(objects_equal(self, args->val[0]));
+};
+
+// Bytes.hash：只读字节序列按内容哈希
+inline auto bytes_hash = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_hash)");
+    assert(args->val.empty() && "function Bytes.hash need 0 arg");
+    get_bytes_self(self, "bytes_hash");
+    assert(is_hashable(self) && "Bytes.hash: bytearray 可变，不可哈希");
+    return new Int(deps::BigInt(hash_object(self)));
+};
+
+// Bytes.find：查找子序列（Bytes）或单个字节（Int），返回下标，找不到返回 -1
+inline auto bytes_find = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_find)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function Bytes.find need 1 or 2 args: (sub[, start])");
+    Bytes* self_bytes = get_bytes_self(self, "bytes_find");
+
+    const size_t start = args->val.size() == 2 ? get_size_arg(args->val[1], "Bytes.find: start 必须是非负整数") : 0;
+    const std::string_view hay = self_bytes->view();
+    size_t pos;
+    if (const auto sub = dynamic_cast<const Bytes*>(args->val[0])) {
+        pos = hay.find(sub->view(), start);
+    } else {
+        pos = hay.find(static_cast<char>(get_byte_arg(args->val[0])), start);
+    }
+    return new Int(deps::BigInt::from_long_long(pos == std::string_view::npos ? -1 : static_cast<long long>(pos)));
+};
+
+// Bytes.contains：x in self（x 为子序列或单个字节）
+inline auto bytes_contains = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_contains)");
+    assert(args->val.size() == 1 && "function Bytes.contains need 1 arg");
+    Bytes* self_bytes = get_bytes_self(self, "bytes_contains");
+
+    if (const auto sub = dynamic_cast<const Bytes*>(args->val[0])) {
+        return new Bool(self_bytes->view().find(sub->view()) != std::string_view::npos);
+    }
+    return new Bool(self_bytes->view().find(static_cast<char>(get_byte_arg(args->val[0]))) != std::string_view::npos);
+};
+
+// Bytes.getitem：self[i] 返回 Int；self[a:b] 返回共享缓冲的视图（不复制）
+inline auto bytes_getitem = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_getitem)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function Bytes.getitem need 1 or 2 args");
+    Bytes* self_bytes = get_bytes_self(self, "bytes_getitem");
+
+    if (args->val.size() == 2) {
+        const auto [begin, end] = normalize_slice(args->val[0], args->val[1], self_bytes->size());
+        return self_bytes->slice(begin, end);
+    }
+
+    auto idx_int = dynamic_cast<Int*>(args->val[0]);
+    assert(idx_int != nullptr && "Bytes.getitem index must be Int type");
+    return new Int(deps::BigInt::from_long_long(self_bytes->data()[normalize_index(idx_int->val, self_bytes->size())]));
+};
+
+// Bytes.setitem：self[i] = x（仅 bytearray）
+inline auto bytes_setitem = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_setitem)");
+    assert(args->val.size() == 2 && "function Bytes.setitem need 2 args: (index: Int, value: Int)");
+    Bytes* self_bytes = get_bytes_self(self, "bytes_setitem");
+
+    auto idx_int = dynamic_cast<Int*>(args->val[0]);
+    assert(idx_int != nullptr && "Bytes.setitem index must be Int type");
+    self_bytes->mutable_data()[normalize_index(idx_int->val, self_bytes->size())] = get_byte_arg(args->val[1]);
+    return new Nil();
+};
+
+// Bytes.unpack_int(offset, width[, order[, signed]])：从 offset 处读取定宽整数
+inline auto bytes_unpack_int = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_unpack_int)");
+    assert(args->val.size() >= 2 && args->val.size() <= 4
+           && "function Bytes.unpack_int need 2 to 4 args: (offset, width[, order[, signed]])");
+    Bytes* self_bytes = get_bytes_self(self, "bytes_unpack_int");
+
+    const size_t offset = get_size_arg(args->val[0], "Bytes.unpack_int: offset 必须是非负整数");
+    const size_t width = get_width_arg(args->val[1]);
+    const bool big_endian = get_byte_order_arg(args, 2);
+    bool is_signed = false;
+    if (args->val.size() == 4) {
+        const auto flag = dynamic_cast<const Bool*>(args->val[3]);
+        assert(flag != nullptr && "Bytes.unpack_int: signed 必须是 Bool");
+        is_signed = flag->val;
+    }
+    assert(offset + width <= self_bytes->size() && "Bytes.unpack_int: 读取越界");
+
+    const uint64_t v = load_uint(self_bytes->data() + offset, width, big_endian);
+    if (is_signed) {
+        // 符号扩展到 64 位
+        const unsigned shift = 64 - 8 * static_cast<unsigned>(width);
+        return new Int(deps::BigInt::from_long_long(static_cast<int64_t>(v << shift) >> shift));
+    }
+    if (v <= static_cast<uint64_t>(std::numeric_limits<long long>::max())) {
+        return new Int(deps::BigInt::from_long_long(static_cast<long long>(v)));
+    }
+    return new Int(deps::BigInt(static_cast<size_t>(v)));
+};
+
+// Bytes.pack_int(offset, value, width[, order])：把整数按定宽写入 offset 处（仅 bytearray）
+// value 可以是有符号或无符号表示，须落在 [-2^(8w-1), 2^(8w)) 内
+inline auto bytes_pack_int = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_pack_int)");
+    assert(args->val.size() >= 3 && args->val.size() <= 4
+           && "function Bytes.pack_int need 3 or 4 args: (offset, value, width[, order])");
+    Bytes* self_bytes = get_bytes_self(self, "bytes_pack_int");
+
+    const size_t offset = get_size_arg(args->val[0], "Bytes.pack_int: offset 必须是非负整数");
+    const auto value = dynamic_cast<const Int*>(args->val[1]);
+    assert(value != nullptr && "Bytes.pack_int: value 必须是 Int");
+    const size_t width = get_width_arg(args->val[2]);
+    const bool big_endian = get_byte_order_arg(args, 3);
+    assert(offset + width <= self_bytes->size() && "Bytes.pack_int: 写入越界");
+
+    uint64_t bits;
+    if (value->val.fits_long_long()) {
+        const long long x = value->val.to_long_long();
+        if (width < 8) {
+            const long long bound = 1LL << (8 * width - 1);
+            assert(x >= -bound && x < bound * 2 && "Bytes.pack_int: value 超出宽度范围");
+        }
+        bits = static_cast<uint64_t>(x);
+    } else {
+        // [2^63, 2^64)：减去 2^64 后按补码写入
+        const deps::BigInt half(static_cast<size_t>(1) << 63);
+        const deps::BigInt shifted = value->val - half - half;
+        assert(width == 8 && shifted.fits_long_long() && shifted.to_long_long() < 0
+               && "Bytes.pack_int: value 超出宽度范围");
+        bits = static_cast<uint64_t>(shifted.to_long_long());
+    }
+    store_uint(self_bytes->mutable_data() + offset, bits, width, big_endian);
+    return new Nil();
+};
+
+// Bytes.decode：按 UTF-8 解码为 String
+inline auto bytes_decode = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_decode)");
+    assert(args->val.empty() && "function Bytes.decode need 0 arg");
+    return new String(std::string(get_bytes_self(self, "bytes_decode")->view()));
+};
+
+// Bytes.hex：十六进制字符串
+inline auto bytes_hex = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_hex)");
+    assert(args->val.empty() && "function Bytes.hex need 0 arg");
+    static constexpr char hex_digits[] = "0123456789abcdef";
+    const Bytes* self_bytes = get_bytes_self(self, "bytes_hex");
+
+    std::string out;
+    out.reserve(self_bytes->size() * 2);
+    for (size_t i = 0; i < self_bytes->size(); ++i) {
+        out += hex_digits[self_bytes->data()[i] >> 4];
+        out += hex_digits[self_bytes->data()[i] & 0xf];
+    }
+    return new String(std::move(out));
+};
+
+// Bytes.copy：复制出独立的缓冲（切片默认共享缓冲，需要脱离原缓冲时使用）
+inline auto bytes_copy = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_copy)");
+    assert(args->val.empty() && "function Bytes.copy need 0 arg");
+    const Bytes* self_bytes = get_bytes_self(self, "bytes_copy");
+    return new Bytes(self_bytes->view(), self_bytes->writable);
+};
+
+// Bytes.to_list：导出为 Int 列表
+inline auto bytes_to_list = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (bytes_to_list)");
+    assert(args->val.empty() && "function Bytes.to_list need 0 arg");
+    const Bytes* self_bytes = get_bytes_self(self, "bytes_to_list");
+
+    std::vector<Object*> elems;
+    elems.reserve(self_bytes->size());
+    for (size_t i = 0; i < self_bytes->size(); ++i) {
+        auto elem = new Int(deps::BigInt::from_long_long(self_bytes->data()[i]));
+        elem->make_ref();
+        elems.push_back(elem);
+    }
+    return new List(std::move(elems));
+};
+
+}  // namespace model
@@ -3,41 +3,106 @@
 
 namespace model {
 
-// Dictionary.add：添加键值对 self + x（key: String，value: 任意Object），返回新Dictionary（不可变语义）
+// 非 String 键写入 items：新键持有引用，旧值释放引用
+inline void dict_store_item(Dictionary* dict, Object* key, Object* value) {
+    assert(is_hashable(key) && "Dictionary key must be hashable");
+    value->make_ref();
+    auto [slot, inserted] = dict->items.emplace(key);
+    if (inserted) {
+        key->make_ref();
+    } else if (*slot != nullptr) {
+        (*slot)->del_ref();
+    }
+    *slot = value;
+}
+
+// 查找任意可哈希键对应的值，不存在返回 nullptr
+inline Object* dict_lookup(const Dictionary* dict, Object* key) {
+    if (const auto key_str = dynamic_cast<const String*>(key);
+        key_str != nullptr && !Dictionary::is_reserved_key(key_str->val)) {
+        const auto node = dict->attrs.find_in_current(key_str->val, key_str->hash());
+        return node ? node->value : nullptr;
+    }
+    if (!is_hashable(key)) return nullptr;
+    Object** slot = dict->items.find(key);
+    return slot ? *slot : nullptr;
+}
+
+// Dictionary.add：添加键值对 self + x（key: 可哈希对象，value: 任意Object），返回新Dictionary（不可变语义）
 inline auto dict_add = [](Object* self, const List* args) -> Object* {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (dict_add)");
-    assert(args->val.size() == 2 && "function Dictionary.add need 2 args: (key: String, value: Object)");
+    assert(args->val.size() == 2 && "function Dictionary.add need 2 args: (key, value)");
     
     auto self_dict = dynamic_cast<Dictionary*>(self);
     assert(self_dict != nullptr && "dict_add must be called by Dictionary object");
     
-    auto key_obj = dynamic_cast<String*>(args->val[0]);
-    assert(key_obj != nullptr && "Dictionary.add key must be String type");
+    Object* key = args->val[0];
+    assert(is_hashable(key) && "Dictionary.add key must be hashable");
     
     Object* value_obj = args->val[1];
     
     // 复制原字典的attrs（返回新字典）
     deps::HashMap<Object*> new_attrs = self_dict->attrs;
+    auto key_obj = dynamic_cast<String*>(key);
+    if (key_obj != nullptr && Dictionary::is_reserved_key(key_obj->val)) key_obj = nullptr;
     // 插入新键值对
-    new_attrs.insert(key_obj->val, value_obj);
+    if (key_obj != nullptr) new_attrs.insert(key_obj->val, value_obj, key_obj->hash());
     
-    return new Dictionary(new_attrs);
+    auto new_dict = new Dictionary(new_attrs);
+    self_dict->items.for_each([new_dict](Object* k, Object* v) {
+        k->make_ref();
+        if (v != nullptr) v->make_ref();
+        *new_dict->items.emplace(k).first = v;
+    });
+    if (key_obj == nullptr) dict_store_item(new_dict, key, value_obj);
+    return new_dict;
 };
 
-// Dictionary.contains：x in self 判断是否包含指定键（key: String），返回Bool
+// Dictionary.contains：x in self 判断是否包含指定键（key: 可哈希对象），返回Bool
 inline auto dict_contains = [](Object* self, const List* args) -> Object* {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (dict_contains)");
-    assert(args->val.size() == 1 && "function Dictionary.contains need 1 arg: (key: String)");
+    assert(args->val.size() == 1 && "function Dictionary.contains need 1 arg: (key)");
     
     auto self_dict = dynamic_cast<Dictionary*>(self);
     assert(self_dict != nullptr && "dict_contains must be called by Dictionary object");
     
-    // 键必须是String类型
+    return new Bool(dict_lookup(self_dict, args->val[0]) != nullptr);
+};
+
+// Dictionary.getitem：按键取值 self[key]（key: 可哈希对象）
+inline auto dict_getitem = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (dict_getitem)");
+    assert(args->val.size() == 1 && "function Dictionary.getitem need 1 arg: (key)");
+
+    auto self_dict = dynamic_cast<Dictionary*>(self);
+    assert(self_dict != nullptr && "dict_getitem must be called by Dictionary object");
+
+    Object* value = dict_lookup(self_dict, args->val[0]);
+    assert(value != nullptr && "Dictionary.getitem: 字典中无此键");
+    return value;
+};
+
+// Dictionary.setitem：按键赋值 self[key] = value（原地修改）
+inline auto dict_setitem = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (dict_setitem)");
+    assert(args->val.size() == 2 && "function Dictionary.setitem need 2 args: (key, value)");
+
+    auto self_dict = dynamic_cast<Dictionary*>(self);
+    assert(self_dict != nullptr && "dict_setitem must be called by Dictionary object");
+
     auto key_obj = dynamic_cast<String*>(args->val[0]);
-    assert(key_obj != nullptr && "Dictionary.contains key must be String type");
-    
-    auto found_node = self_dict->attrs.find_in_current(key_obj->val);
-    return new Bool(found_node != nullptr);
+    if (key_obj == nullptr || Dictionary::is_reserved_key(key_obj->val)) {
+        dict_store_item(self_dict, args->val[0], args->val[1]);
+        return new Nil();
+    }
+
+    auto found_node = self_dict->attrs.find_in_current(key_obj->val, key_obj->hash());
+    args->val[1]->make_ref();
+    if (found_node != nullptr && found_node->value != nullptr) {
+        found_node->value->del_ref();
+    }
+    self_dict->attrs.insert(key_obj->val, args->val[1], key_obj->hash());
+    return new Nil();
 };
 
 }  // namespace model
\ No newline at end of file
@@ -159,4 +159,12 @@ inline auto int_gt = [](Object* self, const List* args) -> Object* {
     assert(false && "function Int.gt second arg need be Rational or Int");
 };
 
+// Int.hash：按数值返回哈希值
+inline auto int_hash = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (int_hash)");
+    assert(args->val.empty() && "function Int.hash need 0 arg");
+    assert(dynamic_cast<Int*>(self) != nullptr && "int_hash must be called by Int object");
+    return new Int(deps::BigInt(hash_object(self)));
+};
+
 }  // namespace model
\ No newline at end of file
@@ -4,6 +4,7 @@
 namespace model {
 
 //  List.add：拼接另一个List（self + 传入List，返回新List）
+//  结果较短时复制成扁平List；否则拼接两侧的持久化视图，与两侧共享树节点（O(log n)）
 inline auto list_add = [](Object* self, const List* args) -> Object* {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_add)");
     assert(args->val.size() == 1 && "function List.add need 1 arg");
@@ -14,9 +15,17 @@ inline auto list_add = [](Object* self, const List* args) -> Object* {
     auto another_list = dynamic_cast<List*>(args->val[0]);
     assert(another_list != nullptr && "List.add only supports List type argument");
     
-    // 浅拷贝
-    std::vector<Object*> new_vals = self_list->val;
+    const size_t total = self_list->size() + another_list->size();
+    if (self_list->persistent || another_list->persistent || total > List::persistent_threshold) {
+        return List::from_shared(deps::RrbVector<Object*>::concat(self_list->shared(), another_list->shared()));
+    }
+
+    // 浅拷贝（预先分配结果大小，只分配一次）
+    std::vector<Object*> new_vals;
+    new_vals.reserve(total);
+    new_vals.insert(new_vals.end(), self_list->val.begin(), self_list->val.end());
     new_vals.insert(new_vals.end(), another_list->val.begin(), another_list->val.end());
+    for (Object* elem : new_vals) elem->make_ref();
     
     return new List(std::move(new_vals));
 };
@@ -33,11 +42,17 @@ inline auto list_mul = [](Object* self, const List* args) -> Object* {
     assert(times_int != nullptr && "List.mul only supports Int type argument");
     assert(times_int->val >= deps::BigInt(0) && "List.mul requires non-negative integer argument");
     
+    assert(times_int->val.fits_long_long() && "List.mul argument too large");
+    
+    // 使用机器整数计数，并预先分配结果大小
+    const auto times = static_cast<size_t>(times_int->val.to_long_long());
+    const std::vector<Object*>& items = self_list->flat();
     std::vector<Object*> new_vals;
-    deps::BigInt times = times_int->val;
-    for (deps::BigInt i = deps::BigInt(0); i < times; i+=deps::BigInt(1)) {
-        new_vals.insert(new_vals.end(), self_list->val.begin(), self_list->val.end());
+    new_vals.reserve(items.size() * times);
+    for (size_t i = 0; i < times; ++i) {
+        new_vals.insert(new_vals.end(), items.begin(), items.end());
     }
+    for (Object* elem : new_vals) elem->make_ref();
     
     return new List(std::move(new_vals));
 };
@@ -54,14 +69,14 @@ inline auto list_eq = [](Object* self, const List* args) -> Object* {
     assert(another_list != nullptr && "List.eq only supports List type argument");
     
     // 比较元素个数，不同直接返回false
-    if (self_list->val.size() != another_list->val.size()) {
+    if (self_list->size() != another_list->size()) {
         return new Bool(false);
     }
     
     // 逐个比较元素（类型一致 + 值相等才视为相等）
-    for (size_t i = 0; i < self_list->val.size(); ++i) {
-        Object* self_elem = self_list->val[i];
-        Object* another_elem = another_list->val[i];
+    for (size_t i = 0; i < self_list->size(); ++i) {
+        Object* self_elem = self_list->at(i);
+        Object* another_elem = another_list->at(i);
 
         // todo : finish self_elem.magic_eq(another_elem)
     }
@@ -80,27 +95,9 @@ inline auto list_contains = [](Object* self, const List* args) -> Object* {
     Object* target_elem = args->val[0];
     assert(target_elem != nullptr && "List.contains target argument cannot be nullptr");
     
-    // 遍历列表元素，逐个判断是否与目标元素相等
-    for (Object* elem : self_list->val) {
-        bool elem_equal = false;
-        
-        // 按元素类型匹配校验（与list_eq逻辑完全一致，确保行为统一）
-        if (auto elem_int = dynamic_cast<Int*>(elem); elem_int) {
-            auto target_int = dynamic_cast<Int*>(target_elem);
-            elem_equal = (target_int && elem_int->val == target_int->val);
-        } else if (auto elem_bool = dynamic_cast<Bool*>(elem); elem_bool) {
-            auto target_bool = dynamic_cast<Bool*>(target_elem);
-            elem_equal = (target_bool && elem_bool->val == target_bool->val);
-        } else if (auto elem_nil = dynamic_cast<Nil*>(elem); elem_nil) {
-            auto target_nil = dynamic_cast<Nil*>(target_elem);
-            elem_equal = (target_nil != nullptr);
-        } else if (auto elem_str = dynamic_cast<String*>(elem); elem_str) {
-            auto target_str = dynamic_cast<String*>(target_elem);
-            elem_equal = (target_str && elem_str->val == target_str->val);
-        }
-        
-        // 找到匹配元素，立即返回true
-        if (elem_equal) {
+    // 遍历列表元素，用原生比较判断相等（不经过 __eq__，不为每次比较分配 Bool）
+    for (size_t i = 0; i < self_list->size(); ++i) {
+        if (objects_equal(self_list->at(i), target_elem)) {
             return new Bool(true);
         }
     }
@@ -109,4 +106,199 @@ inline auto list_contains = [](Object* self, const List* args) -> Object* {
     return new Bool(false);
 };
 
+// List.getitem：下标取值 self[i] / 切片 self[a:b]（切片返回新List，持久化表示下共享结构）
+inline auto list_getitem = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_getitem)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function List.getitem need 1 or 2 args");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_getitem must be called by List object");
+
+    if (args->val.size() == 2) {
+        const auto [begin, end] = normalize_slice(args->val[0], args->val[1], self_list->size());
+        return self_list->slice(begin, end);
+    }
+
+    auto idx_int = dynamic_cast<Int*>(args->val[0]);
+    assert(idx_int != nullptr && "List.getitem index must be Int type");
+    return self_list->at(normalize_index(idx_int->val, self_list->size()));
+};
+
+// List.setitem：下标赋值 self[i] = x
+inline auto list_setitem = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_setitem)");
+    assert(args->val.size() == 2 && "function List.setitem need 2 args: (index: Int, value: Object)");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_setitem must be called by List object");
+
+    auto idx_int = dynamic_cast<Int*>(args->val[0]);
+    assert(idx_int != nullptr && "List.setitem index must be Int type");
+
+    std::vector<Object*>& items = self_list->flat();
+    Object*& slot = items[normalize_index(idx_int->val, items.size())];
+    args->val[1]->make_ref();
+    if (slot != nullptr) slot->del_ref();
+    slot = args->val[1];
+    return new Nil();
+};
+
+// List.append：原地追加元素 self.append(x)（均摊 O(1)）
+inline auto list_append = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_append)");
+    assert(args->val.size() == 1 && "function List.append need 1 arg");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_append must be called by List object");
+
+    args->val[0]->make_ref();
+    self_list->flat().push_back(args->val[0]);
+    return new Nil();
+};
+
+// List.reserve：预留容量 self.reserve(n)，避免后续追加时反复扩容
+inline auto list_reserve = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_reserve)");
+    assert(args->val.size() == 1 && "function List.reserve need 1 arg");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_reserve must be called by List object");
+
+    auto cap_int = dynamic_cast<Int*>(args->val[0]);
+    assert(cap_int != nullptr && "List.reserve only supports Int type argument");
+    assert(cap_int->val >= deps::BigInt(0) && cap_int->val.fits_long_long() && "List.reserve requires non-negative integer argument");
+
+    self_list->flat().reserve(static_cast<size_t>(cap_int->val.to_long_long()));
+    return new Nil();
+};
+
+// List.pop：原地弹出并返回元素 self.pop() / self.pop(i)（默认弹出末尾，O(1)）
+inline auto list_pop = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_pop)");
+    assert(args->val.size() <= 1 && "function List.pop need 0 or 1 arg");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_pop must be called by List object");
+    std::vector<Object*>& items = self_list->flat();
+    assert(!items.empty() && "List.pop from empty list");
+
+    size_t idx = items.size() - 1;
+    if (args->val.size() == 1) {
+        auto idx_int = dynamic_cast<Int*>(args->val[0]);
+        assert(idx_int != nullptr && "List.pop index must be Int type");
+        idx = normalize_index(idx_int->val, items.size());
+    }
+
+    // 放弃列表持有的引用，按 CppFunction 约定以 0 引用返回（由调用方 make_ref）
+    Object* elem = items[idx];
+    items.erase(items.begin() + static_cast<std::ptrdiff_t>(idx));
+    elem->drop_ref();
+    return elem;
+};
+
+// List.extend：原地拼接另一个List self.extend(xs)（按目标大小一次性扩容）
+inline auto list_extend = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_extend)");
+    assert(args->val.size() == 1 && "function List.extend need 1 arg");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_extend must be called by List object");
+
+    auto another_list = dynamic_cast<List*>(args->val[0]);
+    assert(another_list != nullptr && "List.extend only supports List type argument");
+
+    // 先复制再追加：self.extend(self) 时避免迭代器失效
+    std::vector<Object*> new_vals;
+    new_vals.reserve(another_list->size());
+    for (size_t i = 0; i < another_list->size(); ++i) new_vals.push_back(another_list->at(i));
+    std::vector<Object*>& items = self_list->flat();
+    items.reserve(items.size() + new_vals.size());
+    for (Object* elem : new_vals) {
+        elem->make_ref();
+        items.push_back(elem);
+    }
+    return new Nil();
+};
+
+// List.insert：原地插入元素 self.insert(i, x)
+inline auto list_insert = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_insert)");
+    assert(args->val.size() == 2 && "function List.insert need 2 args: (index: Int, value: Object)");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_insert must be called by List object");
+
+    auto idx_int = dynamic_cast<Int*>(args->val[0]);
+    assert(idx_int != nullptr && "List.insert index must be Int type");
+
+    // 与切片边界一致：越界下标裁剪到 [0, len]
+    std::vector<Object*>& items = self_list->flat();
+    const size_t idx = normalize_slice(idx_int, nullptr, items.size()).first;
+    args->val[1]->make_ref();
+    items.insert(items.begin() + static_cast<std::ptrdiff_t>(idx), args->val[1]);
+    return new Nil();
+};
+
+// List.clear：原地清空 self.clear()（保留已分配容量）
+inline auto list_clear = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_clear)");
+    assert(args->val.empty() && "function List.clear need 0 arg");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_clear must be called by List object");
+
+    if (self_list->persistent) {
+        // 树节点可能与其他List共享，只丢弃本List的视图
+        self_list->pvec = {};
+        self_list->persistent = false;
+        return new Nil();
+    }
+    for (Object* elem : self_list->val) {
+        if (elem != nullptr) elem->del_ref();
+    }
+    self_list->val.clear();
+    return new Nil();
+};
+
+// List.appended：返回追加了 x 的新List，不修改 self（持久化表示下 O(log n)，与 self 共享结构）
+inline auto list_appended = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_appended)");
+    assert(args->val.size() == 1 && "function List.appended need 1 arg");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_appended must be called by List object");
+
+    args->val[0]->make_ref();
+    if (!self_list->persistent && self_list->val.size() < List::persistent_threshold) {
+        std::vector<Object*> new_vals = self_list->val;
+        for (Object* elem : new_vals) elem->make_ref();
+        new_vals.push_back(args->val[0]);
+        return new List(std::move(new_vals));
+    }
+    return List::from_shared(self_list->shared().push_back(args->val[0]));
+};
+
+// List.updated：返回下标 i 处替换为 x 的新List，不修改 self（持久化表示下只复制一条路径）
+inline auto list_updated = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (list_updated)");
+    assert(args->val.size() == 2 && "function List.updated need 2 args: (index: Int, value: Object)");
+
+    auto self_list = dynamic_cast<List*>(self);
+    assert(self_list != nullptr && "list_updated must be called by List object");
+
+    auto idx_int = dynamic_cast<Int*>(args->val[0]);
+    assert(idx_int != nullptr && "List.updated index must be Int type");
+
+    const size_t idx = normalize_index(idx_int->val, self_list->size());
+    args->val[1]->make_ref();
+    if (!self_list->persistent && self_list->val.size() <= List::persistent_threshold) {
+        std::vector<Object*> new_vals = self_list->val;
+        for (Object* elem : new_vals) elem->make_ref();
+        new_vals[idx]->del_ref();
+        new_vals[idx] = args->val[1];
+        return new List(std::move(new_vals));
+    }
+    return List::from_shared(self_list->shared().set(idx, args->val[1]));
+};
+
 }  // namespace model
@@ -16,4 +16,12 @@ inline auto nil_eq = [](Object* self, const List* args) -> Object* {
     return new Bool(another_nil != nullptr);
 };
 
+// Nil.hash：Nil 的哈希值为常量
+inline auto nil_hash = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (nil_hash)");
+    assert(args->val.empty() && "function Nil.hash need 0 arg");
+    assert(dynamic_cast<Nil*>(self) != nullptr && "nil_hash must be called by Nil object");
+    return new Int(deps::BigInt(hash_object(self)));
+};
+
 }  // namespace model
@@ -160,4 +160,12 @@ inline auto rational_gt = [](Object* self, const List* args) -> Object* {
     assert(false && "function Rational.gt second arg need be Rational or Int");
 };
 
+// Rational.hash：由约分后的分子、分母求哈希值
+inline auto rational_hash = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (rational_hash)");
+    assert(args->val.empty() && "function Rational.hash need 0 arg");
+    assert(dynamic_cast<Rational*>(self) != nullptr && "rational_hash must be called by Rational object");
+    return new Int(deps::BigInt(hash_object(self)));
+};
+
 }  // namespace model
\ No newline at end of file
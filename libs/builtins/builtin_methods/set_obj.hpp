@@ -0,0 +1,118 @@
+#pragma once
+#include "models.hpp"
+
+namespace model {
+
+// Set.add：加入元素（已存在则忽略，原地修改）
+inline auto set_add = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (set_add)");
+    assert(args->val.size() == 1 && "function Set.add need 1 arg");
+
+    auto self_set = dynamic_cast<Set*>(self);
+    assert(self_set != nullptr && "set_add must be called by Set object");
+
+    self_set->add(args->val[0]);
+    return new Nil();
+};
+
+// Set.remove：移除元素（元素不存在时报错）
+inline auto set_remove = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (set_remove)");
+    assert(args->val.size() == 1 && "function Set.remove need 1 arg");
+
+    auto self_set = dynamic_cast<Set*>(self);
+    assert(self_set != nullptr && "set_remove must be called by Set object");
+
+    const bool removed = self_set->remove(args->val[0]);
+    assert(removed && "Set.remove: 集合中无此元素");
+    return new Nil();
+};
+
+// Set.discard：移除元素（不存在则忽略），返回是否移除
+inline auto set_discard = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (set_discard)");
+    assert(args->val.size() == 1 && "function Set.discard need 1 arg");
+
+    auto self_set = dynamic_cast<Set*>(self);
+    assert(self_set != nullptr && "set_discard must be called by Set object");
+
+    return new Bool(is_hashable(args->val[0]) && self_set->remove(args->val[0]));
+};
+
+// Set.contains：x in self
+inline auto set_contains = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (set_contains)");
+    assert(args->val.size() == 1 && "function Set.contains need 1 arg");
+
+    auto self_set = dynamic_cast<Set*>(self);
+    assert(self_set != nullptr && "set_contains must be called by Set object");
+
+    return new Bool(self_set->contains(args->val[0]));
+};
+
+// Set.union / intersection / difference：返回新Set，不修改原对象
+inline auto set_union = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (set_union)");
+    assert(args->val.size() == 1 && "function Set.union need 1 arg");
+
+    auto self_set = dynamic_cast<Set*>(self);
+    auto other_set = dynamic_cast<Set*>(args->val[0]);
+    assert(self_set != nullptr && other_set != nullptr && "Set.union only supports Set type argument");
+
+    auto result = new Set();
+    result->val.reserve(self_set->val.size() + other_set->val.size());
+    self_set->val.for_each([result](Object* elem, const deps::Unit&) { result->add(elem); });
+    other_set->val.for_each([result](Object* elem, const deps::Unit&) { result->add(elem); });
+    return result;
+};
+
+inline auto set_intersection = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (set_intersection)");
+    assert(args->val.size() == 1 && "function Set.intersection need 1 arg");
+
+    auto self_set = dynamic_cast<Set*>(self);
+    auto other_set = dynamic_cast<Set*>(args->val[0]);
+    assert(self_set != nullptr && other_set != nullptr && "Set.intersection only supports Set type argument");
+
+    // 遍历较小的一方，在较大的一方中查找
+    if (other_set->val.size() < self_set->val.size()) std::swap(self_set, other_set);
+    auto result = new Set();
+    self_set->val.for_each([result, other_set](Object* elem, const deps::Unit&) {
+        if (other_set->val.contains(elem)) result->add(elem);
+    });
+    return result;
+};
+
+inline auto set_difference = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (set_difference)");
+    assert(args->val.size() == 1 && "function Set.difference need 1 arg");
+
+    auto self_set = dynamic_cast<Set*>(self);
+    auto other_set = dynamic_cast<Set*>(args->val[0]);
+    assert(self_set != nullptr && other_set != nullptr && "Set.difference only supports Set type argument");
+
+    auto result = new Set();
+    self_set->val.for_each([result, other_set](Object* elem, const deps::Unit&) {
+        if (!other_set->val.contains(elem)) result->add(elem);
+    });
+    return result;
+};
+
+// Set.to_list：导出为List（顺序不保证）
+inline auto set_to_list = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (set_to_list)");
+    assert(args->val.empty() && "function Set.to_list need 0 arg");
+
+    auto self_set = dynamic_cast<Set*>(self);
+    assert(self_set != nullptr && "set_to_list must be called by Set object");
+
+    std::vector<Object*> elems;
+    elems.reserve(self_set->val.size());
+    self_set->val.for_each([&elems](Object* elem, const deps::Unit&) {
+        elem->make_ref();
+        elems.push_back(elem);
+    });
+    return new List(std::move(elems));
+};
+
+}  // namespace model
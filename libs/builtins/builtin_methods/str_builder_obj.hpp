@@ -0,0 +1,68 @@
+#pragma once
+#include "models.hpp"
+
+namespace model {
+
+// 工具函数：取追加到字符串中的文本（String 取原始内容，其余对象取 to_string）
+inline void append_text(std::string& buf, const Object* obj) {
+    if (const auto str_obj = dynamic_cast<const String*>(obj)) {
+        buf += str_obj->val;
+    } else {
+        buf += obj->to_string();
+    }
+}
+
+// StringBuilder.append：在末尾追加一个或多个对象（原地修改，均摊 O(1)）
+inline auto str_builder_append = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_builder_append)");
+    assert(!args->val.empty() && "function StringBuilder.append need at least 1 arg");
+
+    auto self_sb = dynamic_cast<StringBuilder*>(self);
+    assert(self_sb != nullptr && "str_builder_append must be called by StringBuilder object");
+
+    for (const Object* arg : args->val) append_text(self_sb->buf, arg);
+    return new Nil();
+};
+
+// StringBuilder.reserve：预留容量（字节数）
+inline auto str_builder_reserve = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_builder_reserve)");
+    assert(args->val.size() == 1 && "function StringBuilder.reserve need 1 arg");
+
+    auto self_sb = dynamic_cast<StringBuilder*>(self);
+    assert(self_sb != nullptr && "str_builder_reserve must be called by StringBuilder object");
+
+    auto cap_int = dynamic_cast<Int*>(args->val[0]);
+    assert(cap_int != nullptr && "StringBuilder.reserve only supports Int type argument");
+    assert(cap_int->val >= deps::BigInt(0) && cap_int->val.fits_long_long() && "StringBuilder.reserve argument out of range");
+
+    self_sb->buf.reserve(static_cast<size_t>(cap_int->val.to_long_long()));
+    return new Nil();
+};
+
+// StringBuilder.len：当前字节长度
+inline auto str_builder_len = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_builder_len)");
+    auto self_sb = dynamic_cast<StringBuilder*>(self);
+    assert(self_sb != nullptr && "str_builder_len must be called by StringBuilder object");
+    return new Int(deps::BigInt(self_sb->buf.size()));
+};
+
+// StringBuilder.clear：清空内容（保留容量，便于复用）
+inline auto str_builder_clear = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_builder_clear)");
+    auto self_sb = dynamic_cast<StringBuilder*>(self);
+    assert(self_sb != nullptr && "str_builder_clear must be called by StringBuilder object");
+    self_sb->buf.clear();
+    return new Nil();
+};
+
+// StringBuilder.build：生成 String（复制一次，builder 可继续追加）
+inline auto str_builder_build = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_builder_build)");
+    auto self_sb = dynamic_cast<StringBuilder*>(self);
+    assert(self_sb != nullptr && "str_builder_build must be called by StringBuilder object");
+    return new String(self_sb->buf);
+};
+
+}  // namespace model
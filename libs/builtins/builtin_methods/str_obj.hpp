@@ -1,5 +1,6 @@
 #pragma once
 #include "models.hpp"
+#include "../../../deps/simd_search.hpp"
 
 namespace model {
 
@@ -30,15 +31,47 @@ inline auto str_mul = [](Object* self, const List* args) -> Object* {
     assert(times_int != nullptr && "String.mul only supports Int type argument");
     assert(times_int->val >= deps::BigInt(0) && "String.mul requires non-negative integer argument");
     
+    assert(times_int->val.fits_long_long() && "String.mul argument too large");
+    
+    // 使用机器整数计数，并预先分配结果大小
+    const auto times = static_cast<size_t>(times_int->val.to_long_long());
     std::string result;
-    deps::BigInt times = times_int->val;
-    for (deps::BigInt i = deps::BigInt(0); i < times; i+=deps::BigInt(1)) {
+    result.reserve(self_str->val.size() * times);
+    for (size_t i = 0; i < times; ++i) {
         result += self_str->val;
     }
     
     return new String(std::move(result));
 };
 
+// String.join：用 self 连接 List 中的字符串 sep.join(list)，结果大小预先算好只分配一次
+inline auto str_join = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_join)");
+    assert(args->val.size() == 1 && "function String.join need 1 arg");
+
+    auto self_str = dynamic_cast<String*>(self);
+    assert(self_str != nullptr && "str_join must be called by String object");
+
+    auto parts = dynamic_cast<List*>(args->val[0]);
+    assert(parts != nullptr && "String.join only supports List type argument");
+
+    const std::vector<Object*>& items = parts->flat();
+    size_t total = items.empty() ? 0 : self_str->val.size() * (items.size() - 1);
+    for (const Object* part : items) {
+        auto part_str = dynamic_cast<const String*>(part);
+        assert(part_str != nullptr && "String.join: List elements must be String");
+        total += part_str->val.size();
+    }
+
+    std::string result;
+    result.reserve(total);
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (i != 0) result += self_str->val;
+        result += static_cast<const String*>(items[i])->val;
+    }
+    return new String(std::move(result));
+};
+
 // String.eq：判断两个字符串是否相等 self == x
 inline auto str_eq = [](Object* self, const List* args) -> Object* {
     DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_eq)");
@@ -50,6 +83,12 @@ inline auto str_eq = [](Object* self, const List* args) -> Object* {
     auto another_str = dynamic_cast<String*>(args->val[0]);
     assert(another_str != nullptr && "String.eq only supports String type argument");
     
+    // 同一对象必然相等；两个不同的驻留字符串必然不等；已缓存哈希不同也必然不等
+    if (self_str == another_str) return new Bool(true);
+    if (self_str->interned && another_str->interned) return new Bool(false);
+    if (self_str->hash_cached() && another_str->hash_cached() && self_str->hash() != another_str->hash()) {
+        return new Bool(false);
+    }
     return new Bool(self_str->val == another_str->val);
 };
 
@@ -64,8 +103,226 @@ inline auto str_contains = [](Object* self, const List* args) -> Object* {
     auto sub_str = dynamic_cast<String*>(args->val[0]);
     assert(sub_str != nullptr && "String.contains only supports String type argument");
     
-    bool exists = self_str->val.find(sub_str->val) != std::string::npos;
+    const auto& hay = self_str->val;
+    const auto& needle = sub_str->val;
+    bool exists = deps::search::find(hay.data(), hay.size(), needle.data(), needle.size()) != deps::search::npos;
     return new Bool(exists);
 };
 
+// 字节偏移换算为码点下标（ASCII/字节模式下二者相同）
+inline size_t byte_to_cp(const String* str, const size_t byte_off) {
+    if (str->is_byte_mode()) return byte_off;
+    return deps::utf8::count_code_points(str->val.data(), byte_off);
+}
+
+// String.find：返回子字符串首次出现的码点下标，找不到返回 -1
+inline auto str_find = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_find)");
+    assert(args->val.size() == 1 && "function String.find need 1 arg");
+
+    auto self_str = dynamic_cast<String*>(self);
+    assert(self_str != nullptr && "str_find must be called by String object");
+
+    auto sub_str = dynamic_cast<String*>(args->val[0]);
+    assert(sub_str != nullptr && "String.find only supports String type argument");
+
+    const auto& hay = self_str->val;
+    const auto& needle = sub_str->val;
+    const size_t pos = deps::search::find(hay.data(), hay.size(), needle.data(), needle.size());
+    if (pos == deps::search::npos) return new Int(deps::BigInt::from_long_long(-1));
+    return new Int(deps::BigInt(byte_to_cp(self_str, pos)));
+};
+
+// String.startswith：判断是否以 x 开头
+inline auto str_startswith = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_startswith)");
+    assert(args->val.size() == 1 && "function String.startswith need 1 arg");
+
+    auto self_str = dynamic_cast<String*>(self);
+    assert(self_str != nullptr && "str_startswith must be called by String object");
+
+    auto prefix = dynamic_cast<String*>(args->val[0]);
+    assert(prefix != nullptr && "String.startswith only supports String type argument");
+
+    const auto& s = self_str->val;
+    const auto& p = prefix->val;
+    return new Bool(p.size() <= s.size() && std::memcmp(s.data(), p.data(), p.size()) == 0);
+};
+
+// String.endswith：判断是否以 x 结尾
+inline auto str_endswith = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_endswith)");
+    assert(args->val.size() == 1 && "function String.endswith need 1 arg");
+
+    auto self_str = dynamic_cast<String*>(self);
+    assert(self_str != nullptr && "str_endswith must be called by String object");
+
+    auto suffix = dynamic_cast<String*>(args->val[0]);
+    assert(suffix != nullptr && "String.endswith only supports String type argument");
+
+    const auto& s = self_str->val;
+    const auto& p = suffix->val;
+    return new Bool(p.size() <= s.size() && std::memcmp(s.data() + s.size() - p.size(), p.data(), p.size()) == 0);
+};
+
+// String.split：self.split() 按空白切分（忽略空段）；self.split(sep) 按分隔符切分
+// 先收集全部切分点，结果 List 按最终大小一次分配
+inline auto str_split = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_split)");
+    assert(args->val.size() <= 1 && "function String.split need 0 or 1 arg");
+
+    auto self_str = dynamic_cast<String*>(self);
+    assert(self_str != nullptr && "str_split must be called by String object");
+
+    const auto& s = self_str->val;
+    std::vector<Object*> parts;
+
+    if (args->val.empty()) {
+        // 按连续空白切分
+        std::vector<std::pair<size_t, size_t>> spans;
+        size_t i = 0;
+        while (i < s.size()) {
+            while (i < s.size() && deps::search::is_space(s[i])) ++i;
+            if (i >= s.size()) break;
+            const size_t begin = i;
+            while (i < s.size() && !deps::search::is_space(s[i])) ++i;
+            spans.emplace_back(begin, i);
+        }
+        parts.reserve(spans.size());
+        for (const auto& [begin, end] : spans) {
+            parts.push_back(new String(s.substr(begin, end - begin)));
+        }
+    } else {
+        auto sep_str = dynamic_cast<String*>(args->val[0]);
+        assert(sep_str != nullptr && "String.split only supports String type argument");
+        const auto& sep = sep_str->val;
+        assert(!sep.empty() && "String.split separator must not be empty");
+
+        const auto hits = deps::search::find_all(s.data(), s.size(), sep.data(), sep.size());
+        parts.reserve(hits.size() + 1);
+        size_t begin = 0;
+        for (const size_t pos : hits) {
+            parts.push_back(new String(s.substr(begin, pos - begin)));
+            begin = pos + sep.size();
+        }
+        parts.push_back(new String(s.substr(begin)));
+    }
+
+    for (Object* part : parts) part->make_ref();
+    return new List(std::move(parts));
+};
+
+// String.replace：将所有 old 替换为 new，返回新String（输出大小预先算好只分配一次）
+inline auto str_replace = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_replace)");
+    assert(args->val.size() == 2 && "function String.replace need 2 args");
+
+    auto self_str = dynamic_cast<String*>(self);
+    assert(self_str != nullptr && "str_replace must be called by String object");
+
+    auto old_str = dynamic_cast<String*>(args->val[0]);
+    auto new_str = dynamic_cast<String*>(args->val[1]);
+    assert(old_str != nullptr && new_str != nullptr && "String.replace only supports String type arguments");
+    assert(!old_str->val.empty() && "String.replace old substring must not be empty");
+
+    const auto& s = self_str->val;
+    const auto& from = old_str->val;
+    const auto& to = new_str->val;
+    const auto hits = deps::search::find_all(s.data(), s.size(), from.data(), from.size());
+    if (hits.empty()) return new String(s);
+
+    std::string result;
+    result.reserve(s.size() - hits.size() * from.size() + hits.size() * to.size());
+    size_t begin = 0;
+    for (const size_t pos : hits) {
+        result.append(s, begin, pos - begin);
+        result += to;
+        begin = pos + from.size();
+    }
+    result.append(s, begin, std::string::npos);
+    return new String(std::move(result));
+};
+
+// strip 系列公共实现：chars 为空时去除空白，否则去除 chars 中出现的（ASCII）字符
+inline Object* strip_impl(Object* self, const List* args, const bool left, const bool right, const char* name) {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (" + name + ")");
+    assert(args->val.size() <= 1 && "function String.strip need 0 or 1 arg");
+
+    auto self_str = dynamic_cast<String*>(self);
+    assert(self_str != nullptr && "strip must be called by String object");
+
+    bool table[256] = {};
+    if (args->val.empty()) {
+        for (const char c : {' ', '\t', '\n', '\r', '\v', '\f'}) table[static_cast<unsigned char>(c)] = true;
+    } else {
+        auto chars = dynamic_cast<String*>(args->val[0]);
+        assert(chars != nullptr && "String.strip only supports String type argument");
+        for (const char c : chars->val) {
+            assert(static_cast<unsigned char>(c) < 0x80 && "String.strip chars must be ASCII");
+            table[static_cast<unsigned char>(c)] = true;
+        }
+    }
+
+    const auto& s = self_str->val;
+    size_t begin = 0, end = s.size();
+    if (left) while (begin < end && table[static_cast<unsigned char>(s[begin])]) ++begin;
+    if (right) while (end > begin && table[static_cast<unsigned char>(s[end - 1])]) --end;
+    return new String(s.substr(begin, end - begin));
+}
+
+// String.strip / lstrip / rstrip：去除两端 / 左端 / 右端的空白（或指定字符）
+inline auto str_strip = [](Object* self, const List* args) -> Object* {
+    return strip_impl(self, args, true, true, "str_strip");
+};
+
+inline auto str_lstrip = [](Object* self, const List* args) -> Object* {
+    return strip_impl(self, args, true, false, "str_lstrip");
+};
+
+inline auto str_rstrip = [](Object* self, const List* args) -> Object* {
+    return strip_impl(self, args, false, true, "str_rstrip");
+};
+
+// String.getitem：按码点下标取单字符 self[i] / 切片 self[a:b]，返回新String（UTF-8 感知）
+inline auto str_getitem = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_getitem)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function String.getitem need 1 or 2 args");
+
+    auto self_str = dynamic_cast<String*>(self);
+    assert(self_str != nullptr && "str_getitem must be called by String object");
+
+    if (args->val.size() == 2) {
+        const auto [begin, end] = normalize_slice(args->val[0], args->val[1], self_str->cp_len());
+        return new String(self_str->cp_substr(begin, end));
+    }
+
+    auto idx_int = dynamic_cast<Int*>(args->val[0]);
+    assert(idx_int != nullptr && "String.getitem index must be Int type");
+    // 单字符结果使用驻留字符串，逐字符遍历时不再为每个字符分配对象
+    const size_t idx = normalize_index(idx_int->val, self_str->cp_len());
+    return intern_string(self_str->cp_substr(idx, idx + 1));
+};
+
+// String.byte_at：取下标处的原始字节值 self.byte_at(i)，返回Int（0-255）
+inline auto str_byte_at = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_byte_at)");
+    assert(args->val.size() == 1 && "function String.byte_at need 1 arg");
+
+    auto self_str = dynamic_cast<String*>(self);
+    assert(self_str != nullptr && "str_byte_at must be called by String object");
+
+    auto idx_int = dynamic_cast<Int*>(args->val[0]);
+    assert(idx_int != nullptr && "String.byte_at index must be Int type");
+    const auto byte = static_cast<unsigned char>(self_str->val[normalize_index(idx_int->val, self_str->val.size())]);
+    return new Int(deps::BigInt(static_cast<size_t>(byte)));
+};
+
+// String.hash：返回缓存的字符串哈希值
+inline auto str_hash = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (str_hash)");
+    assert(args->val.empty() && "function String.hash need 0 arg");
+    assert(dynamic_cast<String*>(self) != nullptr && "str_hash must be called by String object");
+    return new Int(deps::BigInt(hash_object(self)));
+};
+
 }  // namespace model
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+#include "models.hpp"
+
+namespace model {
+
+// Tuple.add：拼接另一个Tuple（self + 传入Tuple，返回新Tuple）
+inline auto tuple_add = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (tuple_add)");
+    assert(args->val.size() == 1 && "function Tuple.add need 1 arg");
+
+    auto self_tuple = dynamic_cast<Tuple*>(self);
+    assert(self_tuple != nullptr && "tuple_add must be called by Tuple object");
+
+    auto another_tuple = dynamic_cast<Tuple*>(args->val[0]);
+    assert(another_tuple != nullptr && "Tuple.add only supports Tuple type argument");
+
+    std::vector<Object*> new_vals;
+    new_vals.reserve(self_tuple->size() + another_tuple->size());
+    new_vals.insert(new_vals.end(), self_tuple->data(), self_tuple->data() + self_tuple->size());
+    new_vals.insert(new_vals.end(), another_tuple->data(), another_tuple->data() + another_tuple->size());
+    for (Object* elem : new_vals) elem->make_ref();
+
+    return new Tuple(new_vals);
+};
+
+// Tuple.eq：逐元素原生比较（与作为 Dictionary / Set 键时的相等判断一致）
+inline auto tuple_eq = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (tuple_eq)");
+    assert(args->val.size() == 1 && "function Tuple.eq need 1 arg");
+    assert(dynamic_cast<Tuple*>(self) != nullptr && "tuple_eq must be called by Tuple object");
+
+    return new Bool(objects_equal(self, args->val[0]));
+};
+
+// Tuple.hash：组合各元素的哈希值（含不可哈希元素时报错）
+inline auto tuple_hash = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (tuple_hash)");
+    assert(args->val.empty() && "function Tuple.hash need 0 arg");
+    assert(dynamic_cast<Tuple*>(self) != nullptr && "tuple_hash must be called by Tuple object");
+    assert(is_hashable(self) && "Tuple.hash: 元组含不可哈希元素");
+
+    return new Int(deps::BigInt(hash_object(self)));
+};
+
+// Tuple.contains：判断元组是否包含目标元素
+inline auto tuple_contains = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (tuple_contains)");
+    assert(args->val.size() == 1 && "function Tuple.contains need 1 arg");
+
+    auto self_tuple = dynamic_cast<Tuple*>(self);
+    assert(self_tuple != nullptr && "tuple_contains must be called by Tuple object");
+
+    for (size_t i = 0; i < self_tuple->size(); ++i) {
+        if (objects_equal(self_tuple->at(i), args->val[0])) {
+            return new Bool(true);
+        }
+    }
+    return new Bool(false);
+};
+
+// Tuple.getitem：下标取值 self[i] / 切片 self[a:b]（切片返回新Tuple）
+inline auto tuple_getitem = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (tuple_getitem)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function Tuple.getitem need 1 or 2 args");
+
+    auto self_tuple = dynamic_cast<Tuple*>(self);
+    assert(self_tuple != nullptr && "tuple_getitem must be called by Tuple object");
+
+    if (args->val.size() == 2) {
+        const auto [begin, end] = normalize_slice(args->val[0], args->val[1], self_tuple->size());
+        for (size_t i = begin; i < end; ++i) self_tuple->at(i)->make_ref();
+        return new Tuple(self_tuple->data() + begin, end - begin);
+    }
+
+    auto idx_int = dynamic_cast<Int*>(args->val[0]);
+    assert(idx_int != nullptr && "Tuple.getitem index must be Int type");
+    return self_tuple->at(normalize_index(idx_int->val, self_tuple->size()));
+};
+
+// Tuple.to_list：复制为可变的List
+inline auto tuple_to_list = [](Object* self, const List* args) -> Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (tuple_to_list)");
+    assert(args->val.empty() && "function Tuple.to_list need 0 arg");
+
+    auto self_tuple = dynamic_cast<Tuple*>(self);
+    assert(self_tuple != nullptr && "tuple_to_list must be called by Tuple object");
+
+    std::vector<Object*> elems(self_tuple->data(), self_tuple->data() + self_tuple->size());
+    for (Object* elem : elems) elem->make_ref();
+    return new List(std::move(elems));
+};
+
+}  // namespace model
@@ -0,0 +1,403 @@
+/**
+ * @file kiz_csv.hpp
+ * @brief csv 标准库模块：按块流式读取 CSV（RFC 4180 引号规则）
+ * 直接在 io.File 的读缓冲 / 映射内存上解析，每行的字段复用同一组字符串缓冲；
+ * rows() 逐行产出 List，columns() 只把选中的列直接解析进 array（f64/i64/i32）或字符串列表，
+ * 其余字段不创建任何对象
+ * @author azhz1107cat
+ * @date 2025-12-25
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../include/models.hpp"
+#include "../array/kiz_array.hpp"
+#include "../io/kiz_io.hpp"
+
+namespace csv_lib {
+
+inline auto based_reader = new model::Object();
+
+// 逐条记录解析；字段内容保存在 fields()[0, count()) 中，下次解析时被覆盖
+class RecordParser {
+    io_lib::File* file_;
+    char delim_;
+    std::string_view chunk_;
+    size_t pos_ = 0;
+    std::vector<std::string> fields_;
+    size_t count_ = 0;
+    bool stop_[256] = {};  // 非引号字段中需要停下处理的字符：分隔符与换行
+
+    enum class State { RecordStart, FieldStart, Unquoted, Quoted, QuoteInQuoted };
+
+    std::string& begin_field() {
+        if (count_ == fields_.size()) fields_.emplace_back();
+        std::string& field = fields_[count_++];
+        field.clear();
+        return field;
+    }
+
+public:
+    RecordParser(io_lib::File* file, const char delim) : file_(file), delim_(delim) {
+        stop_[static_cast<unsigned char>(delim)] = true;
+        stop_[static_cast<unsigned char>('\n')] = true;
+        stop_[static_cast<unsigned char>('\r')] = true;
+    }
+
+    [[nodiscard]] size_t count() const { return count_; }
+    [[nodiscard]] const std::string& field(const size_t i) const { return fields_[i]; }
+
+    // 解析下一条记录，输入结束返回 false。空行被跳过；引号内可含分隔符、换行和 "" 转义的引号
+    bool next() {
+        count_ = 0;
+        State state = State::RecordStart;
+        std::string* field = nullptr;
+        while (true) {
+            if (pos_ == chunk_.size()) {
+                chunk_ = file_->is_closed() ? std::string_view() : file_->read_chunk();
+                pos_ = 0;
+                if (chunk_.empty()) {
+                    assert(state != State::Quoted && "csv: 引号字段未闭合");
+                    return state != State::RecordStart;
+                }
+            }
+            const char* p = chunk_.data();
+            const size_t n = chunk_.size();
+            const char c = p[pos_];
+
+            switch (state) {
+                case State::RecordStart:
+                    if (c == '\n' || c == '\r') {
+                        ++pos_;
+                        continue;
+                    }
+                    field = &begin_field();
+                    state = State::FieldStart;
+                    continue;
+
+                case State::FieldStart:
+                    if (c == '"') {
+                        ++pos_;
+                        state = State::Quoted;
+                        continue;
+                    }
+                    state = State::Unquoted;
+                    [[fallthrough]];
+
+                case State::Unquoted: {
+                    // 连续的普通字符整段追加
+                    size_t i = pos_;
+                    while (i < n && !stop_[static_cast<unsigned char>(p[i])]) ++i;
+                    field->append(p + pos_, i - pos_);
+                    pos_ = i;
+                    if (i == n) continue;
+                    ++pos_;
+                    if (p[i] == delim_) {
+                        field = &begin_field();
+                        state = State::FieldStart;
+                        continue;
+                    }
+                    return true;  // \n 或 \r；\r\n 的 \n 在下一条记录开头作为空行跳过
+                }
+
+                case State::Quoted: {
+                    const auto q = static_cast<const char*>(std::memchr(p + pos_, '"', n - pos_));
+                    const size_t end = q == nullptr ? n : static_cast<size_t>(q - p);
+                    field->append(p + pos_, end - pos_);
+                    pos_ = end;
+                    if (q != nullptr) {
+                        ++pos_;
+                        state = State::QuoteInQuoted;
+                    }
+                    continue;
+                }
+
+                case State::QuoteInQuoted:
+                    ++pos_;
+                    if (c == '"') {
+                        *field += '"';
+                        state = State::Quoted;
+                    } else if (c == delim_) {
+                        field = &begin_field();
+                        state = State::FieldStart;
+                    } else if (c == '\n' || c == '\r') {
+                        return true;
+                    } else {
+                        // 闭引号后的多余字符：宽松处理，按字面追加
+                        *field += c;
+                        state = State::Unquoted;
+                    }
+                    continue;
+            }
+        }
+    }
+};
+
+class Reader : public model::Object {
+public:
+    io_lib::File* file;
+    RecordParser parser;
+    model::List* header = nullptr;  // 有表头时为列名列表
+
+    Reader(io_lib::File* src, const char delim) : file(src), parser(src, delim) {
+        attrs.insert("__parent__", based_reader);
+        file->make_ref();
+    }
+    ~Reader() override {
+        if (header != nullptr) header->del_ref();
+        file->del_ref();
+    }
+
+    // 当前记录转为字符串列表
+    [[nodiscard]] model::List* record_to_list() const {
+        std::vector<model::Object*> elems;
+        elems.reserve(parser.count());
+        for (size_t i = 0; i < parser.count(); ++i) {
+            auto elem = new model::String(parser.field(i));
+            elem->make_ref();
+            elems.push_back(elem);
+        }
+        return new model::List(std::move(elems));
+    }
+
+    // 列名或列下标 -> 列下标
+    [[nodiscard]] size_t column_index(const model::Object* col) const {
+        if (const auto name = dynamic_cast<const model::String*>(col)) {
+            assert(header != nullptr && "csv: 按列名取列需要表头（csv.reader(src, delim, true)）");
+            for (size_t i = 0; i < header->size(); ++i) {
+                if (static_cast<const model::String*>(header->at(i))->val == name->val) return i;
+            }
+            assert(false && "csv: 表头中无此列名");
+        }
+        return model::get_size_arg(col, "csv: 列必须是列名或非负整数下标");
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return "<csv.Reader: " + file->path + " at " + model::ptr_to_string(this) + ">";
+    }
+};
+
+class RowsIter : public model::Iterator {
+    Reader* reader_;
+
+public:
+    explicit RowsIter(Reader* reader) : reader_(reader) {
+        reader_->make_ref();
+    }
+    ~RowsIter() override {
+        reader_->del_ref();
+    }
+
+    model::Object* next() override {
+        if (!reader_->parser.next()) return nullptr;
+        model::Object* row = reader_->record_to_list();
+        row->make_ref();
+        return row;
+    }
+};
+
+// ========================= 列解析 =========================
+// 去掉首尾空格；数字允许前导 '+'
+inline std::string_view trim_number(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+    if (s.size() > 1 && s.front() == '+') s.remove_prefix(1);
+    return s;
+}
+
+template <typename T>
+T parse_field(const std::string& field) {
+    const std::string_view s = trim_number(field);
+    // 空的浮点字段视为缺失值
+    if constexpr (std::is_same_v<T, double>) {
+        if (s.empty()) return std::numeric_limits<double>::quiet_NaN();
+    }
+    T value{};
+    const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    assert(ec == std::errc() && ptr == s.data() + s.size() && !s.empty() && "csv: 字段不是合法的数字");
+    return value;
+}
+
+// 单个输出列：数值列累积在机器数值的 vector 中，最后一次复制进 Array
+struct Column {
+    size_t index;
+    bool is_str;
+    array_lib::DType dtype;
+    std::vector<double> f64;
+    std::vector<int64_t> i64;
+    std::vector<int32_t> i32;
+    std::vector<model::Object*> strs;
+
+    void push(const std::string& field) {
+        if (is_str) {
+            auto s = new model::String(field);
+            s->make_ref();
+            strs.push_back(s);
+            return;
+        }
+        switch (dtype) {
+            case array_lib::DType::F64: f64.push_back(parse_field<double>(field)); break;
+            case array_lib::DType::I64: i64.push_back(parse_field<int64_t>(field)); break;
+            case array_lib::DType::I32: i32.push_back(parse_field<int32_t>(field)); break;
+            case array_lib::DType::Bool: break;
+        }
+    }
+
+    template <typename T>
+    static model::Object* to_array(const array_lib::DType dtype, const std::vector<T>& vals) {
+        auto arr = new array_lib::Array(dtype, vals.size());
+        if (!vals.empty()) std::memcpy(arr->data<T>(), vals.data(), vals.size() * sizeof(T));
+        return arr;
+    }
+
+    model::Object* finish() {
+        if (is_str) return new model::List(std::move(strs));
+        switch (dtype) {
+            case array_lib::DType::F64: return to_array(dtype, f64);
+            case array_lib::DType::I64: return to_array(dtype, i64);
+            case array_lib::DType::I32: return to_array(dtype, i32);
+            case array_lib::DType::Bool: break;
+        }
+        return nullptr;
+    }
+};
+
+inline Reader* get_self(model::Object* self, const char* method_name) {
+    const auto reader = dynamic_cast<Reader*>(self);
+    if (reader == nullptr) {
+        assert(false && ("csv: " + std::string(method_name) + " must be called by csv.Reader object").c_str());
+    }
+    return reader;
+}
+
+// ========================= Reader 方法 =========================
+// Reader.rows()：惰性逐行迭代器，每行产出字符串列表
+inline auto reader_rows = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (reader_rows)");
+    assert(args->val.empty() && "function csv.Reader.rows need 0 arg");
+    return new RowsIter(get_self(self, "rows"));
+};
+
+// Reader.columns(cols, types)：读完剩余的行，返回与 cols 一一对应的列组成的元组；
+// types 中 "f64" / "i64" / "i32" 得到 array，"str" 得到字符串列表；f64 列的空字段为 NaN
+inline auto reader_columns = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (reader_columns)");
+    assert(args->val.size() == 2 && "function csv.Reader.columns need 2 args: (cols, types)");
+    Reader* reader = get_self(self, "columns");
+    const auto cols = dynamic_cast<const model::List*>(args->val[0]);
+    const auto types = dynamic_cast<const model::List*>(args->val[1]);
+    assert(cols != nullptr && types != nullptr && cols->size() == types->size()
+           && "csv.Reader.columns: cols 与 types 必须是等长的列表");
+
+    std::vector<Column> columns(cols->size());
+    size_t min_fields = 0;
+    for (size_t j = 0; j < columns.size(); ++j) {
+        columns[j].index = reader->column_index(cols->at(j));
+        min_fields = std::max(min_fields, columns[j].index + 1);
+        const auto type_name = dynamic_cast<const model::String*>(types->at(j));
+        assert(type_name != nullptr && "csv.Reader.columns: 类型名必须是字符串");
+        columns[j].is_str = type_name->val == "str";
+        if (!columns[j].is_str) {
+            columns[j].dtype = array_lib::dtype_from_name(type_name->val);
+            assert(columns[j].dtype != array_lib::DType::Bool && "csv.Reader.columns: 列类型可选 f64/i64/i32/str");
+        }
+    }
+
+    RecordParser& parser = reader->parser;
+    while (parser.next()) {
+        assert(parser.count() >= min_fields && "csv: 行的字段数少于所取的列");
+        for (auto& column : columns) column.push(parser.field(column.index));
+    }
+
+    std::vector<model::Object*> results;
+    results.reserve(columns.size());
+    for (auto& column : columns) {
+        model::Object* result = column.finish();
+        result->make_ref();
+        results.push_back(result);
+    }
+    return new model::Tuple(results);
+};
+
+// Reader.header()：表头列名列表（无表头时为 Nil）
+inline auto reader_header = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (reader_header)");
+    assert(args->val.empty() && "function csv.Reader.header need 0 arg");
+    const Reader* reader = get_self(self, "header");
+    if (reader->header == nullptr) return new model::Nil();
+    return reader->header;
+};
+
+// ========================= 模块函数 =========================
+// csv.reader(src[, delimiter[, has_header]])：src 为以读方式打开的 io.File（含 sys.stdin）或文件路径
+// （路径以内存映射方式打开）；has_header 为 true 时立即读取第一行作为表头
+inline auto reader = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (csv.reader)");
+    assert(!args->val.empty() && args->val.size() <= 3 && "function csv.reader need 1 to 3 args: (src[, delimiter[, has_header]])");
+
+    io_lib::File* file;
+    if (const auto path = dynamic_cast<const model::String*>(args->val[0])) {
+        file = new io_lib::File(path->val, io_lib::Mode::Mmap);
+    } else {
+        file = dynamic_cast<io_lib::File*>(args->val[0]);
+        assert(file != nullptr && !file->is_closed() && file->is_reader()
+               && "csv.reader: src 必须是文件路径或以读方式打开的 io.File");
+    }
+
+    char delim = ',';
+    if (args->val.size() >= 2) {
+        const auto delim_obj = dynamic_cast<const model::String*>(args->val[1]);
+        assert(delim_obj != nullptr && delim_obj->val.size() == 1 && delim_obj->val[0] != '"'
+               && delim_obj->val[0] != '\n' && delim_obj->val[0] != '\r'
+               && "csv.reader: delimiter 必须是单个字符（不能是引号或换行）");
+        delim = delim_obj->val[0];
+    }
+
+    auto result = new Reader(file, delim);
+    if (args->val.size() == 3) {
+        const auto flag = dynamic_cast<const model::Bool*>(args->val[2]);
+        assert(flag != nullptr && "csv.reader: has_header 必须是 Bool");
+        if (flag->val && result->parser.next()) {
+            result->header = result->record_to_list();
+            result->header->make_ref();
+        }
+    }
+    return result;
+};
+
+inline void register_reader_methods() {
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+
+    using model::CppFunction;
+    based_reader->attrs.insert("__parent__", model::based_obj);
+    based_reader->attrs.insert("rows", new CppFunction(reader_rows));
+    based_reader->attrs.insert("columns", new CppFunction(reader_columns));
+    based_reader->attrs.insert("header", new CppFunction(reader_header));
+}
+
+inline auto __init_module__ = [](model::Object* self, const model::List* args) -> model::Object* {
+    io_lib::register_file_methods();
+    array_lib::register_array_methods();
+    register_reader_methods();
+
+    auto mod = new model::Module(
+        "csv",
+        nullptr
+    );
+
+    mod->attrs.insert("reader", new model::CppFunction(reader));
+
+    return mod;
+};
+
+} // namespace csv_lib
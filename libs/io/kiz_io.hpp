@@ -0,0 +1,513 @@
+/**
+ * @file kiz_io.hpp
+ * @brief io 标准库模块：文件读写
+ * 读取走 64KiB 缓冲（或 "m" 模式下的只读内存映射），写入走 OutBuffer；
+ * File.lines() 返回惰性逐行迭代器，任意大的文件也只占用常数内存；
+ * read_bytes / read_into 直接读入 bytes / bytearray，"m" 模式下 read_bytes 返回映射内存的视图
+ * @author azhz1107cat
+ * @date 2025-12-23
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "../../include/models.hpp"
+#include "../builtins/builtin_functions/iterators.hpp"
+#include "../../deps/mapped_file.hpp"
+#include "../../deps/out_buffer.hpp"
+
+namespace io_lib {
+
+// 打开方式：r 缓冲读，m 内存映射读（不支持时退回缓冲读），w 覆盖写，a 追加写
+enum class Mode { Read, Mmap, Write, Append };
+
+inline Mode mode_from_name(const std::string& name) {
+    if (name == "r") return Mode::Read;
+    if (name == "m") return Mode::Mmap;
+    if (name == "w") return Mode::Write;
+    if (name == "a") return Mode::Append;
+    assert(false && "io.open: 未知的打开方式（可选 r/m/w/a）");
+    return Mode::Read;
+}
+
+inline std::string mode_name(const Mode mode) {
+    switch (mode) {
+        case Mode::Read: return "r";
+        case Mode::Mmap: return "m";
+        case Mode::Write: return "w";
+        case Mode::Append: return "a";
+    }
+    return "?";
+}
+
+constexpr size_t read_buffer_size = 64 * 1024;
+
+inline auto based_file = new model::Object();
+
+class File : public model::Object {
+    std::FILE* fp_ = nullptr;
+    bool owns_fp_ = true;  // 标准流不由 File 关闭
+    // 缓冲读：[rpos_, rend_) 为尚未消费的数据；读缓冲可被 lines(true) 产出的视图共享
+    std::shared_ptr<char[]> rbuf_;
+    size_t rcap_ = 0;
+    size_t rpos_ = 0, rend_ = 0;
+    // 映射读：mpos_ 为读取位置；read_bytes 返回的视图共享映射，文件关闭后映射仍由视图保持
+    std::shared_ptr<deps::MappedFile> map_;
+    size_t mpos_ = 0;
+    std::unique_ptr<deps::OutBuffer> out_;
+    bool closed_ = false;
+
+    bool refill() {
+        // 旧缓冲仍被视图引用时换一块新的，否则原地复用（不持有视图时内存占用不变）
+        if (rbuf_.use_count() > 1) rbuf_.reset(new char[rcap_]);
+        rpos_ = 0;
+        rend_ = std::fread(rbuf_.get(), 1, rcap_, fp_);
+        return rend_ > 0;
+    }
+
+    static void strip_cr(std::string& line) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+    }
+
+public:
+    std::string path;
+    Mode mode;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_File;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    File(std::string file_path, const Mode file_mode) : path(std::move(file_path)), mode(file_mode) {
+        attrs.insert("__parent__", based_file);
+        if (mode == Mode::Mmap) {
+            map_ = std::make_shared<deps::MappedFile>();
+            if (!map_->open(path)) {
+                map_.reset();
+                mode = Mode::Read;
+            }
+        }
+        if (mode == Mode::Read) {
+            fp_ = std::fopen(path.c_str(), "rb");
+            assert(fp_ != nullptr && "io.open: 无法打开文件");
+            // 自己管理读缓冲，关闭 stdio 的缓冲避免多复制一次
+            std::setvbuf(fp_, nullptr, _IONBF, 0);
+            rbuf_.reset(new char[read_buffer_size]);
+            rcap_ = read_buffer_size;
+        } else if (mode == Mode::Write || mode == Mode::Append) {
+            fp_ = std::fopen(path.c_str(), mode == Mode::Write ? "wb" : "ab");
+            assert(fp_ != nullptr && "io.open: 无法打开文件");
+            out_ = std::make_unique<deps::OutBuffer>(fp_);
+        }
+    }
+
+    // 包装已打开的标准流（如 stdin），只读，关闭时不关闭底层流
+    File(std::FILE* stream, std::string name) : fp_(stream), owns_fp_(false), path(std::move(name)), mode(Mode::Read) {
+        attrs.insert("__parent__", based_file);
+        rbuf_.reset(new char[read_buffer_size]);
+        rcap_ = read_buffer_size;
+    }
+
+    ~File() override {
+        close();
+    }
+
+    [[nodiscard]] bool is_reader() const { return mode == Mode::Read || mode == Mode::Mmap; }
+    [[nodiscard]] bool is_closed() const { return closed_; }
+
+    // 读取下一行（不含行尾的 \n 或 \r\n）；已到文件末尾返回 false
+    bool read_line(std::string& line) {
+        line.clear();
+        if (mode == Mode::Mmap) {
+            if (mpos_ >= map_->size()) return false;
+            const char* begin = map_->data() + mpos_;
+            const size_t rest = map_->size() - mpos_;
+            // memchr 在主流 libc 中是向量化实现，一次比较 16~64 字节
+            const auto nl = static_cast<const char*>(std::memchr(begin, '\n', rest));
+            if (nl == nullptr) {
+                line.assign(begin, rest);
+                mpos_ = map_->size();
+                return true;
+            }
+            line.assign(begin, nl - begin);
+            mpos_ += static_cast<size_t>(nl - begin) + 1;
+            strip_cr(line);
+            return true;
+        }
+
+        // 缓冲读：跨越缓冲边界的行分段拼接
+        bool got = false;
+        while (true) {
+            if (rpos_ == rend_ && !refill()) return got;
+            got = true;
+            const char* begin = rbuf_.get() + rpos_;
+            const size_t avail = rend_ - rpos_;
+            const auto nl = static_cast<const char*>(std::memchr(begin, '\n', avail));
+            if (nl != nullptr) {
+                line.append(begin, nl - begin);
+                rpos_ += static_cast<size_t>(nl - begin) + 1;
+                strip_cr(line);
+                return true;
+            }
+            line.append(begin, avail);
+            rpos_ = rend_;
+        }
+    }
+
+    // 读取下一行为 bytes（不含换行符），文件末尾返回 nullptr。
+    // 整行位于映射或当前读缓冲内时返回其视图，不复制；跨越缓冲边界的行复制拼接
+    model::Bytes* read_line_bytes() {
+        const char* begin;
+        size_t avail;
+        if (mode == Mode::Mmap) {
+            if (mpos_ >= map_->size()) return nullptr;
+            begin = map_->data() + mpos_;
+            avail = map_->size() - mpos_;
+        } else {
+            if (rpos_ == rend_ && !refill()) return nullptr;
+            begin = rbuf_.get() + rpos_;
+            avail = rend_ - rpos_;
+        }
+        const auto nl = static_cast<const char*>(std::memchr(begin, '\n', avail));
+        if (nl == nullptr && mode != Mode::Mmap) {
+            std::string line;
+            read_line(line);
+            return new model::Bytes(std::string_view(line), false);
+        }
+        size_t len = nl == nullptr ? avail : static_cast<size_t>(nl - begin);
+        const size_t consumed = nl == nullptr ? avail : len + 1;
+        if (nl != nullptr && len > 0 && begin[len - 1] == '\r') --len;
+        const auto data = reinterpret_cast<const uint8_t*>(begin);
+        if (mode == Mode::Mmap) {
+            mpos_ += consumed;
+            return new model::Bytes(map_, data, len, false);
+        }
+        rpos_ += consumed;
+        return new model::Bytes(rbuf_, data, len, false);
+    }
+
+    // 读取至多 n 个字节（n 为 npos 时读到末尾）
+    std::string read(const size_t n) {
+        std::string out;
+        if (mode == Mode::Mmap) {
+            const size_t take = std::min(n, map_->size() - mpos_);
+            out.assign(map_->data() + mpos_, take);
+            mpos_ += take;
+            return out;
+        }
+        while (out.size() < n) {
+            if (rpos_ < rend_) {
+                const size_t take = std::min(n - out.size(), rend_ - rpos_);
+                out.append(rbuf_.get() + rpos_, take);
+                rpos_ += take;
+                continue;
+            }
+            const size_t want = n - out.size();
+            if (want < rcap_) {
+                if (!refill()) break;
+                continue;
+            }
+            // 大块读取直接写入结果，不经过读缓冲
+            const size_t chunk = std::min<size_t>(want, 16 * read_buffer_size);
+            const size_t old = out.size();
+            out.resize(old + chunk);
+            const size_t got = std::fread(out.data() + old, 1, chunk, fp_);
+            out.resize(old + got);
+            if (got == 0) break;
+        }
+        return out;
+    }
+
+    // 读取至多 n 个字节到 dst，返回实际读取的字节数（不足 n 表示已到文件末尾）
+    size_t read_into(uint8_t* dst, const size_t n) {
+        if (mode == Mode::Mmap) {
+            const size_t take = std::min(n, map_->size() - mpos_);
+            std::memcpy(dst, map_->data() + mpos_, take);
+            mpos_ += take;
+            return take;
+        }
+        size_t done = 0;
+        while (done < n) {
+            if (rpos_ < rend_) {
+                const size_t take = std::min(n - done, rend_ - rpos_);
+                std::memcpy(dst + done, rbuf_.get() + rpos_, take);
+                rpos_ += take;
+                done += take;
+                continue;
+            }
+            if (n - done < rcap_) {
+                if (!refill()) break;
+                continue;
+            }
+            // 剩余部分不小于读缓冲：直接读入目标
+            const size_t got = std::fread(dst + done, 1, n - done, fp_);
+            done += got;
+            if (got == 0) break;
+        }
+        return done;
+    }
+
+    // 读取至多 n 个字节为 bytes：映射模式下直接返回映射内存的视图，不复制
+    model::Bytes* read_bytes(const size_t n) {
+        if (mode == Mode::Mmap) {
+            const size_t take = std::min(n, map_->size() - mpos_);
+            const auto data = reinterpret_cast<const uint8_t*>(map_->data()) + mpos_;
+            mpos_ += take;
+            return new model::Bytes(map_, data, take, false);
+        }
+        // n 很大（或省略）时文件可能远小于 n，不预先分配 n 字节
+        if (n > 16 * read_buffer_size) {
+            const std::string content = read(n);
+            return new model::Bytes(std::string_view(content), false);
+        }
+        const auto buf = new model::Bytes(n, true);
+        const size_t got = read_into(buf->mutable_data(), n);
+        buf->writable = false;
+        if (got == n) return buf;
+        // 到达文件末尾：返回已读部分的视图
+        model::Bytes* part = buf->slice(0, got);
+        delete buf;
+        return part;
+    }
+
+    // 取出当前可读的一整块数据并视为已消费：缓冲读为读缓冲中的剩余部分，映射读为映射的剩余部分。
+    // 文件末尾返回空视图；视图在下一次读取前有效（供 csv 等按块解析的读取器使用）
+    std::string_view read_chunk() {
+        if (mode == Mode::Mmap) {
+            const std::string_view chunk(map_->data() + mpos_, map_->size() - mpos_);
+            mpos_ = map_->size();
+            return chunk;
+        }
+        if (rpos_ == rend_ && !refill()) return {};
+        const std::string_view chunk(rbuf_.get() + rpos_, rend_ - rpos_);
+        rpos_ = rend_;
+        return chunk;
+    }
+
+    void write(const std::string_view s) {
+        out_->write(s);
+    }
+
+    // 写模式下的输出缓冲（序列化器等可直接向其追加内容）
+    [[nodiscard]] deps::OutBuffer* out_buffer() {
+        return out_.get();
+    }
+
+    void flush() {
+        if (out_ != nullptr) out_->flush();
+    }
+
+    void close() {
+        if (closed_) return;
+        closed_ = true;
+        // 先写出缓冲再关闭文件
+        out_.reset();
+        if (fp_ != nullptr && owns_fp_) std::fclose(fp_);
+        fp_ = nullptr;
+        map_.reset();
+        rbuf_.reset();
+        rcap_ = 0;
+        rpos_ = rend_ = 0;
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return "<File \"" + path + "\" mode=" + mode_name(mode) + (closed_ ? " closed" : "")
+               + " at " + model::ptr_to_string(this) + ">";
+    }
+};
+
+// File.lines() 的迭代器：每次产出一行的 String，持有文件引用
+class LinesIter : public model::Iterator {
+    File* file_;
+    bool as_bytes_;
+    std::string line_;
+
+public:
+    // as_bytes 为 true 时产出 bytes 视图（见 File::read_line_bytes），否则产出 String
+    LinesIter(File* file, const bool as_bytes) : file_(file), as_bytes_(as_bytes) {
+        file_->make_ref();
+    }
+    ~LinesIter() override {
+        file_->del_ref();
+    }
+
+    model::Object* next() override {
+        if (file_->is_closed()) return nullptr;
+        model::Object* result;
+        if (as_bytes_) {
+            result = file_->read_line_bytes();
+            if (result == nullptr) return nullptr;
+        } else {
+            if (!file_->read_line(line_)) return nullptr;
+            result = new model::String(line_);
+        }
+        result->make_ref();
+        return result;
+    }
+};
+
+inline File* get_self(model::Object* self, const char* method_name, const bool reader) {
+    const auto file = dynamic_cast<File*>(self);
+    if (file == nullptr) {
+        assert(false && ("io: " + std::string(method_name) + " must be called by File object").c_str());
+    }
+    assert(!file->is_closed() && "io: 文件已关闭");
+    assert(file->is_reader() == reader && "io: 文件的打开方式不支持该操作");
+    return file;
+}
+
+// ========================= File 方法 =========================
+// File.read([n])：读取至多 n 个字节，省略时读到末尾
+inline auto file_read = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (file_read)");
+    assert(args->val.size() <= 1 && "function File.read need 0 or 1 arg");
+    File* file = get_self(self, "read", true);
+
+    size_t n = std::string::npos;
+    if (!args->val.empty()) {
+        const auto n_obj = dynamic_cast<const model::Int*>(args->val[0]);
+        assert(n_obj != nullptr && n_obj->val.fits_long_long() && n_obj->val.to_long_long() >= 0
+               && "File.read: n 必须是非负整数");
+        n = static_cast<size_t>(n_obj->val.to_long_long());
+    }
+    return new model::String(file->read(n));
+};
+
+// File.read_bytes([n])：读取至多 n 个字节为 bytes，省略时读到末尾（"m" 模式下不复制）
+inline auto file_read_bytes = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (file_read_bytes)");
+    assert(args->val.size() <= 1 && "function File.read_bytes need 0 or 1 arg");
+    File* file = get_self(self, "read_bytes", true);
+
+    const size_t n = args->val.empty()
+        ? std::string::npos
+        : model::get_size_arg(args->val[0], "File.read_bytes: n 必须是非负整数");
+    return file->read_bytes(n);
+};
+
+// File.read_into(buf[, offset])：读入 bytearray 的 [offset, len(buf)) 区间，返回读取的字节数
+inline auto file_read_into = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (file_read_into)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function File.read_into need 1 or 2 args: (buf[, offset])");
+    File* file = get_self(self, "read_into", true);
+
+    const auto buf = dynamic_cast<model::Bytes*>(args->val[0]);
+    assert(buf != nullptr && buf->writable && "File.read_into: buf 必须是 bytearray");
+    const size_t offset = args->val.size() == 2
+        ? model::get_size_arg(args->val[1], "File.read_into: offset 必须是非负整数")
+        : 0;
+    assert(offset <= buf->size() && "File.read_into: offset 越界");
+    const size_t got = file->read_into(buf->mutable_data() + offset, buf->size() - offset);
+    return new model::Int(deps::BigInt::from_long_long(static_cast<long long>(got)));
+};
+
+// File.readline()：读取一行（不含换行符），文件末尾返回 Nil
+inline auto file_readline = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (file_readline)");
+    assert(args->val.empty() && "function File.readline need 0 arg");
+    File* file = get_self(self, "readline", true);
+
+    std::string line;
+    if (!file->read_line(line)) return new model::Nil();
+    return new model::String(std::move(line));
+};
+
+// File.lines([as_bytes])：惰性逐行迭代器；as_bytes 为 true 时逐行产出不复制的 bytes 视图
+inline auto file_lines = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (file_lines)");
+    assert(args->val.size() <= 1 && "function File.lines need 0 or 1 arg");
+    bool as_bytes = false;
+    if (!args->val.empty()) {
+        const auto flag = dynamic_cast<const model::Bool*>(args->val[0]);
+        assert(flag != nullptr && "File.lines: as_bytes 必须是 Bool");
+        as_bytes = flag->val;
+    }
+    return new LinesIter(get_self(self, "lines", true), as_bytes);
+};
+
+// File.write(s)：写入字符串或 bytes，返回写入的字节数
+inline auto file_write = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (file_write)");
+    assert(args->val.size() == 1 && "function File.write need 1 arg");
+    File* file = get_self(self, "write", false);
+
+    std::string_view content;
+    if (const auto str_obj = dynamic_cast<const model::String*>(args->val[0])) {
+        content = str_obj->val;
+    } else if (const auto bytes_obj = dynamic_cast<const model::Bytes*>(args->val[0])) {
+        content = bytes_obj->view();
+    } else {
+        assert(false && "File.write only supports String or Bytes type argument");
+    }
+    file->write(content);
+    return new model::Int(deps::BigInt::from_long_long(static_cast<long long>(content.size())));
+};
+
+// File.flush()：写出缓冲中的内容
+inline auto file_flush = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (file_flush)");
+    assert(args->val.empty() && "function File.flush need 0 arg");
+    get_self(self, "flush", false)->flush();
+    return new model::Nil();
+};
+
+// File.close()：写出缓冲并关闭文件（重复关闭无副作用）
+inline auto file_close = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (file_close)");
+    assert(args->val.empty() && "function File.close need 0 arg");
+    const auto file = dynamic_cast<File*>(self);
+    assert(file != nullptr && "io: close must be called by File object");
+    file->close();
+    return new model::Nil();
+};
+
+// ========================= 模块函数 =========================
+// io.open(path[, mode])
+inline auto open = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (io.open)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function io.open need 1 or 2 args: (path[, mode])");
+
+    const auto path_obj = dynamic_cast<const model::String*>(args->val[0]);
+    assert(path_obj != nullptr && "io.open: path 必须是字符串");
+    Mode mode = Mode::Read;
+    if (args->val.size() == 2) {
+        const auto mode_obj = dynamic_cast<const model::String*>(args->val[1]);
+        assert(mode_obj != nullptr && "io.open: mode 必须是字符串");
+        mode = mode_from_name(mode_obj->val);
+    }
+    return new File(path_obj->val, mode);
+};
+
+inline void register_file_methods() {
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+
+    using model::CppFunction;
+    based_file->attrs.insert("__parent__", model::based_obj);
+    based_file->attrs.insert("read", new CppFunction(file_read));
+    based_file->attrs.insert("read_bytes", new CppFunction(file_read_bytes));
+    based_file->attrs.insert("read_into", new CppFunction(file_read_into));
+    based_file->attrs.insert("readline", new CppFunction(file_readline));
+    based_file->attrs.insert("lines", new CppFunction(file_lines));
+    based_file->attrs.insert("write", new CppFunction(file_write));
+    based_file->attrs.insert("flush", new CppFunction(file_flush));
+    based_file->attrs.insert("close", new CppFunction(file_close));
+}
+
+inline auto __init_module__ = [](model::Object* self, const model::List* args) -> model::Object* {
+    register_file_methods();
+
+    auto mod = new model::Module(
+        "io",
+        nullptr
+    );
+
+    mod->attrs.insert("open", new model::CppFunction(open));
+
+    return mod;
+};
+
+} // namespace io_lib
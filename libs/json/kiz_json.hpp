@@ -0,0 +1,781 @@
+/**
+ * @file kiz_json.hpp
+ * @brief json 标准库模块：解析与序列化
+ * 解析分两阶段：structural_index.hpp 用 SIMD 求出结构字符下标表，再沿下标表构造
+ * Dictionary / List / String / Int / Rational；json.lazy 只建下标表，按访问路径逐层取值；
+ * 序列化直接追加到 print 使用的输出缓冲或 io.File 的写缓冲
+ * @author azhz1107cat
+ * @date 2025-12-24
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../include/models.hpp"
+#include "../builtins/builtin_methods/dict_obj.hpp"
+#include "../io/kiz_io.hpp"
+#include "structural_index.hpp"
+#include "../../deps/utf8.hpp"
+
+namespace json_lib {
+
+constexpr int max_depth = 1024;
+
+inline bool is_digit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+// 标量之后必须紧跟空白、运算符或文档末尾
+inline bool is_scalar_end(const char* data, const size_t len, const size_t pos) {
+    if (pos >= len) return true;
+    const char c = data[pos];
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == ':'
+           || c == '}' || c == ']' || c == '{' || c == '[';
+}
+
+// ========================= 字符串 =========================
+// pos 为开引号位置，返回闭引号位置（跳过被转义的引号）
+inline size_t string_end(const char* data, const size_t len, const size_t pos) {
+    size_t i = pos + 1;
+    while (true) {
+        const auto q = static_cast<const char*>(std::memchr(data + i, '"', len - i));
+        assert(q != nullptr && "json: 字符串未闭合");
+        const size_t qi = static_cast<size_t>(q - data);
+        size_t backslashes = 0;
+        while (qi - 1 - backslashes > pos && data[qi - 1 - backslashes] == '\\') ++backslashes;
+        if (backslashes % 2 == 0) return qi;
+        i = qi + 1;
+    }
+}
+
+inline uint32_t parse_hex4(const char* p) {
+    uint32_t v = 0;
+    for (int k = 0; k < 4; ++k) {
+        const char c = p[k];
+        v <<= 4;
+        if (c >= '0' && c <= '9') v |= c - '0';
+        else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+        else assert(false && "json: \\u 转义需要 4 位十六进制数");
+    }
+    return v;
+}
+
+// 解码 (begin, end) 之间的字符串内容（不含引号）到 out
+inline void decode_string(const char* data, const size_t begin, const size_t end, std::string& out) {
+    const char* p = data + begin;
+    const size_t n = end - begin;
+    if (std::memchr(p, '\\', n) == nullptr) {
+        out.assign(p, n);
+        return;
+    }
+    out.clear();
+    out.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (p[i] != '\\') {
+            out += p[i];
+            continue;
+        }
+        assert(i + 1 < n && "json: 字符串末尾的转义不完整");
+        switch (p[++i]) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                assert(i + 4 < n && "json: \\u 转义不完整");
+                uint32_t cp = parse_hex4(p + i + 1);
+                i += 4;
+                // 代理对：\uD8xx\uDCxx 合成一个码点
+                if (cp >= 0xD800 && cp < 0xDC00 && i + 6 < n && p[i + 1] == '\\' && p[i + 2] == 'u') {
+                    const uint32_t low = parse_hex4(p + i + 3);
+                    if (low >= 0xDC00 && low < 0xE000) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                deps::utf8::append_code_point(out, cp);
+                break;
+            }
+            default:
+                assert(false && "json: 非法的转义字符");
+        }
+    }
+}
+
+// ========================= 数字与字面量 =========================
+// 整数在 long long 范围内直接转换；带小数或指数的数按十进制精确转为 Rational（整数值仍为 Int）
+inline model::Object* parse_number(const char* data, const size_t len, const size_t pos) {
+    size_t i = pos;
+    const bool negative = data[i] == '-';
+    if (negative) ++i;
+    const size_t int_begin = i;
+    while (i < len && is_digit(data[i])) ++i;
+    const size_t int_end = i;
+    assert(int_end > int_begin && "json: 非法的数字");
+    assert((data[int_begin] != '0' || int_end - int_begin == 1) && "json: 数字不能有前导 0");
+
+    size_t frac_begin = i, frac_end = i;
+    if (i < len && data[i] == '.') {
+        frac_begin = ++i;
+        while (i < len && is_digit(data[i])) ++i;
+        frac_end = i;
+        assert(frac_end > frac_begin && "json: 小数点后缺少数字");
+    }
+    long long exponent = 0;
+    bool has_exponent = false;
+    if (i < len && (data[i] == 'e' || data[i] == 'E')) {
+        has_exponent = true;
+        ++i;
+        bool exp_negative = false;
+        if (i < len && (data[i] == '+' || data[i] == '-')) exp_negative = data[i++] == '-';
+        const size_t exp_begin = i;
+        while (i < len && is_digit(data[i])) {
+            assert(exponent < 100000 && "json: 指数过大");
+            exponent = exponent * 10 + (data[i++] - '0');
+        }
+        assert(i > exp_begin && "json: 指数缺少数字");
+        if (exp_negative) exponent = -exponent;
+    }
+    assert(is_scalar_end(data, len, i) && "json: 非法的数字");
+
+    if (frac_begin == frac_end && !has_exponent && int_end - int_begin <= 18) {
+        long long v = 0;
+        std::from_chars(data + pos, data + int_end, v);
+        return new model::Int(deps::BigInt::from_long_long(v));
+    }
+
+    std::string digits(data + int_begin, int_end - int_begin);
+    digits.append(data + frac_begin, frac_end - frac_begin);
+    deps::BigInt mantissa(digits);
+    if (negative) mantissa = deps::BigInt(0) - mantissa;
+    const long long scale = exponent - static_cast<long long>(frac_end - frac_begin);
+    if (scale >= 0) {
+        return new model::Int(mantissa * deps::BigInt(10).pow(deps::BigInt(static_cast<size_t>(scale))));
+    }
+    auto result = deps::Rational(mantissa, deps::BigInt(10).pow(deps::BigInt(static_cast<size_t>(-scale))));
+    if (result.denominator == deps::BigInt(1)) return new model::Int(result.numerator);
+    return new model::Rational(result);
+}
+
+inline bool match_literal(const char* data, const size_t len, const size_t pos, const char* word, const size_t n) {
+    return pos + n <= len && std::memcmp(data + pos, word, n) == 0 && is_scalar_end(data, len, pos + n);
+}
+
+inline model::Object* parse_scalar(const char* data, const size_t len, const size_t pos) {
+    switch (data[pos]) {
+        case 't':
+            assert(match_literal(data, len, pos, "true", 4) && "json: 非法的字面量");
+            return new model::Bool(true);
+        case 'f':
+            assert(match_literal(data, len, pos, "false", 5) && "json: 非法的字面量");
+            return new model::Bool(false);
+        case 'n':
+            assert(match_literal(data, len, pos, "null", 4) && "json: 非法的字面量");
+            return new model::Nil();
+        default:
+            assert((data[pos] == '-' || is_digit(data[pos])) && "json: 非法的值");
+            return parse_number(data, len, pos);
+    }
+}
+
+// ========================= 第二阶段：沿下标表构造对象 =========================
+class Parser {
+    const char* data_;
+    size_t len_;
+    const std::vector<uint32_t>& index_;
+    size_t i_;
+    int depth_ = 0;
+    std::string key_;
+
+    char peek() const {
+        assert(i_ < index_.size() && "json: 文档不完整");
+        return data_[index_[i_]];
+    }
+
+    size_t next_pos() {
+        assert(i_ < index_.size() && "json: 文档不完整");
+        return index_[i_++];
+    }
+
+    model::Object* parse_object() {
+        auto dict = new model::Dictionary();
+        if (peek() == '}') {
+            ++i_;
+            return dict;
+        }
+        while (true) {
+            const size_t key_pos = next_pos();
+            assert(data_[key_pos] == '"' && "json: 对象的键必须是字符串");
+            decode_string(data_, key_pos + 1, string_end(data_, len_, key_pos), key_);
+            assert(peek() == ':' && "json: 键后缺少 ':'");
+            ++i_;
+            model::Object* value = parse_value();
+            // 重复的键：后出现的值覆盖先出现的
+            if (model::Dictionary::is_reserved_key(key_)) {
+                const auto key_obj = new model::String(key_);
+                key_obj->make_ref();
+                model::dict_store_item(dict, key_obj, value);
+                key_obj->del_ref();
+            } else {
+                value->make_ref();
+                const size_t hash = deps::hash_string(key_);
+                const auto node = dict->attrs.find_in_current(key_, hash);
+                if (node != nullptr && node->value != nullptr) node->value->del_ref();
+                dict->attrs.insert(key_, value, hash);
+            }
+
+            const char c = peek();
+            ++i_;
+            if (c == '}') return dict;
+            assert(c == ',' && "json: 对象成员之间缺少 ','");
+        }
+    }
+
+    model::Object* parse_array() {
+        std::vector<model::Object*> elems;
+        if (peek() == ']') {
+            ++i_;
+            return new model::List(std::move(elems));
+        }
+        while (true) {
+            model::Object* value = parse_value();
+            value->make_ref();
+            elems.push_back(value);
+            const char c = peek();
+            ++i_;
+            if (c == ']') return new model::List(std::move(elems));
+            assert(c == ',' && "json: 数组元素之间缺少 ','");
+        }
+    }
+
+public:
+    Parser(const char* data, const size_t len, const std::vector<uint32_t>& index, const size_t start)
+        : data_(data), len_(len), index_(index), i_(start) {}
+
+    [[nodiscard]] size_t position() const { return i_; }
+
+    model::Object* parse_value() {
+        const size_t pos = next_pos();
+        switch (data_[pos]) {
+            case '{': {
+                assert(++depth_ <= max_depth && "json: 嵌套层数过深");
+                model::Object* result = parse_object();
+                --depth_;
+                return result;
+            }
+            case '[': {
+                assert(++depth_ <= max_depth && "json: 嵌套层数过深");
+                model::Object* result = parse_array();
+                --depth_;
+                return result;
+            }
+            case '"': {
+                std::string s;
+                decode_string(data_, pos + 1, string_end(data_, len_, pos), s);
+                return new model::String(std::move(s));
+            }
+            default:
+                return parse_scalar(data_, len_, pos);
+        }
+    }
+};
+
+// 取 String / Bytes 参数的内容
+inline std::string_view text_arg(const model::Object* obj, const char* msg) {
+    if (const auto str_obj = dynamic_cast<const model::String*>(obj)) return str_obj->val;
+    const auto bytes_obj = dynamic_cast<const model::Bytes*>(obj);
+    assert(bytes_obj != nullptr && msg);
+    return bytes_obj->view();
+}
+
+inline model::Object* parse_document(const std::string_view text) {
+    assert(text.size() < UINT32_MAX && "json: 文档超过 4GiB");
+    std::vector<uint32_t> index;
+    const bool closed = simd::build_structural_index(text.data(), text.size(), index);
+    assert(closed && "json: 字符串未闭合");
+    assert(!index.empty() && "json: 空文档");
+    Parser parser(text.data(), text.size(), index, 0);
+    model::Object* result = parser.parse_value();
+    assert(parser.position() == index.size() && "json: 文档末尾有多余内容");
+    return result;
+}
+
+// ========================= 惰性模式 =========================
+// 文本与下标表；closes[i] 为下标 i 处的 { / [ 对应的闭括号在下标表中的位置
+struct LazyDoc {
+    model::Object* source;  // 持有文本所在的 String / Bytes
+    const char* data;
+    size_t len;
+    std::vector<uint32_t> index;
+    std::vector<uint32_t> closes;
+
+    LazyDoc(model::Object* src, const std::string_view text) : source(src), data(text.data()), len(text.size()) {
+        source->make_ref();
+    }
+    ~LazyDoc() {
+        source->del_ref();
+    }
+
+    [[nodiscard]] char at(const size_t i) const { return data[index[i]]; }
+
+    // 下标 i 处的值之后的下一个下标
+    [[nodiscard]] size_t skip(const size_t i) const {
+        const char c = at(i);
+        return c == '{' || c == '[' ? closes[i] + 1 : i + 1;
+    }
+};
+
+inline auto based_lazy = new model::Object();
+
+// 尚未展开的 JSON 对象 / 数组：取成员时才解析对应部分
+class Lazy : public model::Object {
+public:
+    std::shared_ptr<const LazyDoc> doc;
+    size_t pos;  // 在下标表中的位置（指向 { 或 [）
+
+    Lazy(std::shared_ptr<const LazyDoc> d, const size_t p) : doc(std::move(d)), pos(p) {
+        attrs.insert("__parent__", based_lazy);
+    }
+
+    [[nodiscard]] bool is_object() const { return doc->at(pos) == '{'; }
+
+    // 原始文本 [begin, end)
+    [[nodiscard]] std::string_view raw() const {
+        const size_t begin = doc->index[pos];
+        const size_t end = doc->index[doc->closes[pos]] + 1;
+        return {doc->data + begin, end - begin};
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return std::string("<json ") + (is_object() ? "object" : "array") + " at " + model::ptr_to_string(this) + ">";
+    }
+};
+
+// 下标 i 处的值：容器返回 Lazy，标量直接解析
+inline model::Object* lazy_value_at(const std::shared_ptr<const LazyDoc>& doc, const size_t i) {
+    const char c = doc->at(i);
+    if (c == '{' || c == '[') return new Lazy(doc, i);
+    Parser parser(doc->data, doc->len, doc->index, i);
+    return parser.parse_value();
+}
+
+// 遍历对象成员：f(键所在下标, 值所在下标)，f 返回 false 时停止
+template <typename F>
+void for_each_member(const LazyDoc& doc, const size_t pos, F&& f) {
+    size_t j = pos + 1;
+    if (doc.at(j) == '}') return;
+    while (true) {
+        assert(doc.at(j) == '"' && doc.at(j + 1) == ':' && "json: 非法的对象成员");
+        if (!f(j, j + 2)) return;
+        j = doc.skip(j + 2);
+        if (doc.at(j) == '}') return;
+        assert(doc.at(j) == ',' && "json: 对象成员之间缺少 ','");
+        ++j;
+    }
+}
+
+template <typename F>
+void for_each_element(const LazyDoc& doc, const size_t pos, F&& f) {
+    size_t j = pos + 1;
+    if (doc.at(j) == ']') return;
+    while (true) {
+        if (!f(j)) return;
+        j = doc.skip(j);
+        if (doc.at(j) == ']') return;
+        assert(doc.at(j) == ',' && "json: 数组元素之间缺少 ','");
+        ++j;
+    }
+}
+
+// 比较下标 j 处的键与 key（键中没有转义时不复制）
+inline bool key_equals(const LazyDoc& doc, const size_t j, const std::string_view key, std::string& scratch) {
+    const size_t begin = doc.index[j] + 1;
+    const size_t end = string_end(doc.data, doc.len, doc.index[j]);
+    const std::string_view raw(doc.data + begin, end - begin);
+    if (raw.find('\\') == std::string_view::npos) return raw == key;
+    decode_string(doc.data, begin, end, scratch);
+    return scratch == key;
+}
+
+inline std::shared_ptr<const LazyDoc> build_lazy_doc(model::Object* source) {
+    const std::string_view text = text_arg(source, "json.lazy: 参数必须是 String 或 Bytes");
+    assert(text.size() < UINT32_MAX && "json: 文档超过 4GiB");
+    auto doc = std::make_shared<LazyDoc>(source, text);
+    const bool closed = simd::build_structural_index(text.data(), text.size(), doc->index);
+    assert(closed && "json: 字符串未闭合");
+    assert(!doc->index.empty() && "json: 空文档");
+
+    // 一次扫描配对括号，之后跳过整个子树为 O(1)
+    doc->closes.assign(doc->index.size(), 0);
+    std::vector<uint32_t> stack;
+    for (size_t i = 0; i < doc->index.size(); ++i) {
+        const char c = doc->at(i);
+        if (c == '{' || c == '[') {
+            stack.push_back(static_cast<uint32_t>(i));
+        } else if (c == '}' || c == ']') {
+            assert(!stack.empty() && doc->at(stack.back()) == (c == '}' ? '{' : '[') && "json: 括号不匹配");
+            doc->closes[stack.back()] = static_cast<uint32_t>(i);
+            stack.pop_back();
+        }
+    }
+    assert(stack.empty() && "json: 括号不匹配");
+    return doc;
+}
+
+inline Lazy* get_lazy_self(model::Object* self, const char* method_name) {
+    const auto lazy = dynamic_cast<Lazy*>(self);
+    if (lazy == nullptr) {
+        assert(false && ("json: " + std::string(method_name) + " must be called by json lazy object").c_str());
+    }
+    return lazy;
+}
+
+// ========================= 序列化 =========================
+// 需要转义的字节：控制字符、引号、反斜杠
+inline bool needs_escape(const unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+inline void append_escaped(std::string& out, const std::string_view s) {
+    static constexpr char hex_digits[] = "0123456789abcdef";
+    out += '"';
+    size_t start = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        const auto c = static_cast<unsigned char>(s[i]);
+        if (!needs_escape(c)) continue;
+        out.append(s.data() + start, i - start);
+        start = i + 1;
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                out += "\\u00";
+                out += hex_digits[c >> 4];
+                out += hex_digits[c & 0xf];
+        }
+    }
+    out.append(s.data() + start, s.size() - start);
+    out += '"';
+}
+
+// 有理数写成十进制小数：有限小数精确输出，无限循环小数保留 17 位小数
+inline void append_rational(std::string& out, const deps::Rational& r) {
+    deps::BigInt num = r.numerator;
+    if (num < deps::BigInt(0)) {
+        out += '-';
+        num = deps::BigInt(0) - num;
+    }
+    deps::BigInt whole = num;
+    whole /= r.denominator;
+    out += whole.to_string();
+    deps::BigInt rem = num % r.denominator;
+    if (rem == deps::BigInt(0)) return;
+    out += '.';
+    for (int k = 0; k < 17 && rem != deps::BigInt(0); ++k) {
+        rem = rem * deps::BigInt(10);
+        deps::BigInt digit = rem;
+        digit /= r.denominator;
+        out += digit.to_string();
+        rem = rem % r.denominator;
+    }
+}
+
+class Writer {
+    std::string& out_;
+    deps::OutBuffer* sink_;  // 非空时每写完一个元素检查一次缓冲，超过容量即写出
+    int depth_ = 0;
+
+    void commit() {
+        if (sink_ != nullptr) sink_->commit();
+    }
+
+    void write_key(const std::string_view key) {
+        append_escaped(out_, key);
+        out_ += ':';
+    }
+
+public:
+    Writer(std::string& out, deps::OutBuffer* sink) : out_(out), sink_(sink) {}
+
+    void write(const model::Object* obj) {
+        if (obj == nullptr) {
+            out_ += "null";
+            return;
+        }
+        switch (obj->get_type()) {
+            case model::Object::ObjectType::OT_Nil:
+                out_ += "null";
+                return;
+            case model::Object::ObjectType::OT_Bool:
+                out_ += static_cast<const model::Bool*>(obj)->val ? "true" : "false";
+                return;
+            case model::Object::ObjectType::OT_Int:
+                obj->append_repr(out_);
+                return;
+            case model::Object::ObjectType::OT_Rational:
+                append_rational(out_, static_cast<const model::Rational*>(obj)->val);
+                return;
+            case model::Object::ObjectType::OT_String:
+                append_escaped(out_, static_cast<const model::String*>(obj)->val);
+                return;
+            default:
+                break;
+        }
+
+        if (const auto lazy = dynamic_cast<const Lazy*>(obj)) {
+            out_.append(lazy->raw());
+            return;
+        }
+        assert(++depth_ <= max_depth && "json: 嵌套层数过深（是否存在循环引用？）");
+        if (const auto list = dynamic_cast<const model::List*>(obj)) {
+            out_ += '[';
+            for (size_t i = 0; i < list->size(); ++i) {
+                if (i != 0) out_ += ',';
+                write(list->at(i));
+                commit();
+            }
+            out_ += ']';
+        } else if (const auto tuple = dynamic_cast<const model::Tuple*>(obj)) {
+            out_ += '[';
+            for (size_t i = 0; i < tuple->size(); ++i) {
+                if (i != 0) out_ += ',';
+                write(tuple->at(i));
+                commit();
+            }
+            out_ += ']';
+        } else if (const auto dict = dynamic_cast<const model::Dictionary*>(obj)) {
+            out_ += '{';
+            bool first = true;
+            dict->attrs.for_each([&](const std::string& key, const model::Object* val) {
+                if (key == "__parent__") return;
+                if (!first) out_ += ',';
+                first = false;
+                write_key(key);
+                write(val);
+                commit();
+            });
+            // items 中的键只接受 String（形如 __xxx__ 的键）或 Int，Int 按十进制写成字符串键
+            dict->items.for_each([&](const model::Object* key, const model::Object* val) {
+                if (!first) out_ += ',';
+                first = false;
+                if (const auto key_str = dynamic_cast<const model::String*>(key)) {
+                    write_key(key_str->val);
+                } else {
+                    assert(key->get_type() == model::Object::ObjectType::OT_Int && "json: 对象的键必须是 String 或 Int");
+                    out_ += '"';
+                    key->append_repr(out_);
+                    out_ += "\":";
+                }
+                write(val);
+                commit();
+            });
+            out_ += '}';
+        } else {
+            assert(false && "json: 该类型的对象不能序列化为 JSON");
+        }
+        --depth_;
+    }
+};
+
+// ========================= Lazy 方法 =========================
+// Lazy.getitem：对象按键、数组按下标取值（子容器仍为 Lazy）
+inline auto lazy_getitem = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (lazy_getitem)");
+    assert(args->val.size() == 1 && "function json.Lazy.getitem need 1 arg");
+    const Lazy* lazy = get_lazy_self(self, "getitem");
+    const LazyDoc& doc = *lazy->doc;
+
+    size_t found = 0;
+    bool hit = false;
+    if (lazy->is_object()) {
+        const auto key = dynamic_cast<const model::String*>(args->val[0]);
+        assert(key != nullptr && "json object key must be String type");
+        std::string scratch;
+        for_each_member(doc, lazy->pos, [&](const size_t k, const size_t v) {
+            if (!key_equals(doc, k, key->val, scratch)) return true;
+            found = v;
+            hit = true;
+            return false;
+        });
+        assert(hit && "json: 对象中无此键");
+    } else {
+        const auto idx_int = dynamic_cast<const model::Int*>(args->val[0]);
+        assert(idx_int != nullptr && "json array index must be Int type");
+        size_t n = 0;
+        for_each_element(doc, lazy->pos, [&n](size_t) { ++n; return true; });
+        const size_t target = model::normalize_index(idx_int->val, n);
+        size_t k = 0;
+        for_each_element(doc, lazy->pos, [&](const size_t v) {
+            if (k++ != target) return true;
+            found = v;
+            return false;
+        });
+    }
+    return lazy_value_at(lazy->doc, found);
+};
+
+// Lazy.contains：对象是否有该键 / 数组是否有该元素
+inline auto lazy_contains = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (lazy_contains)");
+    assert(args->val.size() == 1 && "function json.Lazy.contains need 1 arg");
+    const Lazy* lazy = get_lazy_self(self, "contains");
+    const LazyDoc& doc = *lazy->doc;
+
+    bool hit = false;
+    if (lazy->is_object()) {
+        const auto key = dynamic_cast<const model::String*>(args->val[0]);
+        if (key == nullptr) return new model::Bool(false);
+        std::string scratch;
+        for_each_member(doc, lazy->pos, [&](const size_t k, size_t) {
+            hit = key_equals(doc, k, key->val, scratch);
+            return !hit;
+        });
+    } else {
+        for_each_element(doc, lazy->pos, [&](const size_t v) {
+            model::Object* elem = lazy_value_at(lazy->doc, v);
+            elem->make_ref();
+            hit = model::objects_equal(elem, args->val[0]);
+            elem->del_ref();
+            return !hit;
+        });
+    }
+    return new model::Bool(hit);
+};
+
+// Lazy.len：成员 / 元素个数
+inline auto lazy_len = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (lazy_len)");
+    const Lazy* lazy = get_lazy_self(self, "len");
+    size_t n = 0;
+    if (lazy->is_object()) {
+        for_each_member(*lazy->doc, lazy->pos, [&n](size_t, size_t) { ++n; return true; });
+    } else {
+        for_each_element(*lazy->doc, lazy->pos, [&n](size_t) { ++n; return true; });
+    }
+    return new model::Int(deps::BigInt(n));
+};
+
+// Lazy.keys：对象的键列表
+inline auto lazy_keys = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (lazy_keys)");
+    assert(args->val.empty() && "function json.Lazy.keys need 0 arg");
+    const Lazy* lazy = get_lazy_self(self, "keys");
+    assert(lazy->is_object() && "json: keys 只能用于对象");
+    const LazyDoc& doc = *lazy->doc;
+
+    std::vector<model::Object*> keys;
+    for_each_member(doc, lazy->pos, [&](const size_t k, size_t) {
+        std::string key;
+        decode_string(doc.data, doc.index[k] + 1, string_end(doc.data, doc.len, doc.index[k]), key);
+        auto key_obj = new model::String(std::move(key));
+        key_obj->make_ref();
+        keys.push_back(key_obj);
+        return true;
+    });
+    return new model::List(std::move(keys));
+};
+
+// Lazy.get：完整展开为 Dictionary / List
+inline auto lazy_get = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (lazy_get)");
+    assert(args->val.empty() && "function json.Lazy.get need 0 arg");
+    const Lazy* lazy = get_lazy_self(self, "get");
+    Parser parser(lazy->doc->data, lazy->doc->len, lazy->doc->index, lazy->pos);
+    return parser.parse_value();
+};
+
+// ========================= 模块函数 =========================
+// json.loads(text)：text 为 String 或 Bytes
+inline auto loads = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (json.loads)");
+    assert(args->val.size() == 1 && "function json.loads need 1 arg");
+    return parse_document(text_arg(args->val[0], "json.loads: 参数必须是 String 或 Bytes"));
+};
+
+// json.lazy(text)：只建立结构下标；顶层为对象 / 数组时返回 Lazy，否则直接返回标量
+inline auto lazy = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (json.lazy)");
+    assert(args->val.size() == 1 && "function json.lazy need 1 arg");
+    const auto doc = build_lazy_doc(args->val[0]);
+    model::Object* result = lazy_value_at(doc, 0);
+    assert(doc->skip(0) == doc->index.size() && "json: 文档末尾有多余内容");
+    return result;
+};
+
+// json.dumps(obj)：序列化为 String
+inline auto dumps = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (json.dumps)");
+    assert(args->val.size() == 1 && "function json.dumps need 1 arg");
+    std::string out;
+    Writer(out, nullptr).write(args->val[0]);
+    return new model::String(std::move(out));
+};
+
+// json.dump(obj[, file])：写入 io.File（写模式），省略 file 时写到标准输出（与 print 共用缓冲）
+inline auto dump = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (json.dump)");
+    assert((args->val.size() == 1 || args->val.size() == 2) && "function json.dump need 1 or 2 args: (obj[, file])");
+    deps::OutBuffer* sink = &builtin_objects::stdout_buffer();
+    if (args->val.size() == 2) {
+        const auto file = dynamic_cast<io_lib::File*>(args->val[1]);
+        assert(file != nullptr && !file->is_closed() && file->out_buffer() != nullptr
+               && "json.dump: file 必须是以写模式打开的 io.File");
+        sink = file->out_buffer();
+    }
+    Writer(sink->buffer(), sink).write(args->val[0]);
+    if (args->val.size() == 1) {
+        sink->end_line();
+    } else {
+        sink->commit();
+    }
+    return new model::Nil();
+};
+
+inline void register_lazy_methods() {
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+
+    using model::CppFunction;
+    based_lazy->attrs.insert("__parent__", model::based_obj);
+    based_lazy->attrs.insert("__getitem__", new CppFunction(lazy_getitem));
+    based_lazy->attrs.insert("__contains__", new CppFunction(lazy_contains));
+    based_lazy->attrs.insert("__len__", new CppFunction(lazy_len));
+    based_lazy->attrs.insert("keys", new CppFunction(lazy_keys));
+    based_lazy->attrs.insert("get", new CppFunction(lazy_get));
+}
+
+inline auto __init_module__ = [](model::Object* self, const model::List* args) -> model::Object* {
+    io_lib::register_file_methods();
+    register_lazy_methods();
+
+    auto mod = new model::Module(
+        "json",
+        nullptr
+    );
+
+    mod->attrs.insert("loads", new model::CppFunction(loads, true));
+    mod->attrs.insert("lazy", new model::CppFunction(lazy));
+    mod->attrs.insert("dumps", new model::CppFunction(dumps, true));
+    mod->attrs.insert("dump", new model::CppFunction(dump));
+
+    return mod;
+};
+
+} // namespace json_lib
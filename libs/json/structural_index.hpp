@@ -0,0 +1,165 @@
+/**
+ * @file structural_index.hpp
+ * @brief JSON 解析第一阶段：按 64 字节块用 SIMD 分类字符，得到结构字符下标表
+ * 每块生成 引号 / 反斜杠 / 运算符 / 空白 四个位掩码，用位运算排除转义引号与字符串内部，
+ * 输出 {}[]:, 、字符串起始引号和标量（数字、true/false/null）首字符的位置；
+ * 第二阶段只沿下标表跳转，不再逐字节扫描结构
+ * @author azhz1107cat
+ * @date 2025-12-24
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "../array/simd_kernels.hpp"
+#include "../../deps/bit_ops.hpp"
+
+namespace json_lib::simd {
+
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t op;          // { } [ ] : ,
+    uint64_t whitespace;  // 空格 \t \n \r
+};
+
+// ========================= 字符分类 =========================
+inline BlockMasks classify_scalar(const uint8_t* p) {
+    BlockMasks m{0, 0, 0, 0};
+    for (int i = 0; i < 64; ++i) {
+        const uint8_t c = p[i];
+        const uint64_t bit = uint64_t(1) << i;
+        if (c == '"') m.quote |= bit;
+        else if (c == '\\') m.backslash |= bit;
+        else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') m.op |= bit;
+        else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') m.whitespace |= bit;
+    }
+    return m;
+}
+
+#if defined(KIZ_ARCH_X86)
+// '[' | 0x20 == '{'，']' | 0x20 == '}'：两次比较覆盖四种括号
+KIZ_TARGET_SSE2 inline void classify16(const __m128i v, uint32_t& quote, uint32_t& backslash,
+                                       uint32_t& op, uint32_t& ws) {
+    const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    quote = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))));
+    backslash = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))));
+    const __m128i ops = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+    op = static_cast<uint32_t>(_mm_movemask_epi8(ops));
+    const __m128i spaces = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+    ws = static_cast<uint32_t>(_mm_movemask_epi8(spaces));
+}
+
+KIZ_TARGET_SSE2 inline BlockMasks classify_sse2(const uint8_t* p) {
+    BlockMasks m{0, 0, 0, 0};
+    for (int k = 0; k < 4; ++k) {
+        uint32_t q, b, o, w;
+        classify16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k)), q, b, o, w);
+        m.quote |= uint64_t(q) << (16 * k);
+        m.backslash |= uint64_t(b) << (16 * k);
+        m.op |= uint64_t(o) << (16 * k);
+        m.whitespace |= uint64_t(w) << (16 * k);
+    }
+    return m;
+}
+
+KIZ_TARGET_AVX2 inline uint32_t movemask_eq256(const __m256i v, const char c) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(c))));
+}
+
+KIZ_TARGET_AVX2 inline BlockMasks classify_avx2(const uint8_t* p) {
+    BlockMasks m{0, 0, 0, 0};
+    for (int k = 0; k < 2; ++k) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * k));
+        const __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        const int shift = 32 * k;
+        m.quote |= uint64_t(movemask_eq256(v, '"')) << shift;
+        m.backslash |= uint64_t(movemask_eq256(v, '\\')) << shift;
+        m.op |= uint64_t(movemask_eq256(lower, '{') | movemask_eq256(lower, '}')
+                         | movemask_eq256(v, ':') | movemask_eq256(v, ',')) << shift;
+        m.whitespace |= uint64_t(movemask_eq256(v, ' ') | movemask_eq256(v, '\t')
+                                 | movemask_eq256(v, '\n') | movemask_eq256(v, '\r')) << shift;
+    }
+    return m;
+}
+#endif
+
+inline BlockMasks classify(const uint8_t* p) {
+#if defined(KIZ_ARCH_X86)
+    if (array_lib::simd::level == array_lib::simd::Level::AVX2) return classify_avx2(p);
+    if (array_lib::simd::level == array_lib::simd::Level::SSE2) return classify_sse2(p);
+#endif
+    return classify_scalar(p);
+}
+
+// ========================= 位运算 =========================
+// 前缀异或：第 i 位为第 0..i 位的异或（奇数个引号之后即位于字符串内）
+inline uint64_t prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// 被转义的字符：奇数长度反斜杠序列之后的那一位（prev_escaped 把跨块的状态带到下一块）
+inline uint64_t find_escaped(uint64_t backslash, uint64_t& prev_escaped) {
+    backslash &= ~prev_escaped;
+    const uint64_t follows_escape = backslash << 1 | prev_escaped;
+    constexpr uint64_t even_bits = 0x5555555555555555ULL;
+    const uint64_t odd_starts = backslash & ~even_bits & ~follows_escape;
+    uint64_t even_starts;
+    prev_escaped = deps::bits::add_overflow(odd_starts, backslash, &even_starts) ? 1 : 0;
+    const uint64_t invert_mask = even_starts << 1;
+    return (even_bits ^ invert_mask) & follows_escape;
+}
+
+// 计算 [data, data + len) 的结构字符下标；字符串未闭合时返回 false
+inline bool build_structural_index(const char* data, const size_t len, std::vector<uint32_t>& index) {
+    index.clear();
+    index.reserve(len / 6 + 8);
+    uint64_t prev_escaped = 0;
+    uint64_t prev_in_string = 0;  // 全 0 或全 1
+    uint64_t prev_scalar = 0;
+    alignas(64) uint8_t tail[64];
+
+    for (size_t base = 0; base < len; base += 64) {
+        const uint8_t* block = reinterpret_cast<const uint8_t*>(data) + base;
+        if (len - base < 64) {
+            // 末尾不足一块：复制到以空格填充的缓冲
+            std::memset(tail, ' ', sizeof(tail));
+            std::memcpy(tail, block, len - base);
+            block = tail;
+        }
+        const BlockMasks m = classify(block);
+
+        const uint64_t escaped = find_escaped(m.backslash, prev_escaped);
+        const uint64_t quote = m.quote & ~escaped;
+        // in_string 含开引号、不含闭引号
+        const uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+        prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+        const uint64_t outside = ~in_string & ~quote;
+        const uint64_t scalar = ~(m.op | m.whitespace | quote) & outside;
+        const uint64_t scalar_start = scalar & ~(scalar << 1 | prev_scalar);
+        prev_scalar = scalar >> 63;
+
+        uint64_t structurals = (m.op & outside) | (quote & in_string) | scalar_start;
+        while (structurals != 0) {
+            index.push_back(static_cast<uint32_t>(base + deps::bits::ctz(structurals)));
+            structurals &= structurals - 1;
+        }
+    }
+    return prev_in_string == 0;
+}
+
+} // namespace json_lib::simd
@@ -0,0 +1,207 @@
+/**
+ * @file gemm.hpp
+ * @brief 稠密矩阵（行优先 f64）计算内核：分块 GEMM、转置、矩阵向量乘
+ * GEMM 按 (NC, KC, MC) 三层分块并打包 A/B，最内层为 MR x NR 的寄存器分块微内核；
+ * 大矩阵按行带切分到多个线程
+ * @author azhz1107cat
+ * @date 2025-12-14
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "../array/simd_kernels.hpp"
+
+namespace matrix_lib::gemm {
+
+// 微内核寄存器分块：MR 行 x NR 列（AVX2 下为 4 x 2 个 ymm 累加器）
+constexpr size_t MR = 4;
+constexpr size_t NR = 8;
+// 缓存分块：A 块 MC x KC 放 L2，B 面板 KC x NC 放 L3
+constexpr size_t MC = 96;
+constexpr size_t KC = 256;
+constexpr size_t NC = 2048;
+
+// 计算量低于该值时不开线程（线程创建开销大于收益）
+constexpr size_t parallel_threshold = 1 << 18;
+
+// 将 [0, n) 切分成若干段并行执行 f(begin, end)；work 为总计算量估计
+template <typename F>
+void parallel_for(const size_t n, const size_t work, F&& f) {
+    size_t threads = std::max<unsigned>(1, std::thread::hardware_concurrency());
+    if (work < parallel_threshold) threads = 1;
+    threads = std::min(threads, n);
+    if (threads <= 1) {
+        f(size_t{0}, n);
+        return;
+    }
+    const size_t chunk = (n + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        const size_t begin = std::min(n, t * chunk);
+        const size_t end = std::min(n, begin + chunk);
+        if (begin < end) workers.emplace_back([&f, begin, end] { f(begin, end); });
+    }
+    f(size_t{0}, std::min(n, chunk));
+    for (auto& w : workers) w.join();
+}
+
+// 打包 A 的 mc x kc 块：每 MR 行一个面板，面板内按 k 连续存放 MR 个值（不足补 0）
+inline void pack_a(const double* a, const size_t lda, const size_t mc, const size_t kc, double* packed) {
+    for (size_t i = 0; i < mc; i += MR) {
+        const size_t rows = std::min(MR, mc - i);
+        for (size_t k = 0; k < kc; ++k) {
+            for (size_t r = 0; r < MR; ++r) {
+                *packed++ = r < rows ? a[(i + r) * lda + k] : 0.0;
+            }
+        }
+    }
+}
+
+// 打包 B 的 kc x nc 面板：每 NR 列一个面板，面板内按 k 连续存放 NR 个值（不足补 0）
+inline void pack_b(const double* b, const size_t ldb, const size_t kc, const size_t nc, double* packed) {
+    for (size_t j = 0; j < nc; j += NR) {
+        const size_t cols = std::min(NR, nc - j);
+        for (size_t k = 0; k < kc; ++k) {
+            const double* row = b + k * ldb + j;
+            for (size_t c = 0; c < NR; ++c) {
+                *packed++ = c < cols ? row[c] : 0.0;
+            }
+        }
+    }
+}
+
+// 通用微内核：C(MR x NR) += A面板 * B面板
+inline void micro_kernel_scalar(const size_t kc, const double* a, const double* b, double* c, const size_t ldc) {
+    double acc[MR][NR] = {};
+    for (size_t k = 0; k < kc; ++k) {
+        for (size_t r = 0; r < MR; ++r) {
+            const double av = a[k * MR + r];
+            for (size_t j = 0; j < NR; ++j) acc[r][j] += av * b[k * NR + j];
+        }
+    }
+    for (size_t r = 0; r < MR; ++r) {
+        for (size_t j = 0; j < NR; ++j) c[r * ldc + j] += acc[r][j];
+    }
+}
+
+#if defined(KIZ_ARCH_X86)
+// 将一行 NR 个累加结果加回 C
+KIZ_TARGET_AVX2 inline void accumulate_row_avx2(double* dst, const __m256d lo, const __m256d hi) {
+    _mm256_storeu_pd(dst, _mm256_add_pd(_mm256_loadu_pd(dst), lo));
+    _mm256_storeu_pd(dst + 4, _mm256_add_pd(_mm256_loadu_pd(dst + 4), hi));
+}
+
+KIZ_TARGET_AVX2 inline void micro_kernel_avx2(const size_t kc, const double* a, const double* b, double* c, const size_t ldc) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    for (size_t k = 0; k < kc; ++k) {
+        const __m256d b0 = _mm256_loadu_pd(b);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+        __m256d av = _mm256_broadcast_sd(a);
+        c00 = _mm256_add_pd(c00, _mm256_mul_pd(av, b0));
+        c01 = _mm256_add_pd(c01, _mm256_mul_pd(av, b1));
+        av = _mm256_broadcast_sd(a + 1);
+        c10 = _mm256_add_pd(c10, _mm256_mul_pd(av, b0));
+        c11 = _mm256_add_pd(c11, _mm256_mul_pd(av, b1));
+        av = _mm256_broadcast_sd(a + 2);
+        c20 = _mm256_add_pd(c20, _mm256_mul_pd(av, b0));
+        c21 = _mm256_add_pd(c21, _mm256_mul_pd(av, b1));
+        av = _mm256_broadcast_sd(a + 3);
+        c30 = _mm256_add_pd(c30, _mm256_mul_pd(av, b0));
+        c31 = _mm256_add_pd(c31, _mm256_mul_pd(av, b1));
+        a += MR;
+        b += NR;
+    }
+    accumulate_row_avx2(c, c00, c01);
+    accumulate_row_avx2(c + ldc, c10, c11);
+    accumulate_row_avx2(c + 2 * ldc, c20, c21);
+    accumulate_row_avx2(c + 3 * ldc, c30, c31);
+}
+#endif
+
+inline void micro_kernel(const size_t kc, const double* a, const double* b, double* c, const size_t ldc) {
+#if defined(KIZ_ARCH_X86)
+    if (array_lib::simd::level == array_lib::simd::Level::AVX2) return micro_kernel_avx2(kc, a, b, c, ldc);
+#endif
+    micro_kernel_scalar(kc, a, b, c, ldc);
+}
+
+// 计算 C 的 [row_begin, row_end) 行：C += A * B（A: m x k，B: k x n，均为行优先）
+inline void gemm_rows(const double* a, const double* b, double* c,
+    const size_t k, const size_t n, const size_t row_begin, const size_t row_end) {
+    std::vector<double> packed_a(MC * KC);
+    std::vector<double> packed_b(KC * ((std::min(NC, n) + NR - 1) / NR * NR));
+    double edge[MR * NR];
+
+    for (size_t jc = 0; jc < n; jc += NC) {
+        const size_t nc = std::min(NC, n - jc);
+        for (size_t pc = 0; pc < k; pc += KC) {
+            const size_t kc = std::min(KC, k - pc);
+            pack_b(b + pc * n + jc, n, kc, nc, packed_b.data());
+            for (size_t ic = row_begin; ic < row_end; ic += MC) {
+                const size_t mc = std::min(MC, row_end - ic);
+                pack_a(a + ic * k + pc, k, mc, kc, packed_a.data());
+                for (size_t jr = 0; jr < nc; jr += NR) {
+                    const size_t cols = std::min(NR, nc - jr);
+                    for (size_t ir = 0; ir < mc; ir += MR) {
+                        const size_t rows = std::min(MR, mc - ir);
+                        const double* pa = packed_a.data() + ir * kc;
+                        const double* pb = packed_b.data() + jr * kc;
+                        double* pc_ptr = c + (ic + ir) * n + jc + jr;
+                        if (rows == MR && cols == NR) {
+                            micro_kernel(kc, pa, pb, pc_ptr, n);
+                            continue;
+                        }
+                        // 边缘分块：先算到临时缓冲区再累加有效部分
+                        std::fill(edge, edge + MR * NR, 0.0);
+                        micro_kernel(kc, pa, pb, edge, NR);
+                        for (size_t r = 0; r < rows; ++r) {
+                            for (size_t j = 0; j < cols; ++j) pc_ptr[r * n + j] += edge[r * NR + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// C = A * B（调用方保证 C 已清零）
+inline void gemm(const double* a, const double* b, double* c, const size_t m, const size_t k, const size_t n) {
+    if (m == 0 || n == 0 || k == 0) return;
+    // 以 MC 行为单位切分给线程，保证各线程写入的 C 行不重叠
+    const size_t row_blocks = (m + MC - 1) / MC;
+    parallel_for(row_blocks, m * n * k, [&](const size_t block_begin, const size_t block_end) {
+        gemm_rows(a, b, c, k, n, block_begin * MC, std::min(m, block_end * MC));
+    });
+}
+
+// 分块转置：dst(n x m) = src(m x n)^T
+inline void transpose(const double* src, double* dst, const size_t m, const size_t n) {
+    constexpr size_t tile = 32;
+    for (size_t i0 = 0; i0 < m; i0 += tile) {
+        const size_t i1 = std::min(m, i0 + tile);
+        for (size_t j0 = 0; j0 < n; j0 += tile) {
+            const size_t j1 = std::min(n, j0 + tile);
+            for (size_t i = i0; i < i1; ++i) {
+                for (size_t j = j0; j < j1; ++j) dst[j * m + i] = src[i * n + j];
+            }
+        }
+    }
+}
+
+// y = A * x（A: m x n）
+inline void matvec(const double* a, const double* x, double* y, const size_t m, const size_t n) {
+    parallel_for(m, m * n, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) y[i] = array_lib::simd::dot(a + i * n, x, n);
+    });
+}
+
+} // namespace matrix_lib::gemm
@@ -0,0 +1,323 @@
+/**
+ * @file kiz_matrix.hpp
+ * @brief matrix 标准库模块：行优先 f64 稠密矩阵
+ * 数据与 array 模块的 Array 共用同一种对齐缓冲区，可零拷贝地互相转换
+ * @author azhz1107cat
+ * @date 2025-12-14
+ */
+
+#pragma once
+
+#include "../../include/models.hpp"
+#include "../array/kiz_array.hpp"
+#include "gemm.hpp"
+
+namespace matrix_lib {
+
+inline auto based_matrix = new model::Object();
+
+class Matrix : public model::Object {
+public:
+    size_t rows;
+    size_t cols;
+    std::shared_ptr<void> storage;
+
+    static constexpr ObjectType TYPE = ObjectType::OT_Matrix;
+    [[nodiscard]] ObjectType get_type() const override { return TYPE; }
+
+    // 新建全 0 矩阵
+    explicit Matrix(const size_t rows, const size_t cols)
+        : rows(rows), cols(cols), storage(array_lib::alloc_buffer(rows * cols * sizeof(double))) {
+        std::fill(data(), data() + rows * cols, 0.0);
+        attrs.insert("__parent__", based_matrix);
+    }
+
+    // 共享已有缓冲区（来自 f64 Array）
+    explicit Matrix(const size_t rows, const size_t cols, std::shared_ptr<void> storage)
+        : rows(rows), cols(cols), storage(std::move(storage)) {
+        attrs.insert("__parent__", based_matrix);
+    }
+
+    [[nodiscard]] double* data() const { return static_cast<double*>(storage.get()); }
+    [[nodiscard]] size_t size() const { return rows * cols; }
+
+    [[nodiscard]] std::string to_string() const override {
+        constexpr size_t edge = 4;
+        std::ostringstream oss;
+        oss << "matrix(" << rows << "x" << cols << ", [";
+        for (size_t i = 0; i < rows; ++i) {
+            if (rows > edge * 2 && i == edge) {
+                oss << "..., ";
+                i = rows - edge;
+            }
+            oss << "[";
+            for (size_t j = 0; j < cols; ++j) {
+                if (cols > edge * 2 && j == edge) {
+                    oss << "..., ";
+                    j = cols - edge;
+                }
+                oss << std::setprecision(17) << data()[i * cols + j];
+                if (j + 1 != cols) oss << ", ";
+            }
+            oss << "]";
+            if (i + 1 != rows) oss << ", ";
+        }
+        oss << "])";
+        return oss.str();
+    }
+};
+
+inline Matrix* get_self(model::Object* self, const char* method_name) {
+    const auto mat = dynamic_cast<Matrix*>(self);
+    if (mat == nullptr) {
+        assert(false && ("matrix: " + std::string(method_name) + " must be called by Matrix object").c_str());
+    }
+    return mat;
+}
+
+inline size_t get_size_arg(const model::Object* obj, const char* what) {
+    const auto int_obj = dynamic_cast<const model::Int*>(obj);
+    if (int_obj == nullptr || int_obj->val < deps::BigInt(0) || !int_obj->val.fits_long_long()) {
+        assert(false && ("matrix: " + std::string(what) + " must be a non-negative Int").c_str());
+    }
+    return static_cast<size_t>(int_obj->val.to_long_long());
+}
+
+// 由嵌套 List 构造：[[1, 2], [3, 4]]
+inline Matrix* from_nested_list(const model::List* list) {
+    const size_t rows = list->size();
+    const auto first = rows > 0 ? dynamic_cast<const model::List*>(list->at(0)) : nullptr;
+    assert((rows == 0 || first != nullptr) && "matrix.from_list need a List of Lists");
+    const size_t cols = first ? first->size() : 0;
+    const auto mat = new Matrix(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        const auto row = dynamic_cast<const model::List*>(list->at(i));
+        assert(row != nullptr && row->size() == cols && "matrix.from_list: 每行必须是等长的 List");
+        const std::vector<model::Object*>& items = row->flat();
+        for (size_t j = 0; j < cols; ++j) mat->data()[i * cols + j] = array_lib::obj_to_double(items[j]);
+    }
+    return mat;
+}
+
+// ========================= 逐元素运算 =========================
+template <array_lib::simd::BinOp OP>
+inline Matrix* elementwise(const Matrix* self, const model::Object* other) {
+    const auto result = new Matrix(self->rows, self->cols);
+    if (const auto other_mat = dynamic_cast<const Matrix*>(other)) {
+        assert(other_mat->rows == self->rows && other_mat->cols == self->cols && "matrix: 两个矩阵形状不一致");
+        array_lib::simd::binary<OP>(self->data(), other_mat->data(), false, result->data(), self->size());
+    } else {
+        const double scalar = array_lib::obj_to_double(other);
+        array_lib::simd::binary<OP>(self->data(), &scalar, true, result->data(), self->size());
+    }
+    return result;
+}
+
+#define KIZ_MATRIX_BINARY(fn_name, method, OP) \
+inline auto fn_name = [](model::Object* self, const model::List* args) -> model::Object* { \
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (" #fn_name ")"); \
+    assert(args->val.size() == 1 && "function Matrix." method " need 1 arg"); \
+    return elementwise<OP>(get_self(self, method), args->val[0]); \
+};
+
+KIZ_MATRIX_BINARY(matrix_add, "add", array_lib::simd::BinOp::Add)
+KIZ_MATRIX_BINARY(matrix_sub, "sub", array_lib::simd::BinOp::Sub)
+KIZ_MATRIX_BINARY(matrix_mul, "mul", array_lib::simd::BinOp::Mul)
+KIZ_MATRIX_BINARY(matrix_div, "div", array_lib::simd::BinOp::Div)
+#undef KIZ_MATRIX_BINARY
+
+// ========================= 线性代数 =========================
+// Matrix.matmul：矩阵乘矩阵（分块 GEMM），或矩阵乘向量（Array，返回 f64 Array）
+inline auto matrix_matmul = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix_matmul)");
+    assert(args->val.size() == 1 && "function Matrix.matmul need 1 arg");
+    const auto mat = get_self(self, "matmul");
+
+    if (const auto vec = dynamic_cast<const array_lib::Array*>(args->val[0])) {
+        assert(vec->length == mat->cols && "Matrix.matmul: 向量长度与矩阵列数不一致");
+        std::unique_ptr<array_lib::Array> converted;
+        const double* x = vec->data<double>();
+        if (vec->dtype != array_lib::DType::F64) {
+            converted.reset(array_lib::cast(vec, array_lib::DType::F64));
+            x = converted->data<double>();
+        }
+        const auto result = new array_lib::Array(array_lib::DType::F64, mat->rows);
+        gemm::matvec(mat->data(), x, result->data<double>(), mat->rows, mat->cols);
+        return result;
+    }
+
+    const auto other = dynamic_cast<const Matrix*>(args->val[0]);
+    assert(other != nullptr && "Matrix.matmul only supports Matrix or Array argument");
+    assert(mat->cols == other->rows && "Matrix.matmul: 左矩阵列数与右矩阵行数不一致");
+    const auto result = new Matrix(mat->rows, other->cols);
+    gemm::gemm(mat->data(), other->data(), result->data(), mat->rows, mat->cols, other->cols);
+    return result;
+};
+
+// Matrix.T：转置
+inline auto matrix_transpose = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix_transpose)");
+    const auto mat = get_self(self, "T");
+    const auto result = new Matrix(mat->cols, mat->rows);
+    gemm::transpose(mat->data(), result->data(), mat->rows, mat->cols);
+    return result;
+};
+
+// ========================= 元素访问 =========================
+// Matrix.get(i, j)
+inline auto matrix_get = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix_get)");
+    assert(args->val.size() == 2 && "function Matrix.get need 2 args");
+    const auto mat = get_self(self, "get");
+    const auto i = dynamic_cast<const model::Int*>(args->val[0]);
+    const auto j = dynamic_cast<const model::Int*>(args->val[1]);
+    assert(i != nullptr && j != nullptr && "Matrix.get index must be Int");
+    return array_lib::double_to_obj(mat->data()[
+        model::normalize_index(i->val, mat->rows) * mat->cols + model::normalize_index(j->val, mat->cols)
+    ]);
+};
+
+// Matrix.set(i, j, x)
+inline auto matrix_set = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix_set)");
+    assert(args->val.size() == 3 && "function Matrix.set need 3 args");
+    const auto mat = get_self(self, "set");
+    const auto i = dynamic_cast<const model::Int*>(args->val[0]);
+    const auto j = dynamic_cast<const model::Int*>(args->val[1]);
+    assert(i != nullptr && j != nullptr && "Matrix.set index must be Int");
+    mat->data()[model::normalize_index(i->val, mat->rows) * mat->cols + model::normalize_index(j->val, mat->cols)]
+        = array_lib::obj_to_double(args->val[2]);
+    return new model::Nil();
+};
+
+// Matrix.getitem：m[i] 复制第 i 行为 f64 Array
+inline auto matrix_getitem = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix_getitem)");
+    assert(args->val.size() == 1 && "function Matrix.getitem need 1 arg");
+    const auto mat = get_self(self, "getitem");
+    const auto i = dynamic_cast<const model::Int*>(args->val[0]);
+    assert(i != nullptr && "Matrix row index must be Int");
+    const size_t row = model::normalize_index(i->val, mat->rows);
+    const auto result = new array_lib::Array(array_lib::DType::F64, mat->cols);
+    std::copy_n(mat->data() + row * mat->cols, mat->cols, result->data<double>());
+    return result;
+};
+
+// Matrix.shape：[rows, cols]
+inline auto matrix_shape = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix_shape)");
+    const auto mat = get_self(self, "shape");
+    const auto rows = array_lib::i64_to_obj(static_cast<int64_t>(mat->rows));
+    const auto cols = array_lib::i64_to_obj(static_cast<int64_t>(mat->cols));
+    rows->make_ref();
+    cols->make_ref();
+    return new model::List({rows, cols});
+};
+
+// Matrix.sum：所有元素之和
+inline auto matrix_sum = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix_sum)");
+    const auto mat = get_self(self, "sum");
+    return array_lib::double_to_obj(array_lib::simd::sum(mat->data(), mat->size()));
+};
+
+// Matrix.flatten：按行展开为 f64 Array（共享缓冲区，不复制）
+inline auto matrix_flatten = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix_flatten)");
+    const auto mat = get_self(self, "flatten");
+    return new array_lib::Array(array_lib::DType::F64, mat->size(), mat->storage);
+};
+
+// Matrix.to_list：嵌套 List
+inline auto matrix_to_list = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix_to_list)");
+    const auto mat = get_self(self, "to_list");
+    std::vector<model::Object*> rows;
+    rows.reserve(mat->rows);
+    for (size_t i = 0; i < mat->rows; ++i) {
+        std::vector<model::Object*> row;
+        row.reserve(mat->cols);
+        for (size_t j = 0; j < mat->cols; ++j) {
+            model::Object* elem = array_lib::double_to_obj(mat->data()[i * mat->cols + j]);
+            elem->make_ref();
+            row.push_back(elem);
+        }
+        const auto row_list = new model::List(std::move(row));
+        row_list->make_ref();
+        rows.push_back(row_list);
+    }
+    return new model::List(std::move(rows));
+};
+
+// ========================= 模块函数 =========================
+// matrix.zeros(rows, cols)
+inline auto zeros = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix.zeros)");
+    assert(args->val.size() == 2 && "function matrix.zeros need 2 args");
+    return new Matrix(get_size_arg(args->val[0], "rows"), get_size_arg(args->val[1], "cols"));
+};
+
+// matrix.identity(n)
+inline auto identity = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix.identity)");
+    assert(args->val.size() == 1 && "function matrix.identity need 1 arg");
+    const size_t n = get_size_arg(args->val[0], "n");
+    const auto mat = new Matrix(n, n);
+    for (size_t i = 0; i < n; ++i) mat->data()[i * n + i] = 1.0;
+    return mat;
+};
+
+// matrix.from_list([[...], ...]) / matrix.from_list(array, rows, cols)
+inline auto from_list = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (matrix.from_list)");
+    if (args->val.size() == 3) {
+        const auto arr = dynamic_cast<const array_lib::Array*>(args->val[0]);
+        assert(arr != nullptr && "matrix.from_list(array, rows, cols) need an Array");
+        const size_t rows = get_size_arg(args->val[1], "rows");
+        const size_t cols = get_size_arg(args->val[2], "cols");
+        assert(rows * cols == arr->length && "matrix.from_list: 数组长度与形状不一致");
+        // f64 数组直接共享缓冲区
+        if (arr->dtype == array_lib::DType::F64) return new Matrix(rows, cols, arr->storage);
+        const std::unique_ptr<array_lib::Array> converted(array_lib::cast(arr, array_lib::DType::F64));
+        return new Matrix(rows, cols, converted->storage);
+    }
+    assert(args->val.size() == 1 && "function matrix.from_list need 1 or 3 args");
+    const auto list = dynamic_cast<const model::List*>(args->val[0]);
+    assert(list != nullptr && "matrix.from_list need a List of Lists");
+    return from_nested_list(list);
+};
+
+inline auto __init_module__ = [](model::Object* self, const model::List* args) -> model::Object* {
+    // 行、展开结果是 Array，需要 Array 的方法
+    array_lib::register_array_methods();
+
+    using model::CppFunction;
+    based_matrix->attrs.insert("__parent__", model::based_obj);
+    based_matrix->attrs.insert("__add__", new CppFunction(matrix_add));
+    based_matrix->attrs.insert("__sub__", new CppFunction(matrix_sub));
+    based_matrix->attrs.insert("__mul__", new CppFunction(matrix_mul));
+    based_matrix->attrs.insert("__div__", new CppFunction(matrix_div));
+    based_matrix->attrs.insert("__getitem__", new CppFunction(matrix_getitem));
+    based_matrix->attrs.insert("matmul", new CppFunction(matrix_matmul));
+    based_matrix->attrs.insert("T", new CppFunction(matrix_transpose));
+    based_matrix->attrs.insert("get", new CppFunction(matrix_get));
+    based_matrix->attrs.insert("set", new CppFunction(matrix_set));
+    based_matrix->attrs.insert("shape", new CppFunction(matrix_shape));
+    based_matrix->attrs.insert("sum", new CppFunction(matrix_sum));
+    based_matrix->attrs.insert("flatten", new CppFunction(matrix_flatten));
+    based_matrix->attrs.insert("to_list", new CppFunction(matrix_to_list));
+
+    auto mod = new model::Module(
+        "matrix",
+        nullptr
+    );
+
+    mod->attrs.insert("matrix", based_matrix);
+    mod->attrs.insert("zeros", new CppFunction(zeros));
+    mod->attrs.insert("identity", new CppFunction(identity));
+    mod->attrs.insert("from_list", new CppFunction(from_list));
+
+    return mod;
+};
+
+} // namespace matrix_lib
@@ -0,0 +1,288 @@
+/**
+ * @file kiz_parallel.hpp
+ * @brief parallel 标准库模块：parallel.map / parallel.reduce
+ * 输入按块切分后交给常驻线程池（deps::ThreadPool，工作窃取），结果按原顺序收集。
+ * 只接受纯原生函数（CppFunction::pure，如 len / hash / json.loads 与数值运算），直接在工作线程中调用，不经过 VM；
+ * array 上的 "+" / "*" / "min" / "max" 归约按块走 SIMD 内核。
+ * 脚本函数（以及运算方法由脚本定义的元素）需要 VM，而 VM 状态目前是进程级的，无法并行：直接报错，
+ * 请改用内置 map / reduce 在当前线程执行
+ * @author azhz1107cat
+ * @date 2025-12-27
+ */
+
+#pragma once
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "../../include/models.hpp"
+#include "../../deps/thread_pool.hpp"
+#include "../array/kiz_array.hpp"
+#include "../builtins/builtin_functions/iterators.hpp"
+
+namespace parallel_lib {
+
+// map 每个任务处理的元素个数：太小则调度开销占比高，太大则负载不均
+constexpr size_t default_chunk = 256;
+// array 归约每个任务处理的元素个数（SIMD 内核每个元素只需不到 1ns）
+constexpr size_t array_chunk = 1 << 16;
+
+// 元素来源：List / Tuple 直接按下标取，Array 在工作线程中按需装箱
+struct Source {
+    const model::List* list = nullptr;
+    const model::Tuple* tuple = nullptr;
+    const array_lib::Array* array = nullptr;
+    size_t size = 0;
+
+    // 第 i 个元素（已持有一个引用）
+    [[nodiscard]] model::Object* get(const size_t i) const {
+        model::Object* x = nullptr;
+        if (list != nullptr) x = list->at(i);
+        else if (tuple != nullptr) x = tuple->at(i);
+        else x = array_lib::element_to_obj(array, i);
+        x->make_ref();
+        return x;
+    }
+};
+
+inline Source source_of(model::Object* xs) {
+    Source src;
+    if ((src.list = dynamic_cast<const model::List*>(xs))) {
+        // 持久化表示先转为扁平数组：工作线程只做下标读取
+        src.size = src.list->flat().size();
+    } else if ((src.tuple = dynamic_cast<const model::Tuple*>(xs))) {
+        src.size = src.tuple->size();
+    } else if ((src.array = dynamic_cast<const array_lib::Array*>(xs))) {
+        src.size = src.array->length;
+    } else {
+        assert(false && "parallel: 输入必须是 List、Tuple 或 array");
+    }
+    return src;
+}
+
+inline model::CppFunction* native_of(model::Object* fn) {
+    const auto cpp_fn = dynamic_cast<model::CppFunction*>(fn);
+    return cpp_fn != nullptr && cpp_fn->pure ? cpp_fn : nullptr;
+}
+
+inline model::CppFunction* get_native_arg(model::Object* fn, const char* msg) {
+    model::CppFunction* native = native_of(fn);
+    assert(native != nullptr && msg);
+    return native;
+}
+
+inline size_t get_chunk_arg(const model::List* args, const size_t index, const size_t fallback) {
+    if (args->val.size() <= index) return fallback;
+    const size_t chunk = model::get_size_arg(args->val[index], "parallel: chunk 必须是非负整数");
+    assert(chunk > 0 && "parallel: chunk 必须大于 0");
+    return chunk;
+}
+
+// 结果对象已持有一个引用
+inline model::Object* owned(model::Object* obj) {
+    if (obj == nullptr) obj = new model::Nil();
+    obj->make_ref();
+    return obj;
+}
+
+// parallel.map(fn, xs[, chunk])：按顺序返回 [fn(x) for x in xs]
+inline auto map = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (parallel.map)");
+    assert((args->val.size() == 2 || args->val.size() == 3) && "function parallel.map need 2 or 3 args");
+    model::CppFunction* native = get_native_arg(
+        args->val[0], "parallel.map: fn 必须是纯原生函数（如 len / hash / json.loads），脚本函数请用内置 map");
+    const Source src = source_of(args->val[1]);
+    const size_t chunk = get_chunk_arg(args, 2, default_chunk);
+    std::vector<model::Object*> out(src.size, nullptr);
+
+    const size_t tasks = (src.size + chunk - 1) / chunk;
+    deps::ThreadPool::instance().parallel_for(tasks, [&](const size_t task) {
+        // 参数列表每个任务建一次，逐个元素复用
+        model::List call_args(std::vector<model::Object*>{nullptr});
+        const size_t end = std::min(src.size, (task + 1) * chunk);
+        for (size_t i = task * chunk; i < end; ++i) {
+            model::Object* x = src.get(i);
+            call_args.val[0] = x;
+            out[i] = owned(native->func(nullptr, &call_args));
+            x->del_ref();
+        }
+    });
+    return new model::List(std::move(out));
+};
+
+// 归约运算符："+" / "*" 调用 __add__ / __mul__，"min" / "max" 用 __lt__ 比较
+enum class Op { Call, Add, Mul, Min, Max };
+
+inline Op op_of(const model::Object* fn) {
+    const auto name = dynamic_cast<const model::String*>(fn);
+    if (name == nullptr) return Op::Call;
+    if (name->val == "+") return Op::Add;
+    if (name->val == "*") return Op::Mul;
+    if (name->val == "min") return Op::Min;
+    if (name->val == "max") return Op::Max;
+    assert(false && "parallel.reduce: 运算符只能是 \"+\"、\"*\"、\"min\"、\"max\" 或函数");
+    return Op::Call;
+}
+
+// 归约的一步 combine(a, b)：a、b 的引用归调用方，返回值已持有一个引用。
+// 只调用纯原生函数：元素的运算方法由脚本定义时直接报错
+inline model::Object* combine(const Op op, model::Object* fn, model::Object* a, model::Object* b) {
+    if (op == Op::Call) {
+        model::List call_args(std::vector<model::Object*>{a, b});
+        return owned(native_of(fn)->func(nullptr, &call_args));
+    }
+    const bool is_cmp = op == Op::Min || op == Op::Max;
+    // min 取 b < a 时的 b，max 取 a < b 时的 b：相等时保留靠前的元素
+    model::Object* lhs = op == Op::Min ? b : a;
+    model::Object* rhs = op == Op::Min ? a : b;
+    const char* method_name = op == Op::Add ? "__add__" : op == Op::Mul ? "__mul__" : "__lt__";
+    model::Object* method = kiz::Vm::get_attr(lhs, method_name);
+    assert(method != nullptr && "parallel.reduce: 元素不支持该运算");
+    const auto cpp_fn = get_native_arg(method, "parallel.reduce: 元素的运算方法由脚本定义，不能并行，请用内置 reduce");
+
+    model::List call_args(std::vector<model::Object*>{rhs});
+    model::Object* result = owned(cpp_fn->func(lhs, &call_args));
+    if (!is_cmp) return result;
+    const bool take_b = model::is_truthy(result);
+    result->del_ref();
+    model::Object* picked = take_b ? b : a;
+    picked->make_ref();
+    return picked;
+}
+
+// 对 src[begin, end) 从左到右归约；acc 为初值（已持有引用，可为 nullptr）
+inline model::Object* fold(const Op op, model::Object* fn, const Source& src, const size_t begin, const size_t end,
+                           model::Object* acc) {
+    for (size_t i = begin; i < end; ++i) {
+        model::Object* x = src.get(i);
+        if (acc == nullptr) {
+            acc = x;
+            continue;
+        }
+        model::Object* next = combine(op, fn, acc, x);
+        x->del_ref();
+        acc->del_ref();
+        acc = next;
+    }
+    return acc;
+}
+
+// array 上的运算符归约：每块一个机器数部分结果，再按顺序合并
+template <typename T>
+inline model::Object* reduce_array(const Op op, const array_lib::Array* arr) {
+    using Acc = std::conditional_t<std::is_floating_point_v<T>, double, int64_t>;
+    const T* data = arr->data<T>();
+    const size_t n = arr->length;
+    const size_t tasks = (n + array_chunk - 1) / array_chunk;
+    std::vector<Acc> partial(tasks);
+    deps::ThreadPool::instance().parallel_for(tasks, [&](const size_t task) {
+        const size_t begin = task * array_chunk;
+        const size_t len = std::min(n, begin + array_chunk) - begin;
+        switch (op) {
+            case Op::Add:
+                if constexpr (std::is_same_v<T, uint8_t>) {
+                    partial[task] = static_cast<Acc>(array_lib::simd::count_mask(data + begin, len));
+                } else {
+                    partial[task] = static_cast<Acc>(array_lib::simd::sum(data + begin, len));
+                }
+                break;
+            case Op::Mul: {
+                Acc product = 1;
+                for (size_t i = 0; i < len; ++i) product *= static_cast<Acc>(data[begin + i]);
+                partial[task] = product;
+                break;
+            }
+            case Op::Min:
+                partial[task] = static_cast<Acc>(array_lib::simd::min_max<true>(data + begin, len));
+                break;
+            case Op::Max:
+                partial[task] = static_cast<Acc>(array_lib::simd::min_max<false>(data + begin, len));
+                break;
+            case Op::Call:
+                break;
+        }
+    });
+    Acc total = partial[0];
+    for (size_t t = 1; t < tasks; ++t) {
+        switch (op) {
+            case Op::Add: total += partial[t]; break;
+            case Op::Mul: total *= partial[t]; break;
+            case Op::Min: total = std::min(total, partial[t]); break;
+            case Op::Max: total = std::max(total, partial[t]); break;
+            case Op::Call: break;
+        }
+    }
+    if constexpr (std::is_same_v<T, double>) return array_lib::double_to_obj(total);
+    else if constexpr (std::is_same_v<T, uint8_t>) {
+        if (op == Op::Min || op == Op::Max) return new model::Bool(total != 0);
+    }
+    return array_lib::i64_to_obj(static_cast<int64_t>(total));
+}
+
+// parallel.reduce(fn, xs[, init])：fn 为纯原生二元函数或运算符 "+" / "*" / "min" / "max"，需满足结合律；
+// 各块的部分结果按原顺序合并，所以不要求交换律
+inline auto reduce = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (parallel.reduce)");
+    assert((args->val.size() == 2 || args->val.size() == 3) && "function parallel.reduce need 2 or 3 args");
+    model::Object* fn = args->val[0];
+    const Op op = op_of(fn);
+    if (op == Op::Call) {
+        get_native_arg(fn, "parallel.reduce: fn 必须是纯原生函数或运算符，脚本函数请用内置 reduce");
+    }
+    model::Object* init = args->val.size() == 3 ? args->val[2] : nullptr;
+    const Source src = source_of(args->val[1]);
+    assert((src.size > 0 || init != nullptr) && "parallel.reduce: 空序列且没有初值");
+    if (src.size == 0) return init;
+
+    model::Object* acc = nullptr;
+    if (src.array != nullptr && op != Op::Call) {
+        acc = owned(array_lib::visit_dtype(src.array->dtype, [&](auto tag) -> model::Object* {
+            return reduce_array<decltype(tag)>(op, src.array);
+        }));
+    } else {
+        const size_t tasks = (src.size + default_chunk - 1) / default_chunk;
+        std::vector<model::Object*> partial(tasks, nullptr);
+        deps::ThreadPool::instance().parallel_for(tasks, [&](const size_t task) {
+            const size_t end = std::min(src.size, (task + 1) * default_chunk);
+            partial[task] = fold(op, fn, src, task * default_chunk, end, nullptr);
+        });
+        for (model::Object* part : partial) {
+            if (acc == nullptr) {
+                acc = part;
+                continue;
+            }
+            model::Object* next = combine(op, fn, acc, part);
+            acc->del_ref();
+            part->del_ref();
+            acc = next;
+        }
+    }
+
+    // 初值放在最左边合并
+    if (init != nullptr) {
+        model::Object* merged = combine(op, fn, init, acc);
+        acc->del_ref();
+        acc = merged;
+    }
+    // 按 CppFunction 约定放弃 acc 持有的引用
+    acc->drop_ref();
+    return acc;
+};
+
+inline auto __init_module__ = [](model::Object* self, const model::List* args) -> model::Object* {
+    array_lib::register_array_methods();
+
+    auto mod = new model::Module(
+        "parallel",
+        nullptr
+    );
+
+    mod->attrs.insert("map", new model::CppFunction(map));
+    mod->attrs.insert("reduce", new model::CppFunction(reduce));
+    mod->attrs.insert("threads", new model::Int(deps::BigInt(deps::ThreadPool::instance().size())));
+
+    return mod;
+};
+
+} // namespace parallel_lib
@@ -0,0 +1,457 @@
+/**
+ * @file kiz_re.hpp
+ * @brief re 标准库模块：正则表达式（match / search / findall / sub）
+ * 模式编译见 regex_engine.hpp；按模式字符串缓存编译结果，模块函数重复使用同一模式时不再编译。
+ * 文本可以是 String 或 bytes（如 sys.stdin.lines(true) 产出的行视图），bytes 上取出的子串是共享内存的视图
+ * @author azhz1107cat
+ * @date 2025-12-26
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../../include/models.hpp"
+#include "../../deps/utf8.hpp"
+#include "vm.hpp"
+#include "regex_engine.hpp"
+
+namespace re_lib {
+
+constexpr size_t cache_capacity = 256;
+
+inline auto based_pattern = new model::Object();
+inline auto based_match = new model::Object();
+
+class Pattern : public model::Object {
+public:
+    std::string source;
+    std::shared_ptr<engine::Regex> regex;
+
+    explicit Pattern(std::string pattern)
+        : source(std::move(pattern)), regex(std::make_shared<engine::Regex>(source)) {
+        attrs.insert("__parent__", based_pattern);
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return "<re.Pattern: \"" + source + "\" at " + model::ptr_to_string(this) + ">";
+    }
+};
+
+// 一次匹配的结果：slots 为各组的字节偏移（未参与匹配的组为 -1）
+class Match : public model::Object {
+public:
+    model::Object* subject;
+    std::shared_ptr<engine::Regex> regex;
+    std::vector<long long> slots;
+
+    Match(model::Object* text, std::shared_ptr<engine::Regex> re, std::vector<long long> spans)
+        : subject(text), regex(std::move(re)), slots(std::move(spans)) {
+        attrs.insert("__parent__", based_match);
+        subject->make_ref();
+    }
+    ~Match() override {
+        subject->del_ref();
+    }
+
+    [[nodiscard]] std::string to_string() const override {
+        return "<re.Match: span=(" + std::to_string(slots[0]) + ", " + std::to_string(slots[1]) + ") at "
+               + model::ptr_to_string(this) + ">";
+    }
+};
+
+// ========================= 文本与子串 =========================
+inline std::string_view text_of(const model::Object* obj) {
+    if (const auto str_obj = dynamic_cast<const model::String*>(obj)) return str_obj->val;
+    const auto bytes_obj = dynamic_cast<const model::Bytes*>(obj);
+    assert(bytes_obj != nullptr && "re: 文本必须是 String 或 bytes");
+    return bytes_obj->view();
+}
+
+// 与文本同类型的子串 [begin, end)：bytes 返回视图，String 返回副本
+inline model::Object* piece_of(model::Object* subject, const size_t begin, const size_t end) {
+    if (const auto bytes_obj = dynamic_cast<model::Bytes*>(subject)) return bytes_obj->slice(begin, end);
+    return new model::String(static_cast<const model::String*>(subject)->val.substr(begin, end - begin));
+}
+
+inline model::Object* make_result(const model::Object* subject, std::string text) {
+    if (dynamic_cast<const model::Bytes*>(subject) != nullptr) return new model::Bytes(std::string_view(text), false);
+    return new model::String(std::move(text));
+}
+
+// 字节偏移 -> 对外的位置：String 为码点下标，bytes 为字节下标
+inline model::Object* position_of(const model::Object* subject, const long long offset) {
+    if (offset < 0) return new model::Int(deps::BigInt::from_long_long(-1));
+    long long pos = offset;
+    if (const auto str_obj = dynamic_cast<const model::String*>(subject)) {
+        pos = static_cast<long long>(deps::utf8::count_code_points(str_obj->val.data(), static_cast<size_t>(offset)));
+    }
+    return new model::Int(deps::BigInt::from_long_long(pos));
+}
+
+// 空匹配之后前进一个字符（String 跳过整个码点）
+inline size_t advance_after_empty(const model::Object* subject, const std::string_view text, size_t pos) {
+    ++pos;
+    if (dynamic_cast<const model::String*>(subject) != nullptr) {
+        while (pos < text.size() && (static_cast<uint8_t>(text[pos]) & 0xC0) == 0x80) ++pos;
+    }
+    return pos;
+}
+
+// ========================= 模式缓存 =========================
+inline std::unordered_map<std::string, Pattern*>& pattern_cache() {
+    static std::unordered_map<std::string, Pattern*> cache;
+    return cache;
+}
+
+// 参数为 Pattern 时直接使用，为字符串时查缓存或编译
+inline Pattern* pattern_of(model::Object* obj) {
+    if (const auto pattern = dynamic_cast<Pattern*>(obj)) return pattern;
+    const auto source = dynamic_cast<const model::String*>(obj);
+    assert(source != nullptr && "re: 模式必须是 String 或 re.compile 的结果");
+
+    auto& cache = pattern_cache();
+    const auto found = cache.find(source->val);
+    if (found != cache.end()) return found->second;
+    // 缓存满时整体清空（仍被引用的 Pattern 不受影响）
+    if (cache.size() >= cache_capacity) {
+        for (const auto& [key, pattern] : cache) pattern->del_ref();
+        cache.clear();
+    }
+    auto pattern = new Pattern(source->val);
+    pattern->make_ref();
+    cache.emplace(source->val, pattern);
+    return pattern;
+}
+
+// ========================= 查找 =========================
+inline model::Object* do_search(Pattern* pattern, model::Object* subject, const bool anchored) {
+    const std::string_view text = text_of(subject);
+    std::vector<long long> slots;
+    if (!pattern->regex->search(text.data(), text.size(), 0, anchored, true, slots)) return new model::Nil();
+    return new Match(subject, pattern->regex, std::move(slots));
+}
+
+// 按 Python 的规则取 findall 的元素：无分组为整个匹配，一个分组为该组，多个分组为元组
+inline model::Object* findall_item(model::Object* subject, const int groups, const std::vector<long long>& slots) {
+    auto group_piece = [&](const int g) -> model::Object* {
+        const long long begin = slots[2 * g], end = slots[2 * g + 1];
+        if (begin < 0) return make_result(subject, std::string());
+        return piece_of(subject, static_cast<size_t>(begin), static_cast<size_t>(end));
+    };
+    if (groups == 0) return group_piece(0);
+    if (groups == 1) return group_piece(1);
+    std::vector<model::Object*> elems;
+    for (int g = 1; g <= groups; ++g) {
+        model::Object* elem = group_piece(g);
+        elem->make_ref();
+        elems.push_back(elem);
+    }
+    return new model::Tuple(elems);
+}
+
+inline model::Object* do_findall(Pattern* pattern, model::Object* subject) {
+    const std::string_view text = text_of(subject);
+    engine::Regex& regex = *pattern->regex;
+    std::vector<model::Object*> items;
+    std::vector<long long> slots;
+    size_t pos = 0;
+    while (pos <= text.size() && regex.search(text.data(), text.size(), pos, false, regex.groups() > 0, slots)) {
+        model::Object* item = findall_item(subject, regex.groups(), slots);
+        item->make_ref();
+        items.push_back(item);
+        const auto end = static_cast<size_t>(slots[1]);
+        pos = end == static_cast<size_t>(slots[0]) ? advance_after_empty(subject, text, end) : end;
+    }
+    return new model::List(std::move(items));
+}
+
+// 替换模板的一段：字面量或组引用
+struct TemplatePart {
+    std::string literal;
+    int group = -1;
+};
+
+// 解析 \1 ~ \99、\g<n>、\g<name> 与 \n \t \r \\ 转义
+inline std::vector<TemplatePart> parse_template(const std::string_view repl, const engine::Regex& regex) {
+    std::vector<TemplatePart> parts(1);
+    for (size_t i = 0; i < repl.size(); ++i) {
+        if (repl[i] != '\\' || i + 1 == repl.size()) {
+            parts.back().literal += repl[i];
+            continue;
+        }
+        const char c = repl[++i];
+        int group = -1;
+        if (c >= '0' && c <= '9') {
+            group = c - '0';
+            if (i + 1 < repl.size() && repl[i + 1] >= '0' && repl[i + 1] <= '9'
+                && group * 10 + (repl[i + 1] - '0') <= regex.groups()) {
+                group = group * 10 + (repl[++i] - '0');
+            }
+        } else if (c == 'g' && i + 1 < repl.size() && repl[i + 1] == '<') {
+            const size_t close = repl.find('>', i + 2);
+            assert(close != std::string_view::npos && "re.sub: \\g< 缺少 '>'");
+            const std::string name(repl.substr(i + 2, close - i - 2));
+            i = close;
+            const bool numeric = !name.empty() && name.find_first_not_of("0123456789") == std::string::npos;
+            group = numeric ? std::stoi(name) : regex.group_index(name);
+            assert(group >= 0 && "re.sub: 模板中引用了不存在的组名");
+        } else {
+            switch (c) {
+                case 'n': parts.back().literal += '\n'; break;
+                case 't': parts.back().literal += '\t'; break;
+                case 'r': parts.back().literal += '\r'; break;
+                case '\\': parts.back().literal += '\\'; break;
+                default:
+                    parts.back().literal += '\\';
+                    parts.back().literal += c;
+            }
+            continue;
+        }
+        assert(group <= regex.groups() && "re.sub: 模板中引用了不存在的组");
+        parts.back().group = group;
+        parts.emplace_back();
+    }
+    return parts;
+}
+
+// repl 为字符串模板或接收 Match 返回字符串的函数；count 为 0 时替换全部
+inline model::Object* do_sub(Pattern* pattern, model::Object* repl, model::Object* subject, const size_t count) {
+    const std::string_view text = text_of(subject);
+    engine::Regex& regex = *pattern->regex;
+    const auto repl_str = dynamic_cast<const model::String*>(repl);
+    std::vector<TemplatePart> parts;
+    bool need_groups = repl_str == nullptr;
+    if (repl_str != nullptr) {
+        parts = parse_template(repl_str->val, regex);
+        for (const auto& part : parts) need_groups = need_groups || part.group > 0;
+    }
+
+    std::string out;
+    std::vector<long long> slots;
+    size_t pos = 0, copied = 0, done = 0;
+    while ((count == 0 || done < count) && pos <= text.size()
+           && regex.search(text.data(), text.size(), pos, false, need_groups, slots)) {
+        const auto begin = static_cast<size_t>(slots[0]), end = static_cast<size_t>(slots[1]);
+        out.append(text.data() + copied, begin - copied);
+        if (repl_str != nullptr) {
+            for (const auto& part : parts) {
+                out += part.literal;
+                if (part.group >= 0 && slots[2 * part.group] >= 0) {
+                    const auto g_begin = static_cast<size_t>(slots[2 * part.group]);
+                    out.append(text.data() + g_begin, static_cast<size_t>(slots[2 * part.group + 1]) - g_begin);
+                }
+            }
+        } else {
+            auto match = new Match(subject, pattern->regex, slots);
+            match->make_ref();
+            model::Object* replaced = kiz::Vm::invoke(repl, new model::List({match}));
+            out += text_of(replaced);
+            replaced->del_ref();
+            match->del_ref();
+        }
+        copied = end;
+        ++done;
+        pos = end == begin ? advance_after_empty(subject, text, end) : end;
+    }
+    out.append(text.data() + copied, text.size() - copied);
+    return make_result(subject, std::move(out));
+}
+
+inline size_t count_arg(const model::Object* obj) {
+    const auto int_obj = dynamic_cast<const model::Int*>(obj);
+    assert(int_obj != nullptr && int_obj->val.fits_long_long() && int_obj->val.to_long_long() >= 0
+           && "re.sub: count 必须是非负整数");
+    return static_cast<size_t>(int_obj->val.to_long_long());
+}
+
+// ========================= Match 方法 =========================
+inline Match* get_match_self(model::Object* self, const char* method_name) {
+    const auto match = dynamic_cast<Match*>(self);
+    if (match == nullptr) {
+        assert(false && ("re: " + std::string(method_name) + " must be called by re.Match object").c_str());
+    }
+    return match;
+}
+
+// 组号参数：省略为 0（整个匹配），可为组号或组名
+inline int group_arg(const Match* match, const model::List* args) {
+    if (args->val.empty()) return 0;
+    int group;
+    if (const auto name = dynamic_cast<const model::String*>(args->val[0])) {
+        group = match->regex->group_index(name->val);
+    } else {
+        const auto index = dynamic_cast<const model::Int*>(args->val[0]);
+        assert(index != nullptr && index->val.fits_long_long() && "re.Match: 组必须是组号或组名");
+        group = static_cast<int>(index->val.to_long_long());
+    }
+    assert(group >= 0 && group <= match->regex->groups() && "re.Match: 不存在的组");
+    return group;
+}
+
+// Match.group([g])：组的内容，未参与匹配时为 Nil
+inline auto match_group = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (match_group)");
+    assert(args->val.size() <= 1 && "function re.Match.group need 0 or 1 arg");
+    const Match* match = get_match_self(self, "group");
+    const int g = group_arg(match, args);
+    if (match->slots[2 * g] < 0) return new model::Nil();
+    return piece_of(match->subject, static_cast<size_t>(match->slots[2 * g]), static_cast<size_t>(match->slots[2 * g + 1]));
+};
+
+// Match.groups()：第 1 组起各组内容组成的元组
+inline auto match_groups = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (match_groups)");
+    assert(args->val.empty() && "function re.Match.groups need 0 arg");
+    const Match* match = get_match_self(self, "groups");
+    std::vector<model::Object*> elems;
+    for (int g = 1; g <= match->regex->groups(); ++g) {
+        model::Object* elem = match->slots[2 * g] < 0
+            ? static_cast<model::Object*>(new model::Nil())
+            : piece_of(match->subject, static_cast<size_t>(match->slots[2 * g]), static_cast<size_t>(match->slots[2 * g + 1]));
+        elem->make_ref();
+        elems.push_back(elem);
+    }
+    return new model::Tuple(elems);
+};
+
+// Match.start([g]) / end([g]) / span([g])：String 为码点下标，bytes 为字节下标；未参与匹配的组为 -1
+inline auto match_start = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (match_start)");
+    assert(args->val.size() <= 1 && "function re.Match.start need 0 or 1 arg");
+    const Match* match = get_match_self(self, "start");
+    return position_of(match->subject, match->slots[2 * group_arg(match, args)]);
+};
+
+inline auto match_end = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (match_end)");
+    assert(args->val.size() <= 1 && "function re.Match.end need 0 or 1 arg");
+    const Match* match = get_match_self(self, "end");
+    return position_of(match->subject, match->slots[2 * group_arg(match, args) + 1]);
+};
+
+inline auto match_span = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (match_span)");
+    assert(args->val.size() <= 1 && "function re.Match.span need 0 or 1 arg");
+    const Match* match = get_match_self(self, "span");
+    const int g = group_arg(match, args);
+    model::Object* elems[2] = {position_of(match->subject, match->slots[2 * g]),
+                               position_of(match->subject, match->slots[2 * g + 1])};
+    elems[0]->make_ref();
+    elems[1]->make_ref();
+    return new model::Tuple(elems, 2);
+};
+
+// ========================= Pattern 方法 =========================
+inline Pattern* get_pattern_self(model::Object* self, const char* method_name) {
+    const auto pattern = dynamic_cast<Pattern*>(self);
+    if (pattern == nullptr) {
+        assert(false && ("re: " + std::string(method_name) + " must be called by re.Pattern object").c_str());
+    }
+    return pattern;
+}
+
+// Pattern.match(text)：从文本开头匹配，失败返回 Nil
+inline auto pattern_match = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (pattern_match)");
+    assert(args->val.size() == 1 && "function re.Pattern.match need 1 arg");
+    return do_search(get_pattern_self(self, "match"), args->val[0], true);
+};
+
+// Pattern.search(text)：查找第一个匹配，失败返回 Nil
+inline auto pattern_search = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (pattern_search)");
+    assert(args->val.size() == 1 && "function re.Pattern.search need 1 arg");
+    return do_search(get_pattern_self(self, "search"), args->val[0], false);
+};
+
+// Pattern.findall(text)：全部不重叠的匹配
+inline auto pattern_findall = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (pattern_findall)");
+    assert(args->val.size() == 1 && "function re.Pattern.findall need 1 arg");
+    return do_findall(get_pattern_self(self, "findall"), args->val[0]);
+};
+
+// Pattern.sub(repl, text[, count])
+inline auto pattern_sub = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (pattern_sub)");
+    assert((args->val.size() == 2 || args->val.size() == 3) && "function re.Pattern.sub need 2 or 3 args: (repl, text[, count])");
+    const size_t count = args->val.size() == 3 ? count_arg(args->val[2]) : 0;
+    return do_sub(get_pattern_self(self, "sub"), args->val[0], args->val[1], count);
+};
+
+// ========================= 模块函数 =========================
+// re.compile(pattern)：返回（缓存的）编译结果
+inline auto compile = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (re.compile)");
+    assert(args->val.size() == 1 && "function re.compile need 1 arg");
+    return pattern_of(args->val[0]);
+};
+
+inline auto match = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (re.match)");
+    assert(args->val.size() == 2 && "function re.match need 2 args: (pattern, text)");
+    return do_search(pattern_of(args->val[0]), args->val[1], true);
+};
+
+inline auto search = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (re.search)");
+    assert(args->val.size() == 2 && "function re.search need 2 args: (pattern, text)");
+    return do_search(pattern_of(args->val[0]), args->val[1], false);
+};
+
+inline auto findall = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (re.findall)");
+    assert(args->val.size() == 2 && "function re.findall need 2 args: (pattern, text)");
+    return do_findall(pattern_of(args->val[0]), args->val[1]);
+};
+
+inline auto sub = [](model::Object* self, const model::List* args) -> model::Object* {
+    DEBUG_OUTPUT("You given " + std::to_string(args->val.size()) + " arguments (re.sub)");
+    assert((args->val.size() == 3 || args->val.size() == 4) && "function re.sub need 3 or 4 args: (pattern, repl, text[, count])");
+    const size_t count = args->val.size() == 4 ? count_arg(args->val[3]) : 0;
+    return do_sub(pattern_of(args->val[0]), args->val[1], args->val[2], count);
+};
+
+inline void register_re_methods() {
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+
+    using model::CppFunction;
+    based_pattern->attrs.insert("__parent__", model::based_obj);
+    based_pattern->attrs.insert("match", new CppFunction(pattern_match));
+    based_pattern->attrs.insert("search", new CppFunction(pattern_search));
+    based_pattern->attrs.insert("findall", new CppFunction(pattern_findall));
+    based_pattern->attrs.insert("sub", new CppFunction(pattern_sub));
+
+    based_match->attrs.insert("__parent__", model::based_obj);
+    based_match->attrs.insert("group", new CppFunction(match_group));
+    based_match->attrs.insert("groups", new CppFunction(match_groups));
+    based_match->attrs.insert("start", new CppFunction(match_start));
+    based_match->attrs.insert("end", new CppFunction(match_end));
+    based_match->attrs.insert("span", new CppFunction(match_span));
+}
+
+inline auto __init_module__ = [](model::Object* self, const model::List* args) -> model::Object* {
+    register_re_methods();
+
+    auto mod = new model::Module(
+        "re",
+        nullptr
+    );
+
+    mod->attrs.insert("compile", new model::CppFunction(compile));
+    mod->attrs.insert("match", new model::CppFunction(match));
+    mod->attrs.insert("search", new model::CppFunction(search));
+    mod->attrs.insert("findall", new model::CppFunction(findall));
+    mod->attrs.insert("sub", new model::CppFunction(sub));
+
+    return mod;
+};
+
+} // namespace re_lib
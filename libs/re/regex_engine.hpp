@@ -0,0 +1,1109 @@
+/**
+ * @file regex_engine.hpp
+ * @brief 正则引擎：模式 -> 语法树 -> Thompson NFA，匹配不回溯，时间与文本长度成线性
+ * 查找分三步：必需字面量用 SIMD 子串查找预筛；正向惰性 DFA（按需构造状态，保持最左优先语义）
+ * 求匹配终点；反向 DFA 从终点向回求最长匹配得到起点。需要捕获组时在 [起点, 终点] 上跑 Pike VM，
+ * DFA 状态数超限时整次查找退回 Pike VM。
+ * 按 UTF-8 字节匹配：. 和字符类按码点展开为字节序列，\d \w \s 与 \b 只认 ASCII
+ * @author azhz1107cat
+ * @date 2025-12-26
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../deps/simd_search.hpp"
+
+namespace re_lib::engine {
+
+using ByteSet = std::bitset<256>;
+using Ranges = std::vector<std::pair<uint32_t, uint32_t>>;  // 码点闭区间
+
+constexpr uint32_t max_code_point = 0x10FFFF;
+constexpr int max_repeat = 1000;
+constexpr size_t max_insts = 100000;
+constexpr size_t max_dfa_states = 4096;
+
+enum class AssertKind : uint8_t { TextBegin, TextEnd, WordBoundary, NotWordBoundary };
+
+inline bool is_word_byte(const uint8_t c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+// ========================= 语法树 =========================
+struct Node {
+    enum class Kind { Empty, Bytes, Concat, Alternate, Repeat, Group, Assert };
+    Kind kind = Kind::Empty;
+    ByteSet set;                                // Bytes
+    std::vector<std::unique_ptr<Node>> children;  // Concat / Alternate；Repeat / Group 只有一个
+    int min = 0, max = -1;                      // Repeat，max 为 -1 表示无上限
+    bool greedy = true;
+    int group = -1;                             // Group：捕获组号，-1 为非捕获组
+    AssertKind assertion = AssertKind::TextBegin;
+};
+using NodePtr = std::unique_ptr<Node>;
+
+inline NodePtr make_node(const Node::Kind kind) {
+    auto node = std::make_unique<Node>();
+    node->kind = kind;
+    return node;
+}
+
+inline NodePtr byte_node(const uint8_t lo, const uint8_t hi) {
+    auto node = make_node(Node::Kind::Bytes);
+    for (int c = lo; c <= hi; ++c) node->set.set(c);
+    return node;
+}
+
+// ========================= 码点区间与 UTF-8 =========================
+inline void normalize(Ranges& ranges) {
+    std::sort(ranges.begin(), ranges.end());
+    Ranges merged;
+    for (const auto& r : ranges) {
+        if (!merged.empty() && r.first <= merged.back().second + 1) {
+            merged.back().second = std::max(merged.back().second, r.second);
+        } else {
+            merged.push_back(r);
+        }
+    }
+    ranges.swap(merged);
+}
+
+inline Ranges negate(const Ranges& ranges) {
+    Ranges out;
+    uint32_t next = 0;
+    for (const auto& [lo, hi] : ranges) {
+        if (lo > next) out.emplace_back(next, lo - 1);
+        next = hi + 1;
+    }
+    if (next <= max_code_point) out.emplace_back(next, max_code_point);
+    return out;
+}
+
+inline int utf8_length(const uint32_t cp) {
+    return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+}
+
+inline void encode_utf8(const uint32_t cp, uint8_t* out) {
+    switch (utf8_length(cp)) {
+        case 1:
+            out[0] = static_cast<uint8_t>(cp);
+            break;
+        case 2:
+            out[0] = static_cast<uint8_t>(0xC0 | (cp >> 6));
+            out[1] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+            break;
+        case 3:
+            out[0] = static_cast<uint8_t>(0xE0 | (cp >> 12));
+            out[1] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+            out[2] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+            break;
+        default:
+            out[0] = static_cast<uint8_t>(0xF0 | (cp >> 18));
+            out[1] = static_cast<uint8_t>(0x80 | ((cp >> 12) & 0x3F));
+            out[2] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+            out[3] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+    }
+}
+
+// 把码点区间拆成若干 UTF-8 字节区间序列：每个序列的各字节独立取值于对应区间
+inline void utf8_sequences(const uint32_t lo, const uint32_t hi,
+                           std::vector<std::vector<std::pair<uint8_t, uint8_t>>>& out) {
+    std::vector<std::pair<uint32_t, uint32_t>> stack{{lo, hi}};
+    while (!stack.empty()) {
+        const auto [s, e] = stack.back();
+        stack.pop_back();
+        // 代理区不是合法的码点
+        if (s <= 0xDFFF && e >= 0xD800) {
+            if (s < 0xD800) stack.emplace_back(s, 0xD7FF);
+            if (e > 0xDFFF) stack.emplace_back(0xE000, e);
+            continue;
+        }
+        // 先按编码长度切开，再按各个后续字节的取值边界切开
+        bool split = false;
+        for (const uint32_t bound : {0x7Fu, 0x7FFu, 0xFFFFu}) {
+            if (s <= bound && e > bound) {
+                stack.emplace_back(s, bound);
+                stack.emplace_back(bound + 1, e);
+                split = true;
+                break;
+            }
+        }
+        if (split) continue;
+        const int n = utf8_length(s);
+        for (int i = 1; i < n && !split; ++i) {
+            const uint32_t m = (1u << (6 * i)) - 1;
+            if ((s & ~m) == (e & ~m)) continue;
+            if ((s & m) != 0) {
+                stack.emplace_back(s, s | m);
+                stack.emplace_back((s | m) + 1, e);
+                split = true;
+            } else if ((e & m) != m) {
+                stack.emplace_back(s, (e & ~m) - 1);
+                stack.emplace_back(e & ~m, e);
+                split = true;
+            }
+        }
+        if (split) continue;
+        uint8_t sb[4], eb[4];
+        encode_utf8(s, sb);
+        encode_utf8(e, eb);
+        std::vector<std::pair<uint8_t, uint8_t>> seq;
+        for (int i = 0; i < n; ++i) seq.emplace_back(sb[i], eb[i]);
+        out.push_back(std::move(seq));
+    }
+}
+
+// 码点集合 -> 语法树：ASCII 部分合成一个字节集合，其余码点展开为 UTF-8 字节序列的选择
+inline NodePtr class_node(const Ranges& ranges) {
+    auto ascii = make_node(Node::Kind::Bytes);
+    std::vector<std::vector<std::pair<uint8_t, uint8_t>>> seqs;
+    for (const auto& [lo, hi] : ranges) {
+        for (uint32_t c = lo; c <= std::min<uint32_t>(hi, 0x7F); ++c) ascii->set.set(c);
+        if (hi >= 0x80) utf8_sequences(std::max<uint32_t>(lo, 0x80), hi, seqs);
+    }
+    if (seqs.empty()) return ascii;
+
+    auto alt = make_node(Node::Kind::Alternate);
+    if (ascii->set.any()) alt->children.push_back(std::move(ascii));
+    for (const auto& seq : seqs) {
+        auto concat = make_node(Node::Kind::Concat);
+        for (const auto& [b_lo, b_hi] : seq) concat->children.push_back(byte_node(b_lo, b_hi));
+        alt->children.push_back(std::move(concat));
+    }
+    if (alt->children.size() == 1) return std::move(alt->children[0]);
+    return alt;
+}
+
+// 解码 s[i] 开始的一个 UTF-8 码点，非法序列返回长度 0
+inline int decode_utf8(const std::string_view s, const size_t i, uint32_t& cp) {
+    const auto c = static_cast<uint8_t>(s[i]);
+    int n;
+    if (c < 0x80) { cp = c; return 1; }
+    if ((c & 0xE0) == 0xC0) { cp = c & 0x1F; n = 2; }
+    else if ((c & 0xF0) == 0xE0) { cp = c & 0x0F; n = 3; }
+    else if ((c & 0xF8) == 0xF0) { cp = c & 0x07; n = 4; }
+    else return 0;
+    if (i + n > s.size()) return 0;
+    for (int k = 1; k < n; ++k) {
+        const auto cc = static_cast<uint8_t>(s[i + k]);
+        if ((cc & 0xC0) != 0x80) return 0;
+        cp = cp << 6 | (cc & 0x3F);
+    }
+    return n;
+}
+
+// ========================= 模式解析 =========================
+class Parser {
+    std::string_view p_;
+    size_t i_ = 0;
+    int groups_ = 0;
+    std::vector<std::pair<std::string, int>>& names_;
+
+    [[nodiscard]] bool at(const char c) const { return i_ < p_.size() && p_[i_] == c; }
+
+    static Ranges digit_ranges() { return {{'0', '9'}}; }
+    static Ranges word_ranges() { return {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}}; }
+    static Ranges space_ranges() { return {{'\t', '\r'}, {' ', ' '}}; }
+
+    uint32_t parse_hex(const int digits) {
+        assert(i_ + digits <= p_.size() && "re: 十六进制转义不完整");
+        uint32_t v = 0;
+        for (int k = 0; k < digits; ++k) {
+            const char c = p_[i_++];
+            v <<= 4;
+            if (c >= '0' && c <= '9') v |= c - '0';
+            else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+            else assert(false && "re: 非法的十六进制转义");
+        }
+        return v;
+    }
+
+    // 解析 '\' 之后的转义：字符类转义写入 ranges 返回 true；断言写入 assertion 返回 false
+    bool parse_escape(Ranges& ranges, AssertKind& assertion, const bool in_class) {
+        assert(i_ < p_.size() && "re: 模式以 '\\' 结尾");
+        const char c = p_[i_++];
+        switch (c) {
+            case 'd': ranges = digit_ranges(); return true;
+            case 'D': ranges = negate(digit_ranges()); return true;
+            case 'w': ranges = word_ranges(); return true;
+            case 'W': ranges = negate(word_ranges()); return true;
+            case 's': ranges = space_ranges(); return true;
+            case 'S': ranges = negate(space_ranges()); return true;
+            case 'n': ranges = {{'\n', '\n'}}; return true;
+            case 't': ranges = {{'\t', '\t'}}; return true;
+            case 'r': ranges = {{'\r', '\r'}}; return true;
+            case 'f': ranges = {{'\f', '\f'}}; return true;
+            case 'v': ranges = {{'\v', '\v'}}; return true;
+            case 'a': ranges = {{'\a', '\a'}}; return true;
+            case '0': ranges = {{0, 0}}; return true;
+            case 'x': {
+                const uint32_t v = parse_hex(2);
+                ranges = {{v, v}};
+                return true;
+            }
+            case 'u': {
+                const uint32_t v = parse_hex(4);
+                ranges = {{v, v}};
+                return true;
+            }
+            default:
+                break;
+        }
+        if (in_class) {
+            assert(c != 'b' || !"re: 字符类中的 \\b 不受支持");
+        } else {
+            switch (c) {
+                case 'b': assertion = AssertKind::WordBoundary; return false;
+                case 'B': assertion = AssertKind::NotWordBoundary; return false;
+                case 'A': assertion = AssertKind::TextBegin; return false;
+                case 'z':
+                case 'Z': assertion = AssertKind::TextEnd; return false;
+                default: break;
+            }
+        }
+        assert(!(c >= '1' && c <= '9') && "re: 不支持反向引用（无法保证线性时间）");
+        assert(!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) && "re: 未知的转义");
+        // 标点等其余字符按字面匹配
+        uint32_t cp;
+        --i_;
+        const int n = decode_utf8(p_, i_, cp);
+        i_ += n == 0 ? 1 : n;
+        ranges = {{n == 0 ? static_cast<uint8_t>(c) : cp, n == 0 ? static_cast<uint8_t>(c) : cp}};
+        return true;
+    }
+
+    // 字符类中的单个字符（用于区间的两端）
+    uint32_t parse_class_char() {
+        if (at('\\')) {
+            ++i_;
+            Ranges ranges;
+            AssertKind unused;
+            parse_escape(ranges, unused, true);
+            assert(ranges.size() == 1 && ranges[0].first == ranges[0].second && "re: 字符类区间的端点必须是单个字符");
+            return ranges[0].first;
+        }
+        uint32_t cp;
+        const int n = decode_utf8(p_, i_, cp);
+        assert(n > 0 && "re: 字符类中有非法的 UTF-8 序列");
+        i_ += n;
+        return cp;
+    }
+
+    NodePtr parse_class() {
+        const bool negated = at('^');
+        if (negated) ++i_;
+        Ranges ranges;
+        bool first = true;
+        while (!at(']') || first) {
+            assert(i_ < p_.size() && "re: 字符类缺少 ']'");
+            first = false;
+            if (at('\\') && i_ + 1 < p_.size() && std::string_view("dDwWsS").find(p_[i_ + 1]) != std::string_view::npos) {
+                ++i_;
+                Ranges sub;
+                AssertKind unused;
+                parse_escape(sub, unused, true);
+                ranges.insert(ranges.end(), sub.begin(), sub.end());
+                continue;
+            }
+            const uint32_t lo = parse_class_char();
+            uint32_t hi = lo;
+            if (at('-') && i_ + 1 < p_.size() && p_[i_ + 1] != ']') {
+                ++i_;
+                hi = parse_class_char();
+                assert(lo <= hi && "re: 字符类区间的起点大于终点");
+            }
+            ranges.emplace_back(lo, hi);
+        }
+        ++i_;
+        normalize(ranges);
+        return class_node(negated ? negate(ranges) : ranges);
+    }
+
+    // 解析 {m}、{m,}、{m,n}；不是合法的重复次数时不消耗输入，'{' 按字面匹配
+    bool parse_braces(int& min, int& max) {
+        size_t j = i_ + 1;
+        auto read_int = [&](int& v) {
+            const size_t begin = j;
+            v = 0;
+            while (j < p_.size() && p_[j] >= '0' && p_[j] <= '9') {
+                v = v * 10 + (p_[j++] - '0');
+                assert(v <= max_repeat && "re: 重复次数过大");
+            }
+            return j > begin;
+        };
+        if (!read_int(min)) return false;
+        max = min;
+        if (j < p_.size() && p_[j] == ',') {
+            ++j;
+            if (!read_int(max)) max = -1;
+        }
+        if (j >= p_.size() || p_[j] != '}') return false;
+        assert((max == -1 || min <= max) && "re: 重复次数的下界大于上界");
+        i_ = j + 1;
+        return true;
+    }
+
+    NodePtr parse_group() {
+        int index = -1;
+        if (at('?')) {
+            ++i_;
+            if (at(':')) {
+                ++i_;
+            } else {
+                if (at('P')) ++i_;
+                assert(at('<') && "re: 只支持 (?:...) 与 (?P<name>...) 两种扩展分组");
+                const size_t name_begin = ++i_;
+                while (i_ < p_.size() && p_[i_] != '>') ++i_;
+                assert(i_ < p_.size() && i_ > name_begin && "re: 组名不完整");
+                index = ++groups_;
+                names_.emplace_back(std::string(p_.substr(name_begin, i_ - name_begin)), index);
+                ++i_;
+            }
+        } else {
+            index = ++groups_;
+        }
+        auto group = make_node(Node::Kind::Group);
+        group->group = index;
+        group->children.push_back(parse_alternate());
+        assert(at(')') && "re: 缺少 ')'");
+        ++i_;
+        return group;
+    }
+
+    NodePtr parse_atom() {
+        const char c = p_[i_++];
+        switch (c) {
+            case '(':
+                return parse_group();
+            case '[':
+                return parse_class();
+            case '.':
+                return class_node(negate({{'\n', '\n'}}));
+            case '^':
+            case '$': {
+                auto node = make_node(Node::Kind::Assert);
+                node->assertion = c == '^' ? AssertKind::TextBegin : AssertKind::TextEnd;
+                return node;
+            }
+            case '\\': {
+                Ranges ranges;
+                AssertKind assertion;
+                if (parse_escape(ranges, assertion, false)) return class_node(ranges);
+                auto node = make_node(Node::Kind::Assert);
+                node->assertion = assertion;
+                return node;
+            }
+            case '*':
+            case '+':
+            case '?':
+                assert(false && "re: 重复符号前没有可重复的内容");
+                return nullptr;
+            default: {
+                uint32_t cp;
+                const int n = decode_utf8(p_, i_ - 1, cp);
+                if (n == 0) return byte_node(static_cast<uint8_t>(c), static_cast<uint8_t>(c));
+                i_ += n - 1;
+                return class_node({{cp, cp}});
+            }
+        }
+    }
+
+    NodePtr parse_repeat() {
+        NodePtr atom = parse_atom();
+        while (i_ < p_.size()) {
+            int min, max;
+            const char c = p_[i_];
+            if (c == '*') { min = 0; max = -1; ++i_; }
+            else if (c == '+') { min = 1; max = -1; ++i_; }
+            else if (c == '?') { min = 0; max = 1; ++i_; }
+            else if (c == '{' && parse_braces(min, max)) {}
+            else break;
+            assert(atom->kind != Node::Kind::Assert && "re: 断言不能重复");
+            auto repeat = make_node(Node::Kind::Repeat);
+            repeat->min = min;
+            repeat->max = max;
+            repeat->greedy = !at('?');
+            if (!repeat->greedy) ++i_;
+            repeat->children.push_back(std::move(atom));
+            atom = std::move(repeat);
+        }
+        return atom;
+    }
+
+    NodePtr parse_concat() {
+        auto concat = make_node(Node::Kind::Concat);
+        while (i_ < p_.size() && p_[i_] != '|' && p_[i_] != ')') concat->children.push_back(parse_repeat());
+        if (concat->children.empty()) return make_node(Node::Kind::Empty);
+        if (concat->children.size() == 1) return std::move(concat->children[0]);
+        return concat;
+    }
+
+    NodePtr parse_alternate() {
+        NodePtr first = parse_concat();
+        if (!at('|')) return first;
+        auto alt = make_node(Node::Kind::Alternate);
+        alt->children.push_back(std::move(first));
+        while (at('|')) {
+            ++i_;
+            alt->children.push_back(parse_concat());
+        }
+        return alt;
+    }
+
+public:
+    Parser(const std::string_view pattern, std::vector<std::pair<std::string, int>>& names)
+        : p_(pattern), names_(names) {}
+
+    NodePtr parse() {
+        NodePtr root = parse_alternate();
+        assert(i_ == p_.size() && "re: 多余的 ')'");
+        return root;
+    }
+
+    [[nodiscard]] int groups() const { return groups_; }
+};
+
+// ========================= NFA 程序 =========================
+struct Inst {
+    enum class Op : uint8_t { Byte, Split, Jmp, Save, Assert, Match };
+    Op op;
+    AssertKind assertion = AssertKind::TextBegin;
+    int x = 0, y = 0;  // Byte：字节集合下标；Split：x 优先于 y；Jmp：目标；Save：槽位
+};
+
+struct Program {
+    std::vector<Inst> insts;
+    std::vector<ByteSet> sets;
+    int start = 0;       // 锚定起点
+    int unanchored = 0;  // 前面加了非贪婪的 .*? 循环
+    bool has_word_assert = false;
+    // 字节等价类：对所有字节集合（及 \b 的单词字符）表现相同的字节归为一类，DFA 转移表按类存放
+    std::array<uint8_t, 256> byte_class{};
+    int num_classes = 1;
+
+    void compute_byte_classes() {
+        std::array<int, 256> cls{};
+        int n = 1;
+        auto refine = [&](const ByteSet& set) {
+            std::vector<int> remap(2 * n, -1);
+            int next = 0;
+            for (int b = 0; b < 256; ++b) {
+                int& slot = remap[2 * cls[b] + (set.test(b) ? 1 : 0)];
+                if (slot < 0) slot = next++;
+                cls[b] = slot;
+            }
+            n = next;
+        };
+        for (const auto& set : sets) refine(set);
+        if (has_word_assert) {
+            ByteSet word;
+            for (int b = 0; b < 256; ++b) word.set(b, is_word_byte(static_cast<uint8_t>(b)));
+            refine(word);
+        }
+        for (int b = 0; b < 256; ++b) byte_class[b] = static_cast<uint8_t>(cls[b]);
+        num_classes = n;
+    }
+};
+
+// 语法树 -> 程序；reverse 为 true 时生成从右向左匹配的程序（串联倒序，不记录捕获组）
+class Compiler {
+    Program& prog_;
+    bool reverse_;
+
+    int emit(const Inst::Op op, const int x = 0, const int y = 0) {
+        assert(prog_.insts.size() < max_insts && "re: 模式展开后过大");
+        prog_.insts.push_back(Inst{op, AssertKind::TextBegin, x, y});
+        return static_cast<int>(prog_.insts.size() - 1);
+    }
+
+    [[nodiscard]] int here() const { return static_cast<int>(prog_.insts.size()); }
+
+    void compile(const Node& node) {
+        switch (node.kind) {
+            case Node::Kind::Empty:
+                return;
+            case Node::Kind::Bytes:
+                prog_.sets.push_back(node.set);
+                emit(Inst::Op::Byte, static_cast<int>(prog_.sets.size() - 1));
+                return;
+            case Node::Kind::Concat:
+                if (reverse_) {
+                    for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) compile(**it);
+                } else {
+                    for (const auto& child : node.children) compile(*child);
+                }
+                return;
+            case Node::Kind::Alternate: {
+                std::vector<int> jumps;
+                for (size_t k = 0; k < node.children.size(); ++k) {
+                    if (k + 1 == node.children.size()) {
+                        compile(*node.children[k]);
+                        break;
+                    }
+                    const int split = emit(Inst::Op::Split);
+                    prog_.insts[split].x = split + 1;
+                    compile(*node.children[k]);
+                    jumps.push_back(emit(Inst::Op::Jmp));
+                    prog_.insts[split].y = here();
+                }
+                for (const int j : jumps) prog_.insts[j].x = here();
+                return;
+            }
+            case Node::Kind::Repeat: {
+                const Node& child = *node.children[0];
+                for (int k = 0; k < node.min; ++k) compile(child);
+                if (node.max == -1) {
+                    const int split = emit(Inst::Op::Split);
+                    compile(child);
+                    emit(Inst::Op::Jmp, split);
+                    set_branches(split, node.greedy);
+                    return;
+                }
+                std::vector<int> splits;
+                for (int k = node.min; k < node.max; ++k) {
+                    splits.push_back(emit(Inst::Op::Split));
+                    compile(child);
+                }
+                for (const int split : splits) set_branches(split, node.greedy);
+                return;
+            }
+            case Node::Kind::Group:
+                if (node.group >= 0 && !reverse_) emit(Inst::Op::Save, 2 * node.group);
+                compile(*node.children[0]);
+                if (node.group >= 0 && !reverse_) emit(Inst::Op::Save, 2 * node.group + 1);
+                return;
+            case Node::Kind::Assert: {
+                const int pc = emit(Inst::Op::Assert);
+                prog_.insts[pc].assertion = node.assertion;
+                if (node.assertion == AssertKind::WordBoundary || node.assertion == AssertKind::NotWordBoundary) {
+                    prog_.has_word_assert = true;
+                }
+                return;
+            }
+        }
+    }
+
+    // 可选分支：贪婪时优先进入循环体，非贪婪时优先跳过
+    void set_branches(const int split, const bool greedy) {
+        const int body = split + 1, out = here();
+        prog_.insts[split].x = greedy ? body : out;
+        prog_.insts[split].y = greedy ? out : body;
+    }
+
+public:
+    Compiler(Program& prog, const bool reverse) : prog_(prog), reverse_(reverse) {}
+
+    void compile_program(const Node& root) {
+        // 0: Split(3, 1)  1: Byte(任意)  2: Jmp 0  —— 非贪婪的 .*?，越早的起点优先级越高
+        ByteSet any;
+        any.set();
+        prog_.sets.push_back(any);
+        prog_.unanchored = emit(Inst::Op::Split, 3, 1);
+        emit(Inst::Op::Byte, 0);
+        emit(Inst::Op::Jmp, 0);
+        prog_.start = here();
+        if (!reverse_) emit(Inst::Op::Save, 0);
+        compile(root);
+        if (!reverse_) emit(Inst::Op::Save, 1);
+        emit(Inst::Op::Match);
+        prog_.compute_byte_classes();
+    }
+};
+
+// 断言求值所需的上下文；-1 表示此时还不知道
+struct Context {
+    int8_t begin = -1, end = -1, prev_word = -1, next_word = -1;
+};
+
+inline int assert_holds(const AssertKind kind, const Context& ctx) {
+    switch (kind) {
+        case AssertKind::TextBegin: return ctx.begin;
+        case AssertKind::TextEnd: return ctx.end;
+        case AssertKind::WordBoundary:
+        case AssertKind::NotWordBoundary: {
+            if (ctx.prev_word < 0 || ctx.next_word < 0) return -1;
+            const bool boundary = ctx.prev_word != ctx.next_word;
+            return (kind == AssertKind::WordBoundary) == boundary ? 1 : 0;
+        }
+    }
+    return 0;
+}
+
+// 稀疏集合：O(1) 清空的 pc 集合
+class SparseSet {
+    std::vector<int> dense_, sparse_;
+    size_t size_ = 0;
+
+public:
+    explicit SparseSet(const size_t n) : dense_(n), sparse_(n) {}
+
+    void clear() { size_ = 0; }
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] int at(const size_t i) const { return dense_[i]; }
+
+    [[nodiscard]] bool contains(const int v) const {
+        const size_t s = static_cast<size_t>(sparse_[v]);
+        return s < size_ && dense_[s] == v;
+    }
+    // 插入，已存在时返回 false
+    bool insert(const int v) {
+        if (contains(v)) return false;
+        sparse_[v] = static_cast<int>(size_);
+        dense_[size_++] = v;
+        return true;
+    }
+};
+
+// ========================= 惰性 DFA =========================
+// 状态为按优先级排序的 NFA 指令列表（只含 Byte / Match 与尚不能判定的断言）加上前一个字节是否为单词字符。
+// 最左优先模式下遇到 Match 即截断优先级更低的线程；最长模式（反向查找起点用）不截断
+class Dfa {
+    const Program& prog_;
+    bool longest_;
+    bool forward_;
+
+    struct State {
+        std::vector<int> pcs;
+        bool prev_word;
+    };
+    std::vector<State> states_;
+    std::unordered_map<std::string, int> ids_;
+    // 转移表：(下一状态 << 1) | (当前位置是否结束一个匹配)；-1 为尚未计算
+    std::vector<int32_t> trans_;
+    std::array<int, 16> start_ids_{};
+
+    SparseSet visited_;
+    std::vector<int> stack_, expanded_, successors_, next_;
+
+    static constexpr int dead = 0;
+
+    // 按优先级展开 seeds 的 ε 闭包到 out；返回是否到达 Match
+    bool closure(const std::vector<int>& seeds, const Context& ctx, std::vector<int>& out) {
+        visited_.clear();
+        out.clear();
+        for (const int seed : seeds) {
+            stack_.clear();
+            stack_.push_back(seed);
+            while (!stack_.empty()) {
+                const int pc = stack_.back();
+                stack_.pop_back();
+                if (!visited_.insert(pc)) continue;
+                const Inst& inst = prog_.insts[pc];
+                switch (inst.op) {
+                    case Inst::Op::Jmp:
+                        stack_.push_back(inst.x);
+                        break;
+                    case Inst::Op::Split:
+                        stack_.push_back(inst.y);
+                        stack_.push_back(inst.x);
+                        break;
+                    case Inst::Op::Save:
+                        stack_.push_back(pc + 1);
+                        break;
+                    case Inst::Op::Assert: {
+                        const int holds = assert_holds(inst.assertion, ctx);
+                        if (holds > 0) stack_.push_back(pc + 1);
+                        else if (holds < 0) out.push_back(pc);
+                        break;
+                    }
+                    case Inst::Op::Byte:
+                        out.push_back(pc);
+                        break;
+                    case Inst::Op::Match:
+                        out.push_back(pc);
+                        if (!longest_) return true;
+                        break;
+                }
+            }
+        }
+        return std::any_of(out.begin(), out.end(), [this](const int pc) {
+            return prog_.insts[pc].op == Inst::Op::Match;
+        });
+    }
+
+    void reset() {
+        states_.clear();
+        ids_.clear();
+        trans_.clear();
+        start_ids_.fill(-1);
+        states_.push_back(State{{}, false});
+        ids_.emplace(std::string(), dead);
+        trans_.assign(prog_.num_classes, dead << 1);
+    }
+
+    // 查找或新建状态；超过状态数上限时清空缓存并返回 -1
+    int intern(const std::vector<int>& pcs, bool prev_word) {
+        if (!prog_.has_word_assert) prev_word = false;
+        if (pcs.empty()) return dead;
+        std::string key(reinterpret_cast<const char*>(pcs.data()), pcs.size() * sizeof(int));
+        key += prev_word ? '\1' : '\0';
+        const auto found = ids_.find(key);
+        if (found != ids_.end()) return found->second;
+        if (states_.size() >= max_dfa_states) {
+            reset();
+            return -1;
+        }
+        const int id = static_cast<int>(states_.size());
+        states_.push_back(State{pcs, prev_word});
+        ids_.emplace(std::move(key), id);
+        trans_.resize(trans_.size() + prog_.num_classes, -1);
+        return id;
+    }
+
+    // 计算状态 id 读入字节 b 的转移
+    int32_t compute(const int id, const uint8_t b) {
+        const bool word = is_word_byte(b);
+        Context full;
+        full.begin = 0;
+        full.end = 0;
+        full.prev_word = static_cast<int8_t>(states_[id].prev_word);
+        full.next_word = static_cast<int8_t>(word);
+        const bool match_here = closure(states_[id].pcs, full, expanded_);
+
+        successors_.clear();
+        for (const int pc : expanded_) {
+            const Inst& inst = prog_.insts[pc];
+            if (inst.op == Inst::Op::Byte && prog_.sets[inst.x].test(b)) successors_.push_back(pc + 1);
+        }
+        Context after;
+        after.begin = forward_ ? 0 : -1;
+        after.end = forward_ ? -1 : 0;
+        after.prev_word = static_cast<int8_t>(word);
+        closure(successors_, after, next_);
+        const int next = intern(next_, word);
+        if (next < 0) return -1;
+        const int32_t t = next << 1 | (match_here ? 1 : 0);
+        trans_[static_cast<size_t>(id) * prog_.num_classes + prog_.byte_class[b]] = t;
+        return t;
+    }
+
+    int start_state(const int start_pc, const Context& ctx) {
+        const int key = (start_pc == prog_.start ? 8 : 0) | (ctx.begin > 0 ? 4 : 0) | (ctx.end > 0 ? 2 : 0)
+                        | (ctx.prev_word > 0 ? 1 : 0);
+        if (start_ids_[key] >= 0) return start_ids_[key];
+        successors_.assign(1, start_pc);
+        closure(successors_, ctx, next_);
+        const int id = intern(next_, ctx.prev_word > 0);
+        if (id >= 0) start_ids_[key] = id;
+        return id;
+    }
+
+    bool final_match(const int id, Context ctx) {
+        ctx.prev_word = static_cast<int8_t>(states_[id].prev_word);
+        return closure(states_[id].pcs, ctx, expanded_);
+    }
+
+public:
+    Dfa(const Program& prog, const bool longest, const bool forward)
+        : prog_(prog), longest_(longest), forward_(forward), visited_(prog.insts.size()) {
+        reset();
+    }
+
+    // 从 pos 向右扫描，求最左优先匹配的终点；返回 1 找到、0 无匹配、-1 状态数超限
+    int scan_forward(const uint8_t* text, const size_t len, const size_t pos, const bool anchored, size_t& end) {
+        Context ctx;
+        ctx.begin = pos == 0 ? 1 : 0;
+        ctx.end = pos == len ? 1 : 0;
+        ctx.prev_word = pos > 0 && is_word_byte(text[pos - 1]) ? 1 : 0;
+        int id = start_state(anchored ? prog_.start : prog_.unanchored, ctx);
+        if (id < 0) return -1;
+
+        const int classes = prog_.num_classes;
+        long long last = -1;
+        size_t p = pos;
+        for (; p < len && id != dead; ++p) {
+            int32_t t = trans_[static_cast<size_t>(id) * classes + prog_.byte_class[text[p]]];
+            if (t < 0) {
+                t = compute(id, text[p]);
+                if (t < 0) return -1;
+            }
+            if (t & 1) last = static_cast<long long>(p);
+            id = t >> 1;
+        }
+        if (p == len && id != dead) {
+            Context fin;
+            fin.begin = len == 0 ? 1 : 0;
+            fin.end = 1;
+            fin.next_word = 0;
+            if (final_match(id, fin)) last = static_cast<long long>(len);
+        }
+        if (last < 0) return 0;
+        end = static_cast<size_t>(last);
+        return 1;
+    }
+
+    // 从 end 向左扫描到 limit，求最长匹配的起点（用反向程序）；返回值同 scan_forward
+    int scan_reverse(const uint8_t* text, const size_t len, const size_t end, const size_t limit, size_t& start) {
+        Context ctx;
+        ctx.begin = end == 0 ? 1 : 0;
+        ctx.end = end == len ? 1 : 0;
+        ctx.prev_word = end < len && is_word_byte(text[end]) ? 1 : 0;
+        int id = start_state(prog_.start, ctx);
+        if (id < 0) return -1;
+
+        const int classes = prog_.num_classes;
+        long long last = -1;
+        size_t p = end;
+        for (; p > limit && id != dead; --p) {
+            int32_t t = trans_[static_cast<size_t>(id) * classes + prog_.byte_class[text[p - 1]]];
+            if (t < 0) {
+                t = compute(id, text[p - 1]);
+                if (t < 0) return -1;
+            }
+            if (t & 1) last = static_cast<long long>(p);
+            id = t >> 1;
+        }
+        if (p == limit && id != dead) {
+            Context fin;
+            fin.begin = limit == 0 ? 1 : 0;
+            fin.end = limit == len ? 1 : 0;
+            fin.next_word = limit > 0 && is_word_byte(text[limit - 1]) ? 1 : 0;
+            if (final_match(id, fin)) last = static_cast<long long>(limit);
+        }
+        if (last < 0) return 0;
+        start = static_cast<size_t>(last);
+        return 1;
+    }
+};
+
+// ========================= Pike VM =========================
+// 每个 NFA 指令至多一个线程，线程携带捕获槽位；用于求捕获组和 DFA 超限时的兜底
+class PikeVm {
+    const Program& prog_;
+    size_t nslots_;
+
+    struct Threads {
+        SparseSet set;
+        std::vector<long long> caps;  // pc * nslots 起的一段
+        Threads(const size_t n, const size_t nslots) : set(n), caps(n * nslots, -1) {}
+    };
+    Threads clist_, nlist_;
+    std::vector<long long> scratch_;
+
+    struct Frame {
+        int pc;
+        int slot;  // >= 0 时为恢复槽位的帧
+        long long old;
+    };
+    std::vector<Frame> stack_;
+
+    static Context context_at(const uint8_t* text, const size_t len, const size_t p) {
+        Context ctx;
+        ctx.begin = p == 0 ? 1 : 0;
+        ctx.end = p == len ? 1 : 0;
+        ctx.prev_word = p > 0 && is_word_byte(text[p - 1]) ? 1 : 0;
+        ctx.next_word = p < len && is_word_byte(text[p]) ? 1 : 0;
+        return ctx;
+    }
+
+    // 以 scratch_ 为当前捕获槽位，把 pc 的闭包加入 list
+    void add(Threads& list, const int pc0, const size_t p, const Context& ctx) {
+        stack_.clear();
+        stack_.push_back(Frame{pc0, -1, 0});
+        while (!stack_.empty()) {
+            const Frame frame = stack_.back();
+            stack_.pop_back();
+            if (frame.slot >= 0) {
+                scratch_[frame.slot] = frame.old;
+                continue;
+            }
+            int pc = frame.pc;
+            while (list.set.insert(pc)) {
+                const Inst& inst = prog_.insts[pc];
+                if (inst.op == Inst::Op::Jmp) {
+                    pc = inst.x;
+                } else if (inst.op == Inst::Op::Split) {
+                    stack_.push_back(Frame{inst.y, -1, 0});
+                    pc = inst.x;
+                } else if (inst.op == Inst::Op::Save) {
+                    if (static_cast<size_t>(inst.x) < nslots_) {
+                        stack_.push_back(Frame{0, inst.x, scratch_[inst.x]});
+                        scratch_[inst.x] = static_cast<long long>(p);
+                    }
+                    ++pc;
+                } else if (inst.op == Inst::Op::Assert) {
+                    if (assert_holds(inst.assertion, ctx) <= 0) break;
+                    ++pc;
+                } else {
+                    std::copy(scratch_.begin(), scratch_.end(), list.caps.begin() + static_cast<long>(pc * nslots_));
+                    break;
+                }
+            }
+        }
+    }
+
+public:
+    PikeVm(const Program& prog, const size_t nslots)
+        : prog_(prog), nslots_(nslots), clist_(prog.insts.size(), nslots), nlist_(prog.insts.size(), nslots),
+          scratch_(nslots, -1) {}
+
+    // 从 pos 开始查找（anchored 时匹配必须从 pos 开始），成功时把捕获槽位写入 slots
+    bool exec(const uint8_t* text, const size_t len, const size_t pos, const bool anchored,
+              std::vector<long long>& slots) {
+        clist_.set.clear();
+        bool matched = false;
+        for (size_t p = pos;; ++p) {
+            if (!matched && (p == pos || !anchored)) {
+                std::fill(scratch_.begin(), scratch_.end(), -1);
+                add(clist_, prog_.start, p, context_at(text, len, p));
+            }
+            if (clist_.set.size() == 0) {
+                // 未锚定时起点处断言不成立只说明这里没有匹配，后面的位置仍要尝试
+                if (matched || anchored || p >= len) break;
+                continue;
+            }
+
+            nlist_.set.clear();
+            const Context next_ctx = p < len ? context_at(text, len, p + 1) : Context{};
+            for (size_t k = 0; k < clist_.set.size(); ++k) {
+                const int pc = clist_.set.at(k);
+                const Inst& inst = prog_.insts[pc];
+                const auto caps = clist_.caps.begin() + static_cast<long>(pc * nslots_);
+                if (inst.op == Inst::Op::Match) {
+                    // 优先级更低的线程全部丢弃
+                    matched = true;
+                    slots.assign(caps, caps + static_cast<long>(nslots_));
+                    break;
+                }
+                if (inst.op == Inst::Op::Byte && p < len && prog_.sets[inst.x].test(text[p])) {
+                    std::copy(caps, caps + static_cast<long>(nslots_), scratch_.begin());
+                    add(nlist_, pc + 1, p + 1, next_ctx);
+                }
+            }
+            std::swap(clist_, nlist_);
+            if (p >= len) break;
+        }
+        return matched;
+    }
+};
+
+// ========================= 编译好的正则 =========================
+class Regex {
+    int groups_ = 0;
+    std::vector<std::pair<std::string, int>> names_;
+    Program forward_, reverse_;
+    std::string required_;  // 每个匹配都必须包含的字面量
+    bool required_is_prefix_ = false;
+    std::unique_ptr<Dfa> forward_dfa_, reverse_dfa_;
+    std::unique_ptr<PikeVm> pike_;
+
+    // 顶层串联（展开其中的分组）里连续的单字节字面量，取最长的一段
+    static void flatten(const Node& node, std::vector<const Node*>& out) {
+        if (node.kind == Node::Kind::Concat) {
+            for (const auto& child : node.children) flatten(*child, out);
+        } else if (node.kind == Node::Kind::Group) {
+            flatten(*node.children[0], out);
+        } else {
+            out.push_back(&node);
+        }
+    }
+
+    void extract_literal(const Node& root) {
+        std::vector<const Node*> items;
+        flatten(root, items);
+        std::string run;
+        bool run_is_prefix = true, leading = true;
+        // 前缀字面量命中后可直接从命中处起扫，比更长的中间字面量更划算，长度够用时优先选它
+        auto finish_run = [&] {
+            if (required_is_prefix_ && required_.size() >= 2) {
+                run.clear();
+                return;
+            }
+            if (run.size() > required_.size() || (run_is_prefix && run.size() >= 2)) {
+                required_ = run;
+                required_is_prefix_ = run_is_prefix;
+            }
+            run.clear();
+            run_is_prefix = false;
+        };
+        for (const Node* item : items) {
+            if (item->kind == Node::Kind::Bytes && item->set.count() == 1) {
+                for (int b = 0; b < 256; ++b) {
+                    if (item->set.test(b)) run += static_cast<char>(b);
+                }
+                leading = false;
+            } else if (leading && item->kind == Node::Kind::Assert) {
+                // 开头的零宽断言（^、\b 等）与字面量落在同一位置，不影响前缀
+            } else {
+                leading = false;
+                finish_run();
+            }
+        }
+        finish_run();
+    }
+
+public:
+    Regex(const Regex&) = delete;
+    Regex& operator=(const Regex&) = delete;
+
+    explicit Regex(const std::string_view pattern) {
+        Parser parser(pattern, names_);
+        const NodePtr root = parser.parse();
+        groups_ = parser.groups();
+        Compiler(forward_, false).compile_program(*root);
+        Compiler(reverse_, true).compile_program(*root);
+        extract_literal(*root);
+        forward_dfa_ = std::make_unique<Dfa>(forward_, false, true);
+        reverse_dfa_ = std::make_unique<Dfa>(reverse_, true, false);
+        pike_ = std::make_unique<PikeVm>(forward_, slot_count());
+    }
+
+    [[nodiscard]] int groups() const { return groups_; }
+    [[nodiscard]] size_t slot_count() const { return 2 * static_cast<size_t>(groups_ + 1); }
+
+    // 组名 -> 组号，不存在时返回 -1
+    [[nodiscard]] int group_index(const std::string& name) const {
+        for (const auto& [n, index] : names_) {
+            if (n == name) return index;
+        }
+        return -1;
+    }
+
+    // 在 text[pos, len) 中查找；成功时 slots 为 2 * (groups + 1) 个字节偏移（未参与匹配的组为 -1）。
+    // want_groups 为 false 时只保证 slots[0]、slots[1]（整个匹配）有效
+    bool search(const char* data, const size_t len, const size_t pos, const bool anchored, const bool want_groups,
+                std::vector<long long>& slots) {
+        const auto text = reinterpret_cast<const uint8_t*>(data);
+        size_t from = pos;
+        if (!required_.empty()) {
+            const size_t hit = deps::search::find(data, len, required_.data(), required_.size(), pos);
+            if (hit == deps::search::npos) return false;
+            if (required_is_prefix_) {
+                if (anchored && hit != pos) return false;
+                from = hit;
+            }
+        }
+
+        size_t end = 0, start = from;
+        int found = forward_dfa_->scan_forward(text, len, from, anchored, end);
+        if (found == 0) return false;
+        if (found > 0 && !anchored) found = reverse_dfa_->scan_reverse(text, len, end, from, start);
+        if (found < 0) return pike_->exec(text, len, from, anchored, slots);
+        assert(found > 0 && "re: 反向查找未能确定匹配起点");
+
+        if (want_groups && groups_ > 0) {
+            const bool ok = pike_->exec(text, len, start, true, slots);
+            assert(ok && "re: 捕获组匹配与 DFA 结果不一致");
+            return ok;
+        }
+        slots.assign(slot_count(), -1);
+        slots[0] = static_cast<long long>(start);
+        slots[1] = static_cast<long long>(end);
+        return true;
+    }
+};
+
+} // namespace re_lib::engine
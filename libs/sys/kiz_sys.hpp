@@ -0,0 +1,33 @@
+/**
+ * @file kiz_sys.hpp
+ * @brief sys 标准库模块：标准输入
+ * sys.stdin 是包装 stdin 的 io.File：直接 fread 到 64KiB 读缓冲，不经过 iostream，
+ * 适合在管道中逐行处理大量输入（for 循环尚不支持，可用 map / filter / sum 等驱动 lines()）
+ * @author azhz1107cat
+ * @date 2025-12-24
+ */
+
+#pragma once
+
+#include <cstdio>
+
+#include "../../include/models.hpp"
+#include "../io/kiz_io.hpp"
+
+namespace sys_lib {
+
+inline auto __init_module__ = [](model::Object* self, const model::List* args) -> model::Object* {
+    io_lib::register_file_methods();
+
+    auto mod = new model::Module(
+        "sys",
+        nullptr
+    );
+
+    // 注意：sys.stdin 会预读一整块输入，读过 sys.stdin 后不要再混用 input()
+    mod->attrs.insert("stdin", new io_lib::File(stdin, "<stdin>"));
+
+    return mod;
+};
+
+} // namespace sys_lib
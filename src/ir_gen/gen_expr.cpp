@@ -79,6 +79,20 @@ void IRGenerator::gen_expr(Expression* expr) {
             curr_lineno_map.emplace_back(curr_code_list.size() - 1, expr->start_ln);
             break;
         }
+        case AstType::AwaitExpr: {
+            // await：生成被等待对象 -> AWAIT（协程在此挂起，恢复后结果留在栈顶）
+            auto* await_expr = dynamic_cast<AwaitExpr*>(expr);
+            assert(in_async && "gen_expr: await 只能出现在 async fn 中");
+            gen_expr(await_expr->operand.get());
+            curr_code_list.emplace_back(
+                Opcode::AWAIT,
+                std::vector<size_t>{},
+                expr->start_ln,
+                expr->end_ln
+            );
+            curr_lineno_map.emplace_back(curr_code_list.size() - 1, expr->start_ln);
+            break;
+        }
         case AstType::CallExpr:
             DEBUG_OUTPUT("gen fn call...");
             gen_fn_call(dynamic_cast<CallExpr*>(expr));
@@ -86,6 +100,9 @@ void IRGenerator::gen_expr(Expression* expr) {
         case AstType::DictDeclExpr:
             gen_dict(dynamic_cast<DictDeclExpr*>(expr));
             break;
+        case AstType::StructDeclExpr:
+            gen_struct(dynamic_cast<StructDeclExpr*>(expr));
+            break;
         case AstType::ListExpr: {
             auto list_expr = dynamic_cast<ListExpr*>(expr);
             for (const auto& e: list_expr->elements) {
@@ -100,11 +117,35 @@ void IRGenerator::gen_expr(Expression* expr) {
            );
             break;
         }
+        case AstType::TupleExpr: {
+            auto tuple_expr = dynamic_cast<TupleExpr*>(expr);
+            for (const auto& e: tuple_expr->elements) {
+                gen_expr(e.get());
+            }
+            curr_code_list.emplace_back(
+                Opcode::MAKE_TUPLE,
+                std::vector{tuple_expr->elements.size()},
+                expr->start_ln,
+                expr->end_ln
+            );
+            break;
+        }
         case AstType::GetMemberExpr: {
             // 获取成员：生成对象表达式 -> 加载属性名 -> GET_ATTR指令
             auto* get_mem = dynamic_cast<GetMemberExpr*>(expr);
             gen_expr(get_mem->father.get()); // 生成对象IR
             size_t name_idx = get_or_add_name(curr_names, get_mem->child->name);
+            // 属性名是已声明结构体的字段：按下标访问（运行时带守卫，不是结构体时退回按名查找）
+            const auto slot_it = field_slots.find(get_mem->child->name);
+            if (slot_it != field_slots.end() && slot_it->second != model::StructType::npos) {
+                curr_code_list.emplace_back(
+                    Opcode::GET_SLOT,
+                    std::vector<size_t>{slot_it->second, name_idx},
+                    expr->start_ln,
+                    expr->end_ln
+                );
+                break;
+            }
             curr_code_list.emplace_back(
                 Opcode::GET_ATTR,
                 std::vector<size_t>{name_idx},
@@ -116,10 +157,20 @@ void IRGenerator::gen_expr(Expression* expr) {
         case AstType::SetMemberExpr: {
             // 设置成员：生成对象表达式 -> 生成值表达式 -> 加载属性名 -> SET_ATTR指令
             const auto* set_mem = dynamic_cast<SetMemberExpr*>(expr);
-            gen_expr(set_mem->g_mem.get()); // 生成对象IR（假设g_mem包含对象和属性名）
-            gen_expr(set_mem->val.get());   // 生成值IR
             const auto* get_mem = dynamic_cast<GetMemberExpr*>(set_mem->g_mem.get());
+            gen_expr(get_mem->father.get()); // 生成对象IR（SET_ATTR 需要对象本身，而非旧属性值）
+            gen_expr(set_mem->val.get());   // 生成值IR
             size_t name_idx = get_or_add_name(curr_names, get_mem->child->name);
+            const auto slot_it = field_slots.find(get_mem->child->name);
+            if (slot_it != field_slots.end() && slot_it->second != model::StructType::npos) {
+                curr_code_list.emplace_back(
+                    Opcode::SET_SLOT,
+                    std::vector<size_t>{slot_it->second, name_idx},
+                    expr->start_ln,
+                    expr->end_ln
+                );
+                break;
+            }
             curr_code_list.emplace_back(
                 Opcode::SET_ATTR,
                 std::vector<size_t>{name_idx},
@@ -128,6 +179,62 @@ void IRGenerator::gen_expr(Expression* expr) {
             );
             break;
         }
+        case AstType::GetItemExpr: {
+            // 获取项：生成对象表达式 -> 生成下标表达式 -> GET_ITEM指令
+            // 切片：生成对象表达式 -> 起始 -> 结束（缺省为Nil） -> GET_SLICE指令
+            auto* get_item = dynamic_cast<GetItemExpr*>(expr);
+            gen_expr(get_item->father.get());
+            if (get_item->is_slice) {
+                for (const auto& bound : get_item->params) {
+                    if (bound) {
+                        gen_expr(bound.get());
+                        continue;
+                    }
+                    const auto nil = new model::Nil();
+                    const size_t nil_idx = get_or_add_const(curr_consts, nil);
+                    curr_code_list.emplace_back(
+                        Opcode::LOAD_CONST,
+                        std::vector<size_t>{nil_idx},
+                        expr->start_ln,
+                        expr->end_ln
+                    );
+                }
+                curr_code_list.emplace_back(
+                    Opcode::GET_SLICE,
+                    std::vector<size_t>{},
+                    expr->start_ln,
+                    expr->end_ln
+                );
+            } else {
+                assert(get_item->params.size() == 1 && "gen_expr: 下标访问仅支持一个下标");
+                gen_expr(get_item->params[0].get());
+                curr_code_list.emplace_back(
+                    Opcode::GET_ITEM,
+                    std::vector<size_t>{},
+                    expr->start_ln,
+                    expr->end_ln
+                );
+            }
+            curr_lineno_map.emplace_back(curr_code_list.size() - 1, expr->start_ln);
+            break;
+        }
+        case AstType::SetItemExpr: {
+            // 设置项：生成对象表达式 -> 生成下标表达式 -> 生成值表达式 -> SET_ITEM指令
+            const auto* set_item = dynamic_cast<SetItemExpr*>(expr);
+            const auto* get_item = dynamic_cast<GetItemExpr*>(set_item->g_item.get());
+            assert(get_item && get_item->params.size() == 1 && "gen_expr: 下标赋值仅支持一个下标");
+            gen_expr(get_item->father.get());
+            gen_expr(get_item->params[0].get());
+            gen_expr(set_item->val.get());
+            curr_code_list.emplace_back(
+                Opcode::SET_ITEM,
+                std::vector<size_t>{},
+                expr->start_ln,
+                expr->end_ln
+            );
+            curr_lineno_map.emplace_back(curr_code_list.size() - 1, expr->start_ln);
+            break;
+        }
         case AstType::FuncDeclExpr: {
             // 匿名函数：同普通函数声明，生成函数对象后加载
             auto* lambda = dynamic_cast<FnDeclExpr*>(expr);
@@ -135,11 +242,13 @@ void IRGenerator::gen_expr(Expression* expr) {
             auto save_code = curr_code_list;
             auto save_names = curr_names;
             auto save_const = curr_consts;
+            const bool save_async = in_async;
 
             // 初始化lambda代码容器
             curr_code_list.clear();
             curr_names.clear();
             curr_consts.clear();
+            in_async = lambda->is_async;
 
             // 添加参数到lambda变量表
             for (const auto& param : lambda->params) {
@@ -178,11 +287,13 @@ void IRGenerator::gen_expr(Expression* expr) {
                 code_obj,
                 lambda->params.size()
             );
+            lambda_fn->is_async = lambda->is_async;
 
             // 恢复模块级代码容器
             curr_code_list = save_code;
             curr_names = save_names;
             curr_consts = save_const;
+            in_async = save_async;
 
             // 加载lambda函数对象
             const size_t fn_const_idx = get_or_add_const(curr_consts, lambda_fn);
@@ -217,6 +328,20 @@ void IRGenerator::gen_fn_call(CallExpr* call_expr) {
     );
     curr_lineno_map.emplace_back(curr_code_list.size() - 1, call_expr->start_ln);
 
+    // 方法调用 obj.method(...)：生成对象IR后用 CALL_METHOD 绑定 self
+    if (const auto* get_mem = dynamic_cast<GetMemberExpr*>(call_expr->callee.get())) {
+        gen_expr(get_mem->father.get());
+        const size_t name_idx = get_or_add_name(curr_names, get_mem->child->name);
+        curr_code_list.emplace_back(
+            Opcode::CALL_METHOD,
+            std::vector<size_t>{name_idx},
+            call_expr->start_ln,
+            call_expr->end_ln
+        );
+        curr_lineno_map.emplace_back(curr_code_list.size() - 1, call_expr->start_ln);
+        return;
+    }
+
     // 生成函数对象的IR（压到栈顶）
     gen_expr(call_expr->callee.get());
 
@@ -232,28 +357,36 @@ void IRGenerator::gen_fn_call(CallExpr* call_expr) {
 
 void IRGenerator::gen_dict(DictDeclExpr* expr) {
     assert(expr && "gen_dict: 字典节点为空");
-    // 处理字典键值对（生成值表达式IR）
-    auto dict = new model::Dictionary();
+    // 值按顺序压栈，键名记入 names；MAKE_DICT 每次求值新建字典，字面量之间不共享
+    std::vector<size_t> key_indices;
+    key_indices.reserve(expr->init_list.size());
     for (auto& [key, val_expr] : expr->init_list) {
         gen_expr(val_expr.get());
-        // 弹出值存入字典（简化：假设栈顶为值，键为字符串常量）
-        size_t val_const_idx = curr_consts.size() - 1;
-        model::Object* val = curr_consts[val_const_idx];
-        val->make_ref();
+        key_indices.push_back(get_or_add_name(curr_names, key));
+    }
 
-        // 键转换为String对象
-        auto key_obj = new model::String(key);
-        key_obj->make_ref();
+    curr_code_list.emplace_back(
+        Opcode::MAKE_DICT,
+        std::move(key_indices),
+        expr->start_ln,
+        expr->end_ln
+    );
+    curr_lineno_map.emplace_back(curr_code_list.size() - 1, expr->start_ln);
+}
 
-        // 存入字典
-        dict->attrs.insert(key, val);
+void IRGenerator::gen_struct(const StructDeclExpr* expr) {
+    // 记录字段下标，之后的 a.x / a.x = v 据此生成 GET_SLOT / SET_SLOT
+    for (size_t i = 0; i < expr->fields.size(); ++i) {
+        const auto [it, inserted] = field_slots.emplace(expr->fields[i], i);
+        if (!inserted && it->second != i) it->second = model::StructType::npos;
     }
 
-    // 将字典对象加入常量池并加载
-    size_t dict_const_idx = get_or_add_const(curr_consts, dict);
+    // 结构体类型对象作为常量加载
+    auto* struct_type = new model::StructType(expr->name, expr->fields);
+    size_t type_const_idx = get_or_add_const(curr_consts, struct_type);
     curr_code_list.emplace_back(
         Opcode::LOAD_CONST,
-        std::vector<size_t>{dict_const_idx},
+        std::vector<size_t>{type_const_idx},
         expr->start_ln,
         expr->end_ln
     );
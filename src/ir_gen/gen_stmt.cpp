@@ -50,6 +50,34 @@ void IRGenerator::gen_block(const BlockStmt* block) {
                 );
                 break;
             }
+            case AstType::UnpackAssignStmt: {
+                // 解包赋值：UNPACK_SEQ 按原顺序压入各元素，再按逆序存入变量
+                const auto* unpack = dynamic_cast<UnpackAssignStmt*>(stmt.get());
+                const auto* rhs_tuple = dynamic_cast<TupleExpr*>(unpack->expr.get());
+                if (rhs_tuple != nullptr && rhs_tuple->elements.size() == unpack->names.size()) {
+                    // a, b = b, a：右侧逐个求值后直接赋值，不创建 Tuple
+                    for (const auto& e : rhs_tuple->elements) {
+                        gen_expr(e.get());
+                    }
+                } else {
+                    gen_expr(unpack->expr.get());
+                    curr_code_list.emplace_back(
+                        Opcode::UNPACK_SEQ,
+                        std::vector<size_t>{unpack->names.size()},
+                        stmt->start_ln,
+                        stmt->end_ln
+                    );
+                }
+                for (auto it = unpack->names.rbegin(); it != unpack->names.rend(); ++it) {
+                    curr_code_list.emplace_back(
+                        Opcode::SET_LOCAL,
+                        std::vector<size_t>{get_or_add_name(curr_names, *it)},
+                        stmt->start_ln,
+                        stmt->end_ln
+                    );
+                }
+                break;
+            }
             case AstType::NonlocalAssignStmt: {
                 // 变量声明：生成初始化表达式IR + 存储变量指令
                 const auto* var_decl = dynamic_cast<AssignStmt*>(stmt.get());
@@ -100,6 +128,19 @@ void IRGenerator::gen_block(const BlockStmt* block) {
             case AstType::ReturnStmt: {
                 // 返回语句：生成返回值表达式IR + RET指令
                 auto* ret_stmt = dynamic_cast<ReturnStmt*>(stmt.get());
+                if (auto* tuple_expr = dynamic_cast<TupleExpr*>(ret_stmt->expr.get())) {
+                    // return a, b：各值直接压栈后 RET_MULTI，调用方紧接着解包时不创建 Tuple
+                    for (const auto& e : tuple_expr->elements) {
+                        gen_expr(e.get());
+                    }
+                    curr_code_list.emplace_back(
+                        Opcode::RET_MULTI,
+                        std::vector<size_t>{tuple_expr->elements.size()},
+                        stmt->start_ln,
+                        stmt->end_ln
+                    );
+                    break;
+                }
                 if (ret_stmt->expr) {
                     gen_expr(ret_stmt->expr.get());
                 } else {
@@ -121,6 +162,18 @@ void IRGenerator::gen_block(const BlockStmt* block) {
                 );
                 break;
             }
+            case AstType::ImportStmt: {
+                // 导入语句：IMPORT 模块名索引（模块对象绑定到同名变量）
+                const auto* import_stmt = dynamic_cast<ImportStmt*>(stmt.get());
+                const size_t name_idx = get_or_add_name(curr_names, import_stmt->path);
+                curr_code_list.emplace_back(
+                    Opcode::IMPORT,
+                    std::vector<size_t>{name_idx},
+                    stmt->start_ln,
+                    stmt->end_ln
+                );
+                break;
+            }
             case AstType::BreakStmt:
                 // Break语句：跳转到循环结束位置（依赖block_stack记录循环出口）
                 assert(!block_stack.empty() && "BreakStmt: 无活跃循环块");
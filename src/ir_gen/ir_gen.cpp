@@ -119,7 +119,8 @@ model::Rational* IRGenerator::make_rational_obj(NumberExpr* num_expr) {
 model::String* IRGenerator::make_string_obj(const StringExpr* str_expr) {
     DEBUG_OUTPUT("making string object...");
     assert(str_expr && "make_string_obj: 字符串节点为空");
-    auto str_obj = new model::String(str_expr->value);
+    // 字面量统一驻留：相同字面量共享一个对象，比较时可直接比较指针
+    auto str_obj = model::intern_string(str_expr->value);
     return str_obj;
 }
 
@@ -32,10 +32,13 @@ void register_keywords() {
     keywords["break"] = TokenType::Break;
     keywords["next"] = TokenType::Next;
     keywords["dict"] = TokenType::Dict;
+    keywords["struct"] = TokenType::Struct;
     keywords["end"] = TokenType::End;
     keywords["true"] = TokenType::True;
     keywords["false"] = TokenType::False;
     keywords["null"] = TokenType::Null;
+    keywords["async"] = TokenType::Async;
+    keywords["await"] = TokenType::Await;
 
     keywords_registered = true;
 }
@@ -120,6 +123,8 @@ std::vector<Token> Lexer::tokenize(const std::string& src) {
                 ++pos;
                 ++col;
                 tokens.emplace_back(TokenType::DoubleColon, "::", lineno, start_col);
+            } else {
+                tokens.emplace_back(TokenType::Colon, ":", lineno, start_col);
             }
         } else if (src[pos] == '=') {
             tokens.emplace_back(TokenType::Assign, "=", lineno, start_col);
@@ -1,6 +1,7 @@
 #include "parser.hpp"
 
 #include <algorithm>
+#include <cassert>
 #include <memory>
 #include <vector>
 
@@ -14,6 +15,20 @@ std::unique_ptr<Expression> Parser::parse_expression() {
     return parse_and_or(); // 直接调用合并后的函数
 }
 
+// 语句级表达式（return / 赋值右侧）：a, b, c 不加括号即为元组
+std::unique_ptr<Expression> Parser::parse_expr_or_tuple() {
+    auto expr = parse_expression();
+    if (expr == nullptr or curr_token().type != TokenType::Comma) return expr;
+
+    std::vector<std::unique_ptr<Expression>> elems;
+    elems.emplace_back(std::move(expr));
+    while (curr_token().type == TokenType::Comma) {
+        skip_token(",");
+        elems.emplace_back(parse_expression());
+    }
+    return std::make_unique<TupleExpr>(std::move(elems));
+}
+
 // 处理 and/or（优先级相同，左结合）
 std::unique_ptr<Expression> Parser::parse_and_or() {
     DEBUG_OUTPUT("parsing and/or expression...");
@@ -133,6 +148,11 @@ std::unique_ptr<Expression> Parser::parse_unary() {
         auto operand = parse_unary();
         return std::make_unique<UnaryExpr>("-", std::move(operand));
     }
+    if (curr_token().type == TokenType::Await) {
+        skip_token("await");
+        auto operand = parse_unary();
+        return std::make_unique<AwaitExpr>(std::move(operand));
+    }
     return parse_factor();
 }
 
@@ -149,7 +169,32 @@ std::unique_ptr<Expression> Parser::parse_factor() {
         }
         else if (curr_token().type == TokenType::LBracket) {
             skip_token("[");
-            auto param = parse_params(TokenType::RBracket);
+            std::vector<std::unique_ptr<Expression>> param;
+            std::unique_ptr<Expression> first = nullptr;
+            if (curr_token().type != TokenType::Colon) {
+                first = parse_expression();
+            }
+            // 切片：x[a:b] / x[:b] / x[a:] / x[:]
+            if (curr_token().type == TokenType::Colon) {
+                skip_token(":");
+                std::unique_ptr<Expression> second = nullptr;
+                if (curr_token().type != TokenType::RBracket) {
+                    second = parse_expression();
+                }
+                skip_token("]");
+                param.emplace_back(std::move(first));
+                param.emplace_back(std::move(second));
+                auto slice = std::make_unique<GetItemExpr>(std::move(node),std::move(param));
+                slice->is_slice = true;
+                node = std::move(slice);
+                continue;
+            }
+            param.emplace_back(std::move(first));
+            if (curr_token().type == TokenType::Comma) {
+                skip_token(",");
+                auto rest = parse_params(TokenType::RBracket);
+                for (auto& p : rest) param.emplace_back(std::move(p));
+            }
             skip_token("]");
             node = std::make_unique<GetItemExpr>(std::move(node),std::move(param));
         }
@@ -185,6 +230,14 @@ std::unique_ptr<Expression> Parser::parse_primary() {
     if (tok.type == TokenType::Identifier) {
         return std::make_unique<IdentifierExpr>(tok.text);
     }
+    // 异步匿名函数：async fn |x| { ... }
+    if (tok.type == TokenType::Async) {
+        auto lambda = parse_primary();
+        auto* fn_decl = dynamic_cast<FnDeclExpr*>(lambda.get());
+        assert(fn_decl != nullptr && "async 后必须是函数定义");
+        fn_decl->is_async = true;
+        return lambda;
+    }
     if (tok.type == TokenType::Func) {
         std::vector<std::string> params{};
         if (curr_token().type == TokenType::Pipe) {
@@ -221,6 +274,11 @@ std::unique_ptr<Expression> Parser::parse_primary() {
     if (tok.type == TokenType::LBrace) {
         std::vector<std::pair<std::string, std::unique_ptr<Expression>>> init_vec{};
         while (curr_token().type != TokenType::RBrace) {
+            // 词法分析在 } 前补的分号：空字典 {} 即为 { ; }
+            if (curr_token().type == TokenType::Semicolon) {
+                skip_token(";");
+                continue;
+            }
             auto key = skip_token().text;
             skip_token("=");
             auto val = parse_expression();
@@ -237,7 +295,23 @@ std::unique_ptr<Expression> Parser::parse_primary() {
         return std::make_unique<ListExpr>(std::move(param));
     }
     if (tok.type == TokenType::LParen) {
+        // () 为空元组；(a,) / (a, b) 为元组；(a) 仅为括号
+        if (curr_token().type == TokenType::RParen) {
+            skip_token(")");
+            return std::make_unique<TupleExpr>(std::vector<std::unique_ptr<Expression>>{});
+        }
         auto expr = parse_expression();
+        if (curr_token().type == TokenType::Comma) {
+            std::vector<std::unique_ptr<Expression>> elems;
+            elems.emplace_back(std::move(expr));
+            while (curr_token().type == TokenType::Comma) {
+                skip_token(",");
+                if (curr_token().type == TokenType::RParen) break;
+                elems.emplace_back(parse_expression());
+            }
+            skip_token(")");
+            return std::make_unique<TupleExpr>(std::move(elems));
+        }
         skip_token(")");
         return expr;
     }
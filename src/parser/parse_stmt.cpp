@@ -108,6 +108,23 @@ std::unique_ptr<Statement> Parser::parse_stmt() {
         return std::make_unique<WhileStmt>(std::move(cond_expr), std::move(while_block));
     }
 
+    // 解析异步函数定义（async fn x() end）：与普通函数相同，只是标记为 async
+    if (curr_tok.type == TokenType::Async) {
+        DEBUG_OUTPUT("parsing async function");
+        skip_token("async");
+        if (curr_token().type != TokenType::Func) {
+            std::cerr << Color::RED
+                      << "[Syntax Error] Expected 'fn' after 'async', got '"
+                      << curr_token().text << "' (Line: " << curr_token().lineno << ")"
+                      << Color::RESET << std::endl;
+            assert(false && "Invalid async function");
+        }
+        auto stmt = parse_stmt();
+        const auto* assign = dynamic_cast<AssignStmt*>(stmt.get());
+        dynamic_cast<FnDeclExpr*>(assign->expr.get())->is_async = true;
+        return stmt;
+    }
+
     // 解析函数定义（新语法：fn x() end）
     if (curr_tok.type == TokenType::Func) {
         DEBUG_OUTPUT("parsing function");
@@ -163,13 +180,50 @@ std::unique_ptr<Statement> Parser::parse_stmt() {
         ));
     }
 
+    // 解析结构体定义（struct Point x, y end，字段可用逗号或换行分隔）
+    if (curr_tok.type == TokenType::Struct) {
+        DEBUG_OUTPUT("parsing struct");
+        skip_token("struct");
+        const std::string struct_name = skip_token().text;
+
+        std::vector<std::string> fields;
+        while (curr_token().type != TokenType::End) {
+            if (curr_token().type == TokenType::EndOfLine or curr_token().type == TokenType::Comma
+                or curr_token().type == TokenType::Semicolon) {
+                skip_token();
+                continue;
+            }
+            const Token field_tok = skip_token();
+            if (field_tok.type != TokenType::Identifier) {
+                std::cerr << Color::RED
+                          << "[Syntax Error] Struct field must be an identifier, got '"
+                          << field_tok.text << "' (Line: " << field_tok.lineno << ")"
+                          << Color::RESET << std::endl;
+                assert(false && "Invalid struct field");
+            }
+            if (std::find(fields.begin(), fields.end(), field_tok.text) != fields.end()) {
+                std::cerr << Color::RED
+                          << "[Syntax Error] Duplicate struct field '" << field_tok.text
+                          << "' (Line: " << field_tok.lineno << ")"
+                          << Color::RESET << std::endl;
+                assert(false && "Duplicate struct field");
+            }
+            fields.push_back(field_tok.text);
+        }
+        skip_token("end");
+
+        return std::make_unique<AssignStmt>(struct_name, std::make_unique<StructDeclExpr>(
+            struct_name,
+            std::move(fields)
+        ));
+    }
 
     // 解析return语句
     if (curr_tok.type == TokenType::Return) {
         DEBUG_OUTPUT("parsing return");
         skip_token("return");
-        // return后可跟表达式（也可无，视为返回nil）
-        std::unique_ptr<Expression> return_expr = parse_expression();
+        // return后可跟表达式（也可无，视为返回nil）；return a, b 返回多个值
+        std::unique_ptr<Expression> return_expr = parse_expr_or_tuple();
         skip_end_of_ln();
         return std::make_unique<ReturnStmt>(std::move(return_expr));
     }
@@ -230,11 +284,38 @@ std::unique_ptr<Statement> Parser::parse_stmt() {
         DEBUG_OUTPUT("parsing assign");
         const auto name = skip_token().text;
         skip_token("=");
-        auto expr = parse_expression();
+        auto expr = parse_expr_or_tuple();
         skip_end_of_ln();
         return std::make_unique<AssignStmt>(name, std::move(expr));
     }
 
+    // 解析解包赋值语句（a, b = expr;）
+    if (curr_tok.type == TokenType::Identifier
+        and curr_tok_idx_ + 1 < tokens_.size()
+        and tokens_[curr_tok_idx_ + 1].type == TokenType::Comma
+    ) {
+        // 向前扫描确认形如 name (, name)* =
+        size_t scan = curr_tok_idx_ + 1;
+        while (scan + 1 < tokens_.size()
+            and tokens_[scan].type == TokenType::Comma
+            and tokens_[scan + 1].type == TokenType::Identifier) {
+            scan += 2;
+        }
+        if (scan < tokens_.size() and tokens_[scan].type == TokenType::Assign) {
+            DEBUG_OUTPUT("parsing unpack assign");
+            std::vector<std::string> names;
+            names.emplace_back(skip_token().text);
+            while (curr_token().type == TokenType::Comma) {
+                skip_token(",");
+                names.emplace_back(skip_token().text);
+            }
+            skip_token("=");
+            auto expr = parse_expr_or_tuple();
+            skip_end_of_ln();
+            return std::make_unique<UnpackAssignStmt>(std::move(names), std::move(expr));
+        }
+    }
+
 
     // 解析表达式语句
     auto expr = parse_expression();
@@ -248,8 +329,19 @@ std::unique_ptr<Statement> Parser::parse_stmt() {
             auto set_mem = std::make_unique<SetMemberExpr>(std::move(expr), std::move(value));
             return std::make_unique<ExprStmt>(std::move(set_mem));
         }
-        //非成员访问表达式后不能跟 =
-        assert("invalid assignment target: expected member access");
+        if (dynamic_cast<GetItemExpr*>(expr.get())) {
+            DEBUG_OUTPUT("parsing set item");
+            assert(!static_cast<GetItemExpr*>(expr.get())->is_slice
+                && "invalid assignment target: slice assignment is not supported");
+            skip_token("=");
+            auto value = parse_expression();
+            skip_end_of_ln();
+
+            auto set_item = std::make_unique<SetItemExpr>(std::move(expr), std::move(value));
+            return std::make_unique<ExprStmt>(std::move(set_item));
+        }
+        //非成员/下标访问表达式后不能跟 =
+        assert("invalid assignment target: expected member or item access");
     }
     if (expr != nullptr) {
         skip_end_of_ln();
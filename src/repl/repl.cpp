@@ -57,6 +57,7 @@ void Repl::eval_and_print(const std::string& cmd) {
     }
 
     DEBUG_OUTPUT("repl print");
+    builtin_objects::stdout_buffer().flush();
     auto [stack_top, locals] = vm_.get_vm_state();
     if (stack_top != nullptr) {
         if (not dynamic_cast<model::Nil*>(stack_top) and should_print) {
@@ -0,0 +1,138 @@
+
+#include <algorithm>
+#include <cassert>
+
+#include "vm.hpp"
+#include "../../deps/event_loop.hpp"
+
+namespace kiz {
+
+// -------------------------- 协程调度 --------------------------
+// 协程运行在调用 run 的那一层调用栈之上：resume 把协程的调用帧压回调用栈，
+// 像 Vm::invoke 一样嵌套执行，直到该帧返回（协程完成）或在 AWAIT 处挂起（帧被移回协程）
+
+// 启动尚未运行的协程：放入就绪队列。其他 Future 由各自的事件源（定时器、I/O、gather）完成
+void Vm::start(model::Future* future) {
+    auto* coro = dynamic_cast<Coroutine*>(future);
+    if (coro == nullptr || coro->state != Coroutine::State::Created) return;
+    coro->state = Coroutine::State::Ready;
+    coro->make_ref();
+    ready_.push_back(coro);
+}
+
+void Vm::resume(Coroutine* coro) {
+    assert(coro->state == Coroutine::State::Ready && "resume: 协程不在就绪状态");
+    assert(!call_stack_.empty() && "resume: 无活跃调用帧");
+    coro->state = Coroutine::State::Running;
+
+    const size_t base_depth = call_stack_.size();
+    CallFrame* caller_frame = call_stack_.back().get();
+    const size_t caller_pc = caller_frame->pc;
+
+    // 放回挂起时的操作数栈片段，再压入所等待对象的结果（即 await 表达式的值）
+    coro->stack_base = op_stack_.size();
+    for (model::Object* obj : coro->saved_stack) op_stack_.push(obj);
+    coro->saved_stack.clear();
+    if (coro->awaiting != nullptr) {
+        model::Object* value = coro->awaiting->result;
+        value->make_ref();
+        op_stack_.push(value);
+        coro->awaiting->del_ref();
+        coro->awaiting = nullptr;
+    }
+    call_stack_.emplace_back(std::move(coro->frame));
+    constant_pool_ = call_stack_.back()->code_object->consts;
+    running_coroutines_.push_back(coro);
+
+    // AWAIT 挂起时已把调用帧移回协程并推进了 pc
+    run_until_depth(base_depth, [coro] { return coro->state == Coroutine::State::Suspended; });
+    running_coroutines_.pop_back();
+    // RET 会把调用方 pc 设为 return_to_pc；调用方仍停在原指令上。挂起时没有经过 RET，常量池也要换回来
+    caller_frame->pc = caller_pc;
+    constant_pool_ = caller_frame->code_object->consts;
+
+    if (coro->state == Coroutine::State::Suspended) return;
+
+    // 协程函数已返回：返回值在栈顶
+    model::Object* result = op_stack_.top();
+    op_stack_.pop();
+    coro->resolve(result);
+    result->del_ref();
+}
+
+// 运行事件循环直到 future 完成，返回其结果（已持有一个引用）
+model::Object* Vm::run_until_complete(model::Future* future) {
+    future->make_ref();
+    start(future);
+    auto& loop = deps::EventLoop::instance();
+    while (!future->done) {
+        // 每轮先运行本轮开始时已就绪的协程，再检查一次 I/O 与定时器，忙碌的协程不会饿死 I/O
+        for (size_t n = ready_.size(); n > 0 && !ready_.empty(); --n) {
+            Coroutine* coro = ready_.front();
+            ready_.pop_front();
+            resume(coro);
+            coro->del_ref();
+        }
+        if (future->done) break;
+        if (ready_.empty() && !loop.pending()) {
+            assert(false && "run: 没有可运行的协程，也没有等待中的 I/O 或定时器（协程永远不会完成）");
+        }
+        // 没有就绪协程时阻塞到下一个 I/O 事件或定时器
+        loop.run_once(ready_.empty());
+    }
+    model::Object* result = future->result;
+    result->make_ref();
+    future->del_ref();
+    return result;
+}
+
+void Vm::exec_AWAIT(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec await...");
+    if (running_coroutines_.empty()) {
+        assert(false && "AWAIT: 只能在协程中执行");
+    }
+
+    model::Object* awaited = op_stack_.top();
+    op_stack_.pop();
+    auto* future = dynamic_cast<model::Future*>(awaited);
+    if (future == nullptr) {
+        awaited->del_ref();
+        assert(false && "AWAIT: 只能等待协程或 Future");
+    }
+
+    // 尚未启动的协程直接在当前位置运行：await f() 中 f 途中不挂起时无需经过调度器
+    if (auto* child = dynamic_cast<Coroutine*>(future); child != nullptr && child->state == Coroutine::State::Created) {
+        child->state = Coroutine::State::Ready;
+        resume(child);
+    }
+
+    if (future->done) {
+        model::Object* value = future->result;
+        value->make_ref();
+        op_stack_.push(value);
+        awaited->del_ref();
+        return;
+    }
+
+    // 挂起当前协程：调用帧与栈片段移回协程，恢复后从下一条指令继续
+    Coroutine* self = running_coroutines_.back();
+    call_stack_.back()->pc++;
+    self->frame = std::move(call_stack_.back());
+    call_stack_.pop_back();
+    constant_pool_ = call_stack_.back()->code_object->consts;
+    while (op_stack_.size() > self->stack_base) {
+        self->saved_stack.push_back(op_stack_.top());
+        op_stack_.pop();
+    }
+    std::reverse(self->saved_stack.begin(), self->saved_stack.end());
+
+    self->awaiting = future;  // 栈上的引用转给协程
+    self->state = Coroutine::State::Suspended;
+    self->make_ref();  // 由就绪队列持有
+    future->add_done_callback([self] {
+        self->state = Coroutine::State::Ready;
+        ready_.push_back(self);
+    });
+}
+
+}
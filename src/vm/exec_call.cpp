@@ -62,8 +62,6 @@ void Vm::call_function(model::Object* func_obj, model::Object* args_obj, model::
                             "个，实际" + std::to_string(actual_argc) + "个）").c_str());
         }
 
-        constant_pool_ = func->code->consts;
-
         // 创建新调用帧
         auto new_frame = std::make_unique<CallFrame>();
         new_frame->name = func->name;
@@ -96,12 +94,50 @@ void Vm::call_function(model::Object* func_obj, model::Object* args_obj, model::
             new_frame->locals.insert(param_name, param_val);
         }
 
-        // 压入新调用帧，更新程序计数器
+        // async fn：不执行函数体，调用帧交给协程，协程作为调用结果压栈（由 await / gather / run 启动）
+        if (func->is_async) {
+            new_frame->boxed_return = true;  // 协程的返回值由调度器取走
+            auto* coro = new Coroutine(std::move(new_frame));
+            coro->make_ref();
+            op_stack_.push(coro);
+            func_obj->del_ref();
+            args_obj->del_ref();
+            return;
+        }
+
+        // 压入新调用帧，更新程序计数器；async fn 不进入函数体，所以常量池在这里才切换
+        constant_pool_ = func->code->consts;
         call_stack_.emplace_back(std::move(new_frame));
 
         // 释放临时引用
         func_obj->del_ref();
         args_obj->del_ref();
+    } else if (auto* struct_type = dynamic_cast<model::StructType*>(func_obj)) {
+        // -------------------------- 构造结构体实例 --------------------------
+        // 按位置填充字段，实参少于字段数时其余字段为 Nil
+        const size_t field_count = struct_type->fields.size();
+        if (args_list->val.size() > field_count) {
+            func_obj->del_ref();
+            args_obj->del_ref();
+            assert(false && "CALL: 结构体构造参数多于字段数");
+        }
+        auto* instance = new model::Struct(struct_type);
+        for (size_t i = 0; i < field_count; ++i) {
+            model::Object* field_val = i < args_list->val.size() ? args_list->val[i] : new model::Nil();
+            field_val->make_ref();
+            instance->slots[i] = field_val;
+        }
+        instance->make_ref();
+        op_stack_.push(instance);
+
+        func_obj->del_ref();
+        args_obj->del_ref();
+    } else if (const auto call_it = func_obj->attrs.find_in_current("__call__")) {
+        // 可调用对象（如 list 类型对象）：转发到自身的 __call__，self 为该对象
+        model::Object* target = call_it->value;
+        target->make_ref();
+        call_function(target, args_obj, func_obj);
+        func_obj->del_ref();
     } else {
         // 释放临时引用（类型错误时）
         func_obj->del_ref();
@@ -110,6 +146,51 @@ void Vm::call_function(model::Object* func_obj, model::Object* args_obj, model::
     }
 }
 
+// 执行栈顶调用帧，直到调用栈降回 base_depth 层（其上的帧全部返回）、VM 停止，或 should_pause 为真。
+// 函数帧执行到末尾按无返回值的 RET 处理；模块帧执行到末尾即停止，保留给 REPL 继续追加代码
+void Vm::run_until_depth(const size_t base_depth, const std::function<bool()>& should_pause) {
+    while (call_stack_.size() > base_depth && running_) {
+        auto& curr_frame = *call_stack_.back();
+        if (curr_frame.pc >= curr_frame.code_object->code.size()) {
+            if (call_stack_.size() == 1) break;
+            exec(Instruction{Opcode::RET, {}, 0, 0});
+            continue;
+        }
+        const Instruction& curr_inst = curr_frame.code_object->code[curr_frame.pc];
+        exec(curr_inst);
+        DEBUG_OUTPUT("curr inst is "+opcode_to_string(curr_inst.opc));
+        // 暂停（协程在 AWAIT 处挂起）时当前帧已被移走，pc 由挂起方负责
+        if (should_pause && should_pause()) break;
+        if (!(curr_inst.opc == Opcode::JUMP || curr_inst.opc == Opcode::JUMP_IF_FALSE
+              || curr_inst.opc == Opcode::RET || curr_inst.opc == Opcode::RET_MULTI)) {
+            curr_frame.pc++;
+        }
+    }
+}
+
+// 在 C++ 中同步调用函数（供 map / filter / reduce 等原生函数回调 kiz 函数）
+// 返回值已持有一个引用，由调用方释放
+model::Object* Vm::invoke(model::Object* func_obj, model::List* args, model::Object* self) {
+    assert(!call_stack_.empty() && "Vm::invoke: 无活跃调用帧");
+    const size_t base_depth = call_stack_.size();
+    CallFrame* caller_frame = call_stack_.back().get();
+    const size_t caller_pc = caller_frame->pc;
+
+    func_obj->make_ref();
+    args->make_ref();
+    call_function(func_obj, args, self);
+    if (call_stack_.size() > base_depth) call_stack_.back()->boxed_return = true;
+
+    // Function 会压入新调用帧：嵌套执行直到该帧 RET 返回
+    run_until_depth(base_depth);
+    // RET 会把调用方 pc 设为 return_to_pc；调用方仍停在当前 CALL 上，由外层循环推进
+    caller_frame->pc = caller_pc;
+
+    model::Object* result = op_stack_.top();
+    op_stack_.pop();
+    return result;
+}
+
 // -------------------------- 函数调用/返回 --------------------------
 void Vm::exec_CALL(const Instruction& instruction) {
     DEBUG_OUTPUT("exec call...");
@@ -153,7 +234,11 @@ void Vm::exec_CALL_METHOD(const Instruction& instruction) {
     DEBUG_OUTPUT("弹出对象: " + obj->to_string());
     DEBUG_OUTPUT("弹出参数列表: " + args_obj->to_string());
 
-    auto func_obj = get_attr(obj, instruction[0]);
+    if (instruction.opn_list.empty()) {
+        assert(false && "CALL_METHOD: 无方法名索引");
+    }
+    const std::string method_name = call_stack_.back()->names[instruction.opn_list[0]];
+    auto func_obj = get_attr(obj, method_name);
     func_obj->make_ref();
 
     DEBUG_OUTPUT("获取函数对象: " + func_obj->to_string());
@@ -192,4 +277,34 @@ void Vm::exec_RET(const Instruction& instruction) {
     caller_frame->pc = curr_frame->return_to_pc;
     op_stack_.push(return_val);
 }
+
+// return a, b, ...：值已按顺序在栈顶。若调用方下一条指令正是同元数的 UNPACK_SEQ，
+// 直接把这些值留在栈上并跳过该指令（不创建 Tuple）；否则打包为 Tuple 后按 RET 返回
+void Vm::exec_RET_MULTI(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec ret_multi...");
+
+    if (instruction.opn_list.empty()) {
+        assert(false && "RET_MULTI: 无返回值个数参数");
+    }
+    const size_t value_count = instruction.opn_list[0];
+
+    // Vm::invoke 发起的调用由 C++ 取走单个返回值，必须打包
+    if (call_stack_.size() >= 2 && !call_stack_.back()->boxed_return) {
+        CallFrame* caller_frame = call_stack_[call_stack_.size() - 2].get();
+        const size_t return_to_pc = call_stack_.back()->return_to_pc;
+        const auto& caller_code = caller_frame->code_object->code;
+
+        if (return_to_pc < caller_code.size()
+            && caller_code[return_to_pc].opc == Opcode::UNPACK_SEQ
+            && caller_code[return_to_pc].opn_list[0] == value_count) {
+            call_stack_.pop_back();
+            constant_pool_ = caller_frame->code_object->consts;
+            caller_frame->pc = return_to_pc + 1;
+            return;
+        }
+    }
+
+    exec_MAKE_TUPLE(Instruction{Opcode::MAKE_TUPLE, {value_count}, 0, 0});
+    exec_RET(instruction);
+}
 }
@@ -1,11 +1,19 @@
 #include <cassert>
 
 #include "vm.hpp"
+#include "../../libs/builtins/builtin_methods/dict_obj.hpp"
 
 namespace kiz {
 
 model::Object* Vm::get_attr(const model::Object* obj, const std::string& attr_name) {
     if (obj == nullptr) assert(false && ("GET_ATTR: 对象无此属性: "+attr_name).c_str());
+    // 结构体实例：先查字段，其余属性（方法等）沿类型对象查找
+    if (obj->get_type() == model::Object::ObjectType::OT_Struct) {
+        const auto* struct_obj = static_cast<const model::Struct*>(obj);
+        const size_t slot = struct_obj->type->slot_of(attr_name);
+        if (slot != model::StructType::npos) return struct_obj->slots[slot];
+        return get_attr(struct_obj->type, attr_name);
+    }
     const auto attr_it = obj->attrs.find(attr_name);
     auto parent_it = obj->attrs.find("__parent__");
     if (attr_it != nullptr) return attr_it->value;
@@ -188,6 +196,17 @@ void Vm::exec_SET_ATTR(const Instruction& instruction) {
     }
     std::string attr_name = curr_frame->names[name_idx];
 
+    // 结构体实例的字段固定：只能写已声明的字段
+    if (obj->get_type() == model::Object::ObjectType::OT_Struct) {
+        auto* struct_obj = static_cast<model::Struct*>(obj);
+        const size_t slot = struct_obj->type->slot_of(attr_name);
+        assert(slot != model::StructType::npos && "SET_ATTR: 结构体没有该字段（字段在声明时固定）");
+        attr_val->make_ref();
+        if (struct_obj->slots[slot] != nullptr) struct_obj->slots[slot]->del_ref();
+        struct_obj->slots[slot] = attr_val;
+        return;
+    }
+
     auto attr_it = obj->attrs.find(attr_name);
     if (attr_it != nullptr) {
         attr_it->value->del_ref();
@@ -196,4 +215,212 @@ void Vm::exec_SET_ATTR(const Instruction& instruction) {
     obj->attrs.insert(attr_name, attr_val);
 }
 
+// -------------------------- 结构体字段 --------------------------
+// GET_SLOT slot name_idx：编译期按字段名算出的下标。对象确是结构体且该下标正是同名字段时直接读 slot，
+// 否则（变量其实是字典、模块或另一种结构体）退回按名查找的 GET_ATTR
+void Vm::exec_GET_SLOT(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec get_slot...");
+    if (op_stack_.empty() || instruction.opn_list.size() < 2) {
+        assert(false && "GET_SLOT: 操作数栈为空或缺少 slot / 属性名索引");
+    }
+    model::Object* obj = op_stack_.top();
+    const size_t slot = instruction.opn_list[0];
+    const std::string& field = call_stack_.back()->names[instruction.opn_list[1]];
+
+    if (obj->get_type() == model::Object::ObjectType::OT_Struct) {
+        auto* struct_obj = static_cast<model::Struct*>(obj);
+        if (struct_obj->has_field_at(slot, field)) {
+            op_stack_.pop();
+            model::Object* field_val = struct_obj->slots[slot];
+            field_val->make_ref();
+            op_stack_.push(field_val);
+            return;
+        }
+    }
+    exec_GET_ATTR(Instruction{Opcode::GET_ATTR, {instruction.opn_list[1]},
+        instruction.start_lineno, instruction.end_lineno});
+}
+
+// SET_SLOT slot name_idx：栈为 [对象, 值]，守卫与回退同 GET_SLOT
+void Vm::exec_SET_SLOT(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec set_slot...");
+    if (op_stack_.size() < 2 || instruction.opn_list.size() < 2) {
+        assert(false && "SET_SLOT: 操作数栈元素不足或缺少 slot / 属性名索引");
+    }
+    model::Object* field_val = op_stack_.top();
+    op_stack_.pop();
+    model::Object* obj = op_stack_.top();
+    const size_t slot = instruction.opn_list[0];
+    const std::string& field = call_stack_.back()->names[instruction.opn_list[1]];
+
+    if (obj->get_type() == model::Object::ObjectType::OT_Struct) {
+        auto* struct_obj = static_cast<model::Struct*>(obj);
+        if (struct_obj->has_field_at(slot, field)) {
+            op_stack_.pop();
+            field_val->make_ref();
+            if (struct_obj->slots[slot] != nullptr) struct_obj->slots[slot]->del_ref();
+            struct_obj->slots[slot] = field_val;
+            return;
+        }
+    }
+    op_stack_.push(field_val);
+    exec_SET_ATTR(Instruction{Opcode::SET_ATTR, {instruction.opn_list[1]},
+        instruction.start_lineno, instruction.end_lineno});
+}
+
+// -------------------------- 下标访问 --------------------------
+void Vm::exec_GET_ITEM(const Instruction& instruction) {
+    const auto raw_call_stack_count = call_stack_.size();
+
+    DEBUG_OUTPUT("exec get_item...");
+    auto [obj, key] = fetch_two_from_stack_top("get_item");
+
+    // 快速路径：List[Int] / String[Int] / Dictionary[任意可哈希键] 直接访问底层容器，不经过 __getitem__
+    model::Object* item = nullptr;
+    if (const auto* key_int = dynamic_cast<model::Int*>(key)) {
+        if (const auto* list_obj = dynamic_cast<model::List*>(obj)) {
+            item = list_obj->at(model::normalize_index(key_int->val, list_obj->size()));
+        } else if (const auto* str_obj = dynamic_cast<model::String*>(obj)) {
+            // 按码点下标：纯 ASCII 为 O(1)，否则借助稀疏偏移索引
+            const size_t idx = model::normalize_index(key_int->val, str_obj->cp_len());
+            item = str_obj->is_byte_mode()
+                ? model::intern_string(std::string(1, str_obj->val[idx]))
+                : model::intern_string(str_obj->cp_substr(idx, idx + 1));
+        }
+    } else if (const auto* key_str = dynamic_cast<model::String*>(key);
+               key_str != nullptr && !model::Dictionary::is_reserved_key(key_str->val)) {
+        if (const auto* dict_obj = dynamic_cast<model::Dictionary*>(obj)) {
+            const auto node = dict_obj->attrs.find_in_current(key_str->val, key_str->hash());
+            if (node == nullptr) {
+                assert(false && "GET_ITEM: 字典中无此键");
+            }
+            item = node->value;
+        }
+    }
+    if (item == nullptr) {
+        // Dictionary[非 String 键 / 保留键]：直接查 items
+        if (const auto* dict_obj = dynamic_cast<model::Dictionary*>(obj);
+            dict_obj != nullptr && model::is_hashable(key)) {
+            model::Object** slot = dict_obj->items.find(key);
+            if (slot == nullptr) {
+                assert(false && "GET_ITEM: 字典中无此键");
+            }
+            item = *slot;
+        }
+    }
+
+    if (item != nullptr) {
+        item->make_ref();
+        op_stack_.push(item);
+        obj->del_ref();
+        key->del_ref();
+        return;
+    }
+
+    // 慢速路径：调用 __getitem__ 魔术方法
+    call_function(get_attr(obj, "__getitem__"), new model::List({key}), obj);
+
+    if (raw_call_stack_count != call_stack_.size()) {
+        exec_RET({});
+    }
+}
+
+void Vm::exec_GET_SLICE(const Instruction& instruction) {
+    const auto raw_call_stack_count = call_stack_.size();
+
+    DEBUG_OUTPUT("exec get_slice...");
+    if (op_stack_.size() < 3) {
+        assert(false && "GET_SLICE: 操作数栈元素不足（需≥3：对象 + 起始 + 结束）");
+    }
+    auto [start, stop] = fetch_two_from_stack_top("get_slice");
+    model::Object* obj = op_stack_.top();
+    op_stack_.pop();
+
+    // 快速路径：List / String / Bytes 按规范化后的区间一次性构造结果
+    model::Object* result = nullptr;
+    if (const auto* list_obj = dynamic_cast<model::List*>(obj)) {
+        const auto [begin, end] = model::normalize_slice(start, stop, list_obj->size());
+        result = list_obj->slice(begin, end);
+    } else if (const auto* str_obj = dynamic_cast<model::String*>(obj)) {
+        const auto [begin, end] = model::normalize_slice(start, stop, str_obj->cp_len());
+        result = new model::String(str_obj->cp_substr(begin, end));
+    } else if (const auto* bytes_obj = dynamic_cast<model::Bytes*>(obj)) {
+        // 字节切片是共享缓冲的视图，不复制
+        const auto [begin, end] = model::normalize_slice(start, stop, bytes_obj->size());
+        result = bytes_obj->slice(begin, end);
+    }
+
+    if (result != nullptr) {
+        result->make_ref();
+        op_stack_.push(result);
+        obj->del_ref();
+        start->del_ref();
+        stop->del_ref();
+        return;
+    }
+
+    // 慢速路径：以 (start, stop) 两个参数调用 __getitem__
+    call_function(get_attr(obj, "__getitem__"), new model::List({start, stop}), obj);
+
+    if (raw_call_stack_count != call_stack_.size()) {
+        exec_RET({});
+    }
+}
+
+void Vm::exec_SET_ITEM(const Instruction& instruction) {
+    const auto raw_call_stack_count = call_stack_.size();
+
+    DEBUG_OUTPUT("exec set_item...");
+    if (op_stack_.size() < 3) {
+        assert(false && "SET_ITEM: 操作数栈元素不足（需≥3：对象 + 键 + 值）");
+    }
+    auto [key, item_val] = fetch_two_from_stack_top("set_item");
+    model::Object* obj = op_stack_.top();
+    op_stack_.pop();
+
+    // 快速路径：List[Int] = x / Dictionary[任意可哈希键] = x 原地替换
+    if (const auto* key_int = dynamic_cast<model::Int*>(key)) {
+        if (auto* list_obj = dynamic_cast<model::List*>(obj)) {
+            std::vector<model::Object*>& items = list_obj->flat();
+            model::Object*& slot = items[model::normalize_index(key_int->val, items.size())];
+            if (slot != nullptr) {
+                slot->del_ref();
+            }
+            slot = item_val;
+            obj->del_ref();
+            key->del_ref();
+            return;
+        }
+    } else if (const auto* key_str = dynamic_cast<model::String*>(key);
+               key_str != nullptr && !model::Dictionary::is_reserved_key(key_str->val)) {
+        if (auto* dict_obj = dynamic_cast<model::Dictionary*>(obj)) {
+            auto node = dict_obj->attrs.find_in_current(key_str->val, key_str->hash());
+            if (node != nullptr && node->value != nullptr) {
+                node->value->del_ref();
+            }
+            dict_obj->attrs.insert(key_str->val, item_val, key_str->hash());
+            obj->del_ref();
+            key->del_ref();
+            return;
+        }
+    }
+    // Dictionary[非 String 键 / 保留键] = x：写入 items（dict_store_item 自行持有键和值）
+    if (auto* dict_obj = dynamic_cast<model::Dictionary*>(obj);
+        dict_obj != nullptr && model::is_hashable(key)) {
+        model::dict_store_item(dict_obj, key, item_val);
+        item_val->del_ref();
+        obj->del_ref();
+        key->del_ref();
+        return;
+    }
+
+    // 慢速路径：调用 __setitem__ 魔术方法，并丢弃其返回值
+    call_function(get_attr(obj, "__setitem__"), new model::List({key, item_val}), obj);
+
+    if (raw_call_stack_count != call_stack_.size()) {
+        exec_RET({});
+    }
+    exec_POP_TOP({});
+}
+
 }
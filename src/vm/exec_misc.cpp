@@ -1,5 +1,6 @@
 
 #include "vm.hpp"
+#include "../../libs/builtins/builtin_methods/dict_obj.hpp"
 
 namespace kiz {
 
@@ -47,6 +48,140 @@ void Vm::exec_MAKE_LIST(const Instruction& instruction) {
     DEBUG_OUTPUT("make_list: 打包 " + std::to_string(elem_count) + " 个元素为 List，压栈成功");
 }
 
+// -------------------------- 制作元组 --------------------------
+void Vm::exec_MAKE_TUPLE(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec make_tuple...");
+
+    if (instruction.opn_list.empty()) {
+        assert(false && "MAKE_TUPLE: 无元素个数参数");
+    }
+    const size_t elem_count = instruction.opn_list[0];
+    if (op_stack_.size() < elem_count) {
+        assert(false && "MAKE_TUPLE: 栈元素不足");
+    }
+
+    // 从后往前填充，省去反转；栈上的引用直接转交给 Tuple
+    std::vector<model::Object*> elem_list(elem_count);
+    for (size_t i = elem_count; i > 0; --i) {
+        elem_list[i - 1] = op_stack_.top();
+        op_stack_.pop();
+        assert(elem_list[i - 1] != nullptr && "MAKE_TUPLE: 元素为nil（非法）");
+    }
+
+    auto* tuple_obj = new model::Tuple(elem_list);
+    tuple_obj->make_ref();
+    op_stack_.push(tuple_obj);
+}
+
+// -------------------------- 制作字典 --------------------------
+// 操作数为各键在 names 中的下标，值按相同顺序在栈上；每次求值都新建字典
+void Vm::exec_MAKE_DICT(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec make_dict...");
+
+    const size_t pair_count = instruction.opn_list.size();
+    if (op_stack_.size() < pair_count) {
+        assert(false && "MAKE_DICT: 栈元素不足");
+    }
+
+    std::vector<model::Object*> values(pair_count);
+    for (size_t i = pair_count; i > 0; --i) {
+        values[i - 1] = op_stack_.top();
+        op_stack_.pop();
+        assert(values[i - 1] != nullptr && "MAKE_DICT: 值为nil（非法）");
+    }
+
+    auto* dict_obj = new model::Dictionary();
+    const auto& names = call_stack_.back()->names;
+    for (size_t i = 0; i < pair_count; ++i) {
+        const std::string& key = names[instruction.opn_list[i]];
+        if (model::Dictionary::is_reserved_key(key)) {
+            auto* key_obj = new model::String(key);
+            key_obj->make_ref();
+            model::dict_store_item(dict_obj, key_obj, values[i]);
+            key_obj->del_ref();
+            values[i]->del_ref();
+            continue;
+        }
+        // 栈上的引用直接转交给字典；重复键保留最后一个值
+        if (const auto node = dict_obj->attrs.find_in_current(key)) node->value->del_ref();
+        dict_obj->attrs.insert(key, values[i]);
+    }
+
+    dict_obj->make_ref();
+    op_stack_.push(dict_obj);
+}
+
+// -------------------------- 序列解包 --------------------------
+// 弹出 Tuple / List，按原顺序压入其 n 个元素（a, b = t 随后按逆序 SET_LOCAL）
+void Vm::exec_UNPACK_SEQ(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec unpack_seq...");
+
+    if (instruction.opn_list.empty()) {
+        assert(false && "UNPACK_SEQ: 无元素个数参数");
+    }
+    const size_t elem_count = instruction.opn_list[0];
+
+    model::Object* seq = op_stack_.top();
+    op_stack_.pop();
+
+    if (const auto tuple_obj = dynamic_cast<model::Tuple*>(seq)) {
+        assert(tuple_obj->size() == elem_count && "UNPACK_SEQ: 元组元素个数与变量个数不符");
+        for (size_t i = 0; i < elem_count; ++i) {
+            tuple_obj->at(i)->make_ref();
+            op_stack_.push(tuple_obj->at(i));
+        }
+    } else if (const auto list_obj = dynamic_cast<model::List*>(seq)) {
+        assert(list_obj->size() == elem_count && "UNPACK_SEQ: 列表元素个数与变量个数不符");
+        for (size_t i = 0; i < elem_count; ++i) {
+            list_obj->at(i)->make_ref();
+            op_stack_.push(list_obj->at(i));
+        }
+    } else {
+        assert(false && "UNPACK_SEQ: 只能解包 Tuple 或 List");
+    }
+    seq->del_ref();
+}
+
+// -------------------------- 模块导入 --------------------------
+void Vm::exec_IMPORT(const Instruction& instruction) {
+    DEBUG_OUTPUT("exec import...");
+    if (call_stack_.empty() || instruction.opn_list.empty()) {
+        assert(false && "IMPORT: 无调用帧或无模块名索引");
+    }
+    CallFrame* curr_frame = call_stack_.back().get();
+    const size_t name_idx = instruction.opn_list[0];
+    if (name_idx >= curr_frame->names.size()) {
+        assert(false && "IMPORT: 模块名索引超出范围");
+    }
+    const std::string& module_name = curr_frame->names[name_idx];
+
+    // 已加载的模块直接复用；std模块首次导入时调用其 __init_module__ 构造并缓存
+    model::Module* module_obj = nullptr;
+    if (const auto loaded_it = loaded_modules.find(module_name)) {
+        module_obj = loaded_it->value;
+    } else if (const auto std_it = model::std_modules.find(module_name)) {
+        const auto init_fn = dynamic_cast<model::CppFunction*>(std_it->value);
+        assert(init_fn != nullptr && "IMPORT: std模块的初始化函数必须是CppFunction");
+        const auto args = new model::List({});
+        args->make_ref();
+        module_obj = dynamic_cast<model::Module*>(init_fn->func(nullptr, args));
+        args->del_ref();
+        assert(module_obj != nullptr && "IMPORT: std模块初始化函数必须返回Module");
+        module_obj->make_ref();  // loaded_modules 持有引用
+        loaded_modules.insert(module_name, module_obj);
+    } else {
+        assert(false && ("IMPORT: 未找到模块 '" + module_name + "'").c_str());
+    }
+
+    // 绑定到当前作用域的同名变量
+    if (const auto var_it = curr_frame->locals.find(module_name)) {
+        if (var_it->value != nullptr) var_it->value->del_ref();
+    }
+    module_obj->make_ref();
+    curr_frame->locals.insert(module_name, module_obj);
+    DEBUG_OUTPUT("import: 模块 '" + module_name + "' 已绑定到当前作用域");
+}
+
 // -------------------------- 跳转指令 --------------------------
 void Vm::exec_JUMP(const Instruction& instruction) {
     DEBUG_OUTPUT("exec jump...");
@@ -1,4 +1,15 @@
 #include "../include/models.hpp"
+#include "../../libs/array/kiz_array.hpp"
+#include "../../libs/matrix/kiz_matrix.hpp"
+#include "../../libs/io/kiz_io.hpp"
+#include "../../libs/sys/kiz_sys.hpp"
+#include "../../libs/json/kiz_json.hpp"
+#include "../../libs/csv/kiz_csv.hpp"
+#include "../../libs/re/kiz_re.hpp"
+#include "../../libs/parallel/kiz_parallel.hpp"
+#ifndef _WIN32
+#include "../../libs/aio/kiz_aio.hpp"
+#endif
 
 namespace model {
 
@@ -6,6 +17,35 @@ void registering_std_modules() {
     std_modules.insert("math", new CppFunction(
         math_lib::__init_module__
     ));
+    std_modules.insert("array", new CppFunction(
+        array_lib::__init_module__
+    ));
+    std_modules.insert("matrix", new CppFunction(
+        matrix_lib::__init_module__
+    ));
+    std_modules.insert("io", new CppFunction(
+        io_lib::__init_module__
+    ));
+    std_modules.insert("sys", new CppFunction(
+        sys_lib::__init_module__
+    ));
+    std_modules.insert("json", new CppFunction(
+        json_lib::__init_module__
+    ));
+    std_modules.insert("csv", new CppFunction(
+        csv_lib::__init_module__
+    ));
+    std_modules.insert("re", new CppFunction(
+        re_lib::__init_module__
+    ));
+    std_modules.insert("parallel", new CppFunction(
+        parallel_lib::__init_module__
+    ));
+#ifndef _WIN32
+    std_modules.insert("aio", new CppFunction(
+        aio_lib::__init_module__
+    ));
+#endif
 }
 
 } // namespace model
\ No newline at end of file
@@ -15,6 +15,10 @@
 #include <cassert>
 
 #include "kiz.hpp"
+#include "../../libs/builtins/builtin_functions/iterators.hpp"
+#include "../../libs/builtins/builtin_functions/sorting.hpp"
+#include "../../libs/builtins/builtin_functions/channels.hpp"
+#include "../../libs/builtins/builtin_functions/async.hpp"
 
 namespace kiz {
 
@@ -23,16 +27,47 @@ deps::HashMap<model::Module*> Vm::loaded_modules{};
 model::Module* Vm::main_module;
 std::stack<model::Object *> Vm::op_stack_{};
 std::vector<std::unique_ptr<CallFrame>> Vm::call_stack_{};
+std::vector<model::Object*> Vm::constant_pool_{};
 bool Vm::running_ = false;
 const std::string& Vm::file_path = "";
+std::deque<Coroutine*> Vm::ready_{};
+std::vector<Coroutine*> Vm::running_coroutines_{};
 
 Vm::Vm(const std::string& file_path) : file_path(file_path) {
     DEBUG_OUTPUT("registering builtin functions...");
 #define KIZ_FUNC(n) builtins.insert(#n, new model::CppFunction(builtin_objects::n))
+#define KIZ_PURE_FUNC(n) builtins.insert(#n, new model::CppFunction(builtin_objects::n, true))
     KIZ_FUNC(print);
+    KIZ_FUNC(flush);
     KIZ_FUNC(input);
     KIZ_FUNC(isinstance);
+    KIZ_FUNC(str_builder);
+    KIZ_PURE_FUNC(len);
+    KIZ_FUNC(set);
+    KIZ_PURE_FUNC(hash);
+    KIZ_FUNC(range);
+    KIZ_FUNC(map);
+    KIZ_FUNC(filter);
+    KIZ_FUNC(zip);
+    KIZ_FUNC(enumerate);
+    KIZ_FUNC(take);
+    KIZ_FUNC(sum);
+    KIZ_FUNC(reduce);
+    KIZ_FUNC(sorted);
+    KIZ_FUNC(bytearray);
+    KIZ_FUNC(channel);
+    KIZ_FUNC(send);
+    KIZ_FUNC(recv);
+    KIZ_FUNC(select);
+    KIZ_FUNC(run);
+    KIZ_FUNC(gather);
+    KIZ_FUNC(sleep);
+    KIZ_FUNC(timeout);
 #undef KIZ_FUNC
+#undef KIZ_PURE_FUNC
+
+    DEBUG_OUTPUT("registering std modules...");
+    model::registering_std_modules();
 
     DEBUG_OUTPUT("registering builtin objects...");
     builtins.insert("obj", model::based_obj);
@@ -45,6 +80,14 @@ Vm::Vm(const std::string& file_path) : file_path(file_path) {
     model::based_dict->attrs.insert("__parent__", model::based_obj);
     model::based_list->attrs.insert("__parent__", model::based_obj);
     model::based_str->attrs.insert("__parent__", model::based_obj);
+    model::based_str_builder->attrs.insert("__parent__", model::based_obj);
+    model::based_set->attrs.insert("__parent__", model::based_obj);
+    model::based_iterator->attrs.insert("__parent__", model::based_obj);
+    model::based_tuple->attrs.insert("__parent__", model::based_obj);
+    model::based_bytes->attrs.insert("__parent__", model::based_obj);
+    model::based_channel->attrs.insert("__parent__", model::based_iterator);
+    model::based_future->attrs.insert("__parent__", model::based_obj);
+    model::based_coroutine->attrs.insert("__parent__", model::based_future);
 
     DEBUG_OUTPUT("registering magic methods...");
     // Object 基类 __eq__
@@ -55,50 +98,133 @@ Vm::Vm(const std::string& file_path) : file_path(file_path) {
 
     // Bool 类型魔法方法
     based_bool->attrs.insert("__eq__", new CppFunction(bool_eq));
+    based_bool->attrs.insert("__hash__", new CppFunction(bool_hash));
 
     // Nil 类型魔法方法
     based_nil->attrs.insert("__eq__", new CppFunction(nil_eq));
-
-    // Int 类型魔法方法
-    based_int->attrs.insert("__add__", new CppFunction(int_add));
-    based_int->attrs.insert("__sub__", new CppFunction(int_sub));
-    based_int->attrs.insert("__mul__", new CppFunction(int_mul));
-    based_int->attrs.insert("__div__", new CppFunction(int_div));
-    based_int->attrs.insert("__mod__", new CppFunction(int_mod));
-    based_int->attrs.insert("__pow__", new CppFunction(int_pow));
-    based_int->attrs.insert("__gt__", new CppFunction(int_gt));
-    based_int->attrs.insert("__lt__", new CppFunction(int_lt));
-    based_int->attrs.insert("__eq__", new CppFunction(int_eq));
+    based_nil->attrs.insert("__hash__", new CppFunction(nil_hash));
+
+    // Int 类型魔法方法（数值运算标记为纯函数，parallel 可在工作线程中直接调用）
+    based_int->attrs.insert("__add__", new CppFunction(int_add, true));
+    based_int->attrs.insert("__sub__", new CppFunction(int_sub, true));
+    based_int->attrs.insert("__mul__", new CppFunction(int_mul, true));
+    based_int->attrs.insert("__div__", new CppFunction(int_div, true));
+    based_int->attrs.insert("__mod__", new CppFunction(int_mod, true));
+    based_int->attrs.insert("__pow__", new CppFunction(int_pow, true));
+    based_int->attrs.insert("__gt__", new CppFunction(int_gt, true));
+    based_int->attrs.insert("__lt__", new CppFunction(int_lt, true));
+    based_int->attrs.insert("__eq__", new CppFunction(int_eq, true));
+    based_int->attrs.insert("__hash__", new CppFunction(int_hash, true));
 
     // Rational 类型魔法方法
-    based_rational->attrs.insert("__add__", new CppFunction(rational_add));
-    based_rational->attrs.insert("__sub__", new CppFunction(rational_sub));
-    based_rational->attrs.insert("__mul__", new CppFunction(rational_mul));
-    based_rational->attrs.insert("__div__", new CppFunction(rational_div));
-    based_rational->attrs.insert("__gt__", new CppFunction(rational_gt));
-    based_rational->attrs.insert("__lt__", new CppFunction(rational_lt));
-    based_rational->attrs.insert("__eq__", new CppFunction(rational_eq));
+    based_rational->attrs.insert("__add__", new CppFunction(rational_add, true));
+    based_rational->attrs.insert("__sub__", new CppFunction(rational_sub, true));
+    based_rational->attrs.insert("__mul__", new CppFunction(rational_mul, true));
+    based_rational->attrs.insert("__div__", new CppFunction(rational_div, true));
+    based_rational->attrs.insert("__gt__", new CppFunction(rational_gt, true));
+    based_rational->attrs.insert("__lt__", new CppFunction(rational_lt, true));
+    based_rational->attrs.insert("__eq__", new CppFunction(rational_eq, true));
+    based_rational->attrs.insert("__hash__", new CppFunction(rational_hash, true));
 
     // Dictionary 类型魔法方法
     based_dict->attrs.insert("__add__", new CppFunction(dict_add));
     based_dict->attrs.insert("__contains__", new CppFunction(dict_contains));
+    based_dict->attrs.insert("__getitem__", new CppFunction(dict_getitem));
+    based_dict->attrs.insert("__setitem__", new CppFunction(dict_setitem));
 
-    // List 类型魔法方法
+    // List 类型魔法方法（list(iterable) 通过类型对象的 __call__ 构造）
+    based_list->attrs.insert("__call__", new CppFunction(builtin_objects::list_of));
     based_list->attrs.insert("__add__", new CppFunction(list_add));
     based_list->attrs.insert("__mul__", new CppFunction(list_mul));
     based_list->attrs.insert("__contains__", new CppFunction(list_contains));
     based_list->attrs.insert("__eq__", new CppFunction(list_eq));
+    based_list->attrs.insert("__getitem__", new CppFunction(list_getitem));
+    based_list->attrs.insert("__setitem__", new CppFunction(list_setitem));
+    based_list->attrs.insert("append", new CppFunction(list_append));
+    based_list->attrs.insert("reserve", new CppFunction(list_reserve));
+    based_list->attrs.insert("pop", new CppFunction(list_pop));
+    based_list->attrs.insert("extend", new CppFunction(list_extend));
+    based_list->attrs.insert("insert", new CppFunction(list_insert));
+    based_list->attrs.insert("clear", new CppFunction(list_clear));
+    based_list->attrs.insert("appended", new CppFunction(list_appended));
+    based_list->attrs.insert("updated", new CppFunction(list_updated));
+    based_list->attrs.insert("sort", new CppFunction(list_sort));
 
     // String 类型魔法方法
-    based_str->attrs.insert("__add__", new CppFunction(str_add));
+    based_str->attrs.insert("__add__", new CppFunction(str_add, true));
     based_str->attrs.insert("__mul__", new CppFunction(str_mul));
     based_str->attrs.insert("__contains__", new CppFunction(str_contains));
     based_str->attrs.insert("__eq__", new CppFunction(str_eq));
+    based_str->attrs.insert("__hash__", new CppFunction(str_hash));
+    based_str->attrs.insert("__getitem__", new CppFunction(str_getitem));
+    based_str->attrs.insert("byte_at", new CppFunction(str_byte_at));
+    based_str->attrs.insert("join", new CppFunction(str_join));
+    based_str->attrs.insert("find", new CppFunction(str_find));
+    based_str->attrs.insert("startswith", new CppFunction(str_startswith));
+    based_str->attrs.insert("endswith", new CppFunction(str_endswith));
+    based_str->attrs.insert("split", new CppFunction(str_split));
+    based_str->attrs.insert("replace", new CppFunction(str_replace));
+    based_str->attrs.insert("strip", new CppFunction(str_strip));
+    based_str->attrs.insert("lstrip", new CppFunction(str_lstrip));
+    based_str->attrs.insert("rstrip", new CppFunction(str_rstrip));
+
+    // StringBuilder 方法
+    based_str_builder->attrs.insert("append", new CppFunction(str_builder_append));
+    based_str_builder->attrs.insert("reserve", new CppFunction(str_builder_reserve));
+    based_str_builder->attrs.insert("len", new CppFunction(str_builder_len));
+    based_str_builder->attrs.insert("clear", new CppFunction(str_builder_clear));
+    based_str_builder->attrs.insert("build", new CppFunction(str_builder_build));
+
+    // Set 方法
+    based_set->attrs.insert("__contains__", new CppFunction(set_contains));
+    based_set->attrs.insert("add", new CppFunction(set_add));
+    based_set->attrs.insert("remove", new CppFunction(set_remove));
+    based_set->attrs.insert("discard", new CppFunction(set_discard));
+    based_set->attrs.insert("union", new CppFunction(set_union));
+    based_set->attrs.insert("intersection", new CppFunction(set_intersection));
+    based_set->attrs.insert("difference", new CppFunction(set_difference));
+    based_set->attrs.insert("to_list", new CppFunction(set_to_list));
+
+    // Tuple 方法
+    based_tuple->attrs.insert("__add__", new CppFunction(tuple_add));
+    based_tuple->attrs.insert("__eq__", new CppFunction(tuple_eq));
+    based_tuple->attrs.insert("__hash__", new CppFunction(tuple_hash));
+    based_tuple->attrs.insert("__contains__", new CppFunction(tuple_contains));
+    based_tuple->attrs.insert("__getitem__", new CppFunction(tuple_getitem));
+    based_tuple->attrs.insert("__call__", new CppFunction(builtin_objects::tuple_of));
+    based_tuple->attrs.insert("to_list", new CppFunction(tuple_to_list));
+
+    // Bytes 方法（bytes 与 bytearray 共用，写操作只对 bytearray 有效）
+    based_bytes->attrs.insert("__add__", new CppFunction(bytes_add));
+    based_bytes->attrs.insert("__eq__", new CppFunction(bytes_eq));
+    based_bytes->attrs.insert("__hash__", new CppFunction(bytes_hash));
+    based_bytes->attrs.insert("__contains__", new CppFunction(bytes_contains));
+    based_bytes->attrs.insert("__getitem__", new CppFunction(bytes_getitem));
+    based_bytes->attrs.insert("__setitem__", new CppFunction(bytes_setitem));
+    based_bytes->attrs.insert("__call__", new CppFunction(builtin_objects::bytes_of));
+    based_bytes->attrs.insert("find", new CppFunction(bytes_find));
+    based_bytes->attrs.insert("unpack_int", new CppFunction(bytes_unpack_int));
+    based_bytes->attrs.insert("pack_int", new CppFunction(bytes_pack_int));
+    based_bytes->attrs.insert("decode", new CppFunction(bytes_decode));
+    based_bytes->attrs.insert("hex", new CppFunction(bytes_hex));
+    based_bytes->attrs.insert("copy", new CppFunction(bytes_copy));
+    based_bytes->attrs.insert("to_list", new CppFunction(bytes_to_list));
+
+    // Channel 方法（也可用内置函数 send / recv）
+    based_channel->attrs.insert("__len__", new CppFunction(builtin_objects::channel_len));
+    based_channel->attrs.insert("send", new CppFunction(builtin_objects::channel_send));
+    based_channel->attrs.insert("recv", new CppFunction(builtin_objects::channel_recv));
+    based_channel->attrs.insert("close", new CppFunction(builtin_objects::channel_close));
+
+    // Future / 协程
+    based_future->attrs.insert("done", new CppFunction(builtin_objects::future_done));
 
     builtins.insert("int", model::based_int);
     builtins.insert("bool", model::based_bool);
     builtins.insert("rational", model::based_rational);
     builtins.insert("list", model::based_list);
+    builtins.insert("tuple", model::based_tuple);
+    builtins.insert("bytes", model::based_bytes);
     builtins.insert("dict", model::based_dict);
     builtins.insert("str", model::based_str);
     builtins.insert("function", model::based_function);
@@ -129,6 +255,7 @@ void Vm::load(model::Module* src_module) {
 
     // 将调用帧压入VM的调用栈
     this->call_stack_.emplace_back(std::move(module_call_frame));
+    constant_pool_ = module_consts;
 
     // 初始化VM执行状态：标记为"就绪"
     this->running_ = true; // 标记VM为运行状态（等待exec触发执行）
@@ -137,34 +264,7 @@ void Vm::load(model::Module* src_module) {
     assert(module_frame.code_object != nullptr && "Vm::load: 当前调用帧无关联CodeObject");
 
     // 循环执行当前调用帧下的所有指令
-    while (!call_stack_.empty() && running_) {
-        auto& curr_frame = *call_stack_.back();
-        // 检查当前帧是否执行完毕
-        if (curr_frame.pc >= curr_frame.code_object->code.size()) {
-            // 非模块帧则弹出，模块帧则退出循环
-            if (call_stack_.size() > 1) {
-                call_stack_.pop_back();
-            } else {
-                break;
-            }
-            continue;
-        }
-
-        // 执行当前指令
-        const Instruction& curr_inst = curr_frame.code_object->code[curr_frame.pc];
-        this->exec(curr_inst);
-        DEBUG_OUTPUT("curr inst is "+opcode_to_string(curr_inst.opc));
-
-        // 调试输出栈顶
-        DEBUG_OUTPUT("current stack top : " +
-            (op_stack_.empty() ? " " : op_stack_.top()->to_string())
-        );
-
-        // PC自增
-        if (!(curr_inst.opc == Opcode::JUMP || curr_inst.opc == Opcode::JUMP_IF_FALSE || curr_inst.opc == Opcode::RET)) {
-            curr_frame.pc++;
-        }
-    }
+    run_until_depth(0);
 
     DEBUG_OUTPUT("call stack length: " + std::to_string(this->call_stack_.size()));
 }
@@ -282,16 +382,28 @@ void Vm::exec(const Instruction& instruction) {
         case Opcode::OP_IS:           exec_IS(instruction);           break;
         case Opcode::OP_IN:           exec_IN(instruction);           break;
         case Opcode::MAKE_LIST:       exec_MAKE_LIST(instruction);    break;
+        case Opcode::MAKE_TUPLE:      exec_MAKE_TUPLE(instruction);   break;
+        case Opcode::MAKE_DICT:       exec_MAKE_DICT(instruction);    break;
+        case Opcode::UNPACK_SEQ:      exec_UNPACK_SEQ(instruction);   break;
 
         case Opcode::CALL:            exec_CALL(instruction);          break;
         case Opcode::RET:             exec_RET(instruction);           break;
+        case Opcode::RET_MULTI:       exec_RET_MULTI(instruction);     break;
+        case Opcode::AWAIT:           exec_AWAIT(instruction);         break;
         case Opcode::GET_ATTR:        exec_GET_ATTR(instruction);      break;
         case Opcode::SET_ATTR:        exec_SET_ATTR(instruction);      break;
+        case Opcode::CALL_METHOD:     exec_CALL_METHOD(instruction);   break;
+        case Opcode::GET_SLOT:        exec_GET_SLOT(instruction);      break;
+        case Opcode::SET_SLOT:        exec_SET_SLOT(instruction);      break;
+        case Opcode::GET_ITEM:        exec_GET_ITEM(instruction);      break;
+        case Opcode::SET_ITEM:        exec_SET_ITEM(instruction);      break;
+        case Opcode::GET_SLICE:       exec_GET_SLICE(instruction);     break;
         case Opcode::LOAD_VAR:        exec_LOAD_VAR(instruction);      break;
         case Opcode::LOAD_CONST:      exec_LOAD_CONST(instruction);    break;
         case Opcode::SET_GLOBAL:      exec_SET_GLOBAL(instruction);    break;
         case Opcode::SET_LOCAL:       exec_SET_LOCAL(instruction);     break;
         case Opcode::SET_NONLOCAL:    exec_SET_NONLOCAL(instruction);  break;
+        case Opcode::IMPORT:          exec_IMPORT(instruction);        break;
         case Opcode::JUMP:            exec_JUMP(instruction);          break;
         case Opcode::JUMP_IF_FALSE:   exec_JUMP_IF_FALSE(instruction); break;
         case Opcode::THROW:           exec_THROW(instruction);         break;
@@ -0,0 +1,24 @@
+// deps::HashMap 扩容回归：插入超过初始容量 * 负载因子的键后，所有键仍能找到
+#include <cassert>
+#include <string>
+
+#include "../deps/hashmap.hpp"
+
+int main() {
+    deps::HashMap<int> map;
+    constexpr int count = 1000;
+    for (int i = 0; i < count; ++i) {
+        map.insert("key" + std::to_string(i), i);
+    }
+    assert(map.size() == count);
+    for (int i = 0; i < count; ++i) {
+        const auto node = map.find("key" + std::to_string(i));
+        assert(node && node->value == i);
+    }
+    assert(!map.find("missing"));
+
+    // 覆盖已有键不增加元素
+    map.insert("key7", -7);
+    assert(map.size() == count && map.find("key7")->value == -7);
+    return 0;
+}
@@ -25,6 +25,11 @@ add_target("kiz")
     -- 设置头文件路径作用域为PRIVATE（仅当前目标使用，不暴露给依赖）
     set_includedirs_policy("private")
 
+    -- 标准库模块（matrix 等）使用 std::thread
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
     -- 按平台设置可执行文件后缀（Windows→.exe，其他→.elf，与原CMake逻辑一致）
     if is_plat("windows") then
         set_suffix(".exe")
@@ -46,4 +51,11 @@ add_target("kiz")
         -- 打印最终目标文件路径（target:targetfile()获取完整路径）
         print("目标文件：" .. target:targetfile())
         print("======================================")
-    end)
\ No newline at end of file
+    end)
+-- 基准测试驱动（POSIX）：xmake run kiz_bench <kiz可执行文件> [-n 次数] [-o bench.json]
+if not is_plat("windows") then
+    add_target("kiz_bench")
+        set_kind("binary")
+        add_files("benchmarks/kiz_bench.cpp")
+        add_defines("KIZ_BENCH_DIR=\"" .. path.join(os.projectdir(), "benchmarks") .. "\"")
+end